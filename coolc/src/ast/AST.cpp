@@ -3,7 +3,7 @@
 namespace ast
 {
 #ifdef DEBUG
-void dump_expression(const int &offset, const std::shared_ptr<Expression> &expr);
+void dump_expression(const int &offset, Expression *expr);
 
 void dump_line_and_name(const int &offset, const int &line_number, const std::string &name)
 {
@@ -11,12 +11,12 @@ void dump_line_and_name(const int &offset, const int &line_number, const std::st
     std::cout << field << "#" << line_number << std::endl << field << name << std::endl;
 }
 
-void dump_type(const int &offset, const std::shared_ptr<Type> &type)
+void dump_type(const int &offset, Type *type)
 {
     std::cout << std::string(offset, ' ') << type->_string << std::endl;
 }
 
-void dump_object(const int &offset, const std::shared_ptr<ast::ObjectExpression> &object)
+void dump_object(const int &offset, ast::ObjectExpression *object)
 {
     std::cout << std::string(offset, ' ') << object->_object << std::endl;
 }
@@ -105,7 +105,7 @@ void dump_unary_expr(const UnaryExpression &expr, const int &line, const int &of
     dump_expression(offset + 2, expr._expr);
 }
 
-void dump_case(const int &offset, const std::shared_ptr<Case> &branch)
+void dump_case(const int &offset, Case *branch)
 {
     dump_line_and_name(offset, branch->_line_number, "_branch");
 
@@ -220,7 +220,7 @@ void dump_assign_expression(const AssignExpression &assign, const int &line, con
     dump_expression(offset + 2, assign._expr);
 }
 
-void dump_expression(const int &offset, const std::shared_ptr<Expression> &expr)
+void dump_expression(const int &offset, Expression *expr)
 {
     if (expr == nullptr)
     {
@@ -248,10 +248,11 @@ void dump_expression(const int &offset, const std::shared_ptr<Expression> &expr)
             [&](const AssignExpression &assign) { dump_assign_expression(assign, expr->_line_number, offset); }},
         expr->_data);
 
-    std::cout << std::string(offset, ' ') << ": " << (expr->_type ? expr->_type->_string : "_no_type") << std::endl;
+    std::cout << std::string(offset, ' ') << ": " << (expr->_type ? expr->_type->_string.str() : "_no_type")
+              << std::endl;
 }
 
-void dump_formal(const int &offset, const std::shared_ptr<Formal> &formal)
+void dump_formal(const int &offset, Formal *formal)
 {
     dump_line_and_name(offset, formal->_line_number, "_formal");
 
@@ -259,7 +260,7 @@ void dump_formal(const int &offset, const std::shared_ptr<Formal> &formal)
     dump_type(offset + 2, formal->_type);
 }
 
-void dump_feature(const int &offset, const std::shared_ptr<Feature> &feature)
+void dump_feature(const int &offset, Feature *feature)
 {
     std::string field(offset, ' ');
     std::cout << field << "#" << feature->_line_number << std::endl;
@@ -281,7 +282,7 @@ void dump_feature(const int &offset, const std::shared_ptr<Feature> &feature)
     dump_expression(offset + 2, feature->_expr);
 }
 
-void dump_class(const int &offset, const std::shared_ptr<Class> &klass)
+void dump_class(const int &offset, Class *klass)
 {
     dump_line_and_name(offset, klass->_line_number, "_class");
 
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "utils/Utils.h"
+#include "utils/arena/Arena.h"
+#include "utils/symbol/Symbol.h"
 #include <memory>
+#include <span>
 #include <string>
 #include <variant>
 #include <vector>
@@ -26,67 +29,87 @@ struct ObjectExpression;
 
 struct Program
 {
-    std::vector<std::shared_ptr<Class>> _classes;
+    std::vector<Class *> _classes;
+    std::vector<std::shared_ptr<Arena>> _arenas; // own all nodes of this program
 
     int _line_number;
 };
 
 struct Class
 {
-    std::shared_ptr<Type> _type;
-    std::shared_ptr<Type> _parent;
-    std::vector<std::shared_ptr<Feature>> _features;
+    Type *_type = nullptr;
+    Type *_parent = nullptr;
+    std::vector<Feature *> _features;
 
     std::string _file_name;
     int _line_number;
 };
 
+// method body that parser skipped in the lazy mode. Semant parses it when it checks the method, or earlier to report
+// syntax errors before semantic ones, see parser::LazyMethodBody
+struct LazyBody
+{
+    virtual ~LazyBody() = default;
+
+    /**
+     * @brief Parse the body
+     *
+     * @param arena Arena for the body nodes
+     * @param error Syntax error message if body is malformed
+     * @return Body or nullptr for syntax error. Body with the error can be parsed again
+     */
+    virtual Expression *parse(const std::shared_ptr<Arena> &arena, std::string &error) = 0;
+};
+
 struct AttrFeature
 {
 };
 
 struct MethodFeature
 {
-    std::vector<std::shared_ptr<Formal>> _formals;
+    std::vector<Formal *> _formals;
 };
 
 struct Feature
 {
     std::variant<AttrFeature, MethodFeature> _base;
 
-    std::shared_ptr<ObjectExpression> _object;
-    std::shared_ptr<Type> _type;
-    std::shared_ptr<Expression> _expr;
+    ObjectExpression *_object = nullptr;
+    Type *_type = nullptr;
+    Expression *_expr = nullptr;
+    LazyBody *_lazy_body = nullptr; // body that is not parsed yet, _expr is nullptr until it is parsed
 
     int _line_number;
 };
 
 struct Formal
 {
-    std::shared_ptr<ObjectExpression> _object;
-    std::shared_ptr<Type> _type;
+    ObjectExpression *_object = nullptr;
+    Type *_type = nullptr;
 
     int _line_number;
 };
 
 struct Case
 {
-    std::shared_ptr<ObjectExpression> _object;
-    std::shared_ptr<Type> _type;
-    std::shared_ptr<Expression> _expr;
+    ObjectExpression *_object = nullptr;
+    Type *_type = nullptr;
+    Expression *_expr = nullptr;
 
     int _line_number;
 };
 
 struct AssignExpression
 {
-    std::shared_ptr<ObjectExpression> _object;
-    std::shared_ptr<Expression> _expr;
+    ObjectExpression *_object = nullptr;
+    Expression *_expr = nullptr;
+
+    bool _discarded = false; // result of the assignment is never used, see passes::Unboxing
 };
 
 struct StaticDispatchExpression
 {
-    std::shared_ptr<Type> _type;
+    Type *_type = nullptr;
 };
 
 struct VirtualDispatchExpression
@@ -97,47 +120,52 @@ struct DispatchExpression
 {
     std::variant<VirtualDispatchExpression, StaticDispatchExpression> _base;
 
-    std::shared_ptr<Expression> _expr;
-    std::shared_ptr<ObjectExpression> _object;
-    std::vector<std::shared_ptr<Expression>> _args;
+    Expression *_expr = nullptr;
+    ObjectExpression *_object = nullptr;
+    std::span<Expression *> _args;
+
+    Type *_direct = nullptr; // class whose method virtual dispatch always calls, see codegen::ClassAnalysis
+    Type *_likely = nullptr; // class whose method is called directly if receiver is in its subtree, see ClassAnalysis
 };
 
 struct IfExpression
 {
-    std::shared_ptr<Expression> _predicate;
-    std::shared_ptr<Expression> _true_path_expr;
-    std::shared_ptr<Expression> _false_path_expr;
+    Expression *_predicate = nullptr;
+    Expression *_true_path_expr = nullptr;
+    Expression *_false_path_expr = nullptr;
 };
 
 struct WhileExpression
 {
-    std::shared_ptr<Expression> _predicate;
-    std::shared_ptr<Expression> _body_expr;
+    Expression *_predicate = nullptr;
+    Expression *_body_expr = nullptr;
 };
 
 struct ListExpression
 {
-    std::vector<std::shared_ptr<Expression>> _exprs;
+    std::span<Expression *> _exprs;
 };
 
 struct LetExpression
 {
-    std::shared_ptr<ObjectExpression> _object;
-    std::shared_ptr<Type> _type;
-    std::shared_ptr<Expression> _expr;
+    ObjectExpression *_object = nullptr;
+    Type *_type = nullptr;
+    Expression *_expr = nullptr;
+
+    Expression *_body_expr = nullptr;
 
-    std::shared_ptr<Expression> _body_expr;
+    bool _unboxed = false; // Int or Bool variable that does not escape can hold the native value, see passes::Unboxing
 };
 
 struct CaseExpression
 {
-    std::shared_ptr<Expression> _expr;
-    std::vector<std::shared_ptr<Case>> _cases;
+    Expression *_expr = nullptr;
+    std::span<Case *> _cases;
 };
 
 struct NewExpression
 {
-    std::shared_ptr<Type> _type;
+    Type *_type = nullptr;
 };
 
 // unary expressions
@@ -156,7 +184,7 @@ struct NegExpression
 struct UnaryExpression
 {
     std::variant<NegExpression, IsVoidExpression, NotExpression> _base;
-    std::shared_ptr<Expression> _expr;
+    Expression *_expr = nullptr;
 };
 
 // binary expressions
@@ -194,14 +222,14 @@ struct BinaryExpression
                  MulExpression>
         _base;
 
-    std::shared_ptr<Expression> _lhs;
-    std::shared_ptr<Expression> _rhs;
+    Expression *_lhs = nullptr;
+    Expression *_rhs = nullptr;
 };
 
 // Atoms
 struct ObjectExpression
 {
-    std::string _object;
+    Symbol _object;
 };
 
 struct IntExpression
@@ -211,7 +239,7 @@ struct IntExpression
 
 struct StringExpression
 {
-    std::string _string;
+    Symbol _string;
 };
 
 struct BoolExpression
@@ -221,9 +249,11 @@ struct BoolExpression
 
 struct Type
 {
-    std::string _string;
+    Symbol _string;
 };
 
+// Nodes are allocated in the arena of the program and linked by pointers. Lists of children are spans into arrays of
+// the same arena, so the node is trivially destructible. Traversals recurse through the pointers
 struct Expression
 {
     std::variant<AssignExpression, DispatchExpression, BinaryExpression, UnaryExpression, IfExpression, WhileExpression,
@@ -233,7 +263,7 @@ struct Expression
 
     int _line_number;
 
-    std::shared_ptr<Type> _type;
+    Type *_type = nullptr;
 };
 
 template <class... Ts> struct overloaded : Ts...
@@ -0,0 +1,312 @@
+#include "ClassAnalysis.h"
+#include <algorithm>
+
+using namespace codegen;
+
+ClassAnalysis::ClassAnalysis(const std::shared_ptr<semant::ClassNode> &root)
+{
+    CODEGEN_VERBOSE_ONLY(LOG_ENTER("CLASS ANALYSIS."));
+
+    // inheritance chains can be deep, so walk the tree iteratively
+    std::vector<semant::ClassNode *> stack = {root.get()};
+    while (!stack.empty())
+    {
+        auto *const klass = stack.back();
+        stack.pop_back();
+
+        _classes.insert({klass->_class->_type->_string, klass});
+        for (const auto *feature : klass->_class->_features)
+        {
+            if (std::holds_alternative<ast::MethodFeature>(feature->_base))
+            {
+                _owners.insert({feature, klass});
+            }
+        }
+
+        for (const auto &child : klass->_children)
+        {
+            stack.push_back(child.get());
+        }
+    }
+
+    // objects that runtime creates
+    for (const auto &name : {std::string(MainClassName), std::string(BaseClassesNames[BaseClasses::INT]),
+                             std::string(BaseClassesNames[BaseClasses::BOOL]),
+                             std::string(BaseClassesNames[BaseClasses::STRING])})
+    {
+        auto *const klass = _classes.at(Symbol(name));
+        _allocations[klass]++;
+        instantiate(klass);
+    }
+    reach(_classes.at(Symbol(MainClassName))->_methods.at(Symbol(MainMethodName)));
+
+    bool changed = true;
+    while (changed)
+    {
+        while (!_worklist.empty())
+        {
+            const auto [expr, klass] = _worklist.back();
+            _worklist.pop_back();
+            visit(expr, klass);
+        }
+
+        // dispatch without implementations calls the implementation of the static class, see annotate
+        changed = false;
+        for (const auto &site : _sites)
+        {
+            const auto &method = site._dispatch->_object->_object;
+            if (targets(site._klass, method).empty() && !is_reachable(site._klass->_methods.at(method)))
+            {
+                reach(site._klass->_methods.at(method));
+                changed = true;
+            }
+        }
+    }
+
+    annotate();
+
+    CODEGEN_VERBOSE_ONLY(LOG("Instantiated " + std::to_string(_instances.size()) + " classes, reached " +
+                             std::to_string(_reachable.size()) + " methods, " + std::to_string(_dispatched.size()) +
+                             " methods are dispatched through tables"));
+    CODEGEN_VERBOSE_ONLY(LOG_EXIT("CLASS ANALYSIS."));
+}
+
+semant::ClassNode *ClassAnalysis::parent(const semant::ClassNode *klass) const
+{
+    const auto parent = _classes.find(klass->_class->_parent->_string);
+    return parent != _classes.end() ? parent->second : nullptr;
+}
+
+void ClassAnalysis::instantiate(semant::ClassNode *klass)
+{
+    if (!_instantiated.insert(klass).second)
+    {
+        return;
+    }
+    _instances.push_back(klass);
+
+    for (const auto *ancestor = klass; ancestor; ancestor = parent(ancestor))
+    {
+        // init method of the class calls init methods of ancestors
+        if (_live.insert(ancestor).second)
+        {
+            for (auto *const feature : ancestor->_class->_features)
+            {
+                if (std::holds_alternative<ast::AttrFeature>(feature->_base) && feature->_expr)
+                {
+                    _worklist.emplace_back(feature->_expr, ancestor);
+                }
+            }
+        }
+
+        // dispatches that were resolved before can reach the new class now
+        const auto calls = _calls.find(ancestor);
+        if (calls != _calls.end())
+        {
+            for (const auto &method : calls->second)
+            {
+                reach(klass->_methods.at(method));
+            }
+        }
+    }
+}
+
+void ClassAnalysis::reach(const ast::Feature *method)
+{
+    if (!_reachable.insert(method).second)
+    {
+        return;
+    }
+
+    // methods of basic classes are implemented by runtime
+    const auto *const owner = _owners.at(method);
+    if (!semant::Semant::is_basic_type(owner->_class->_type))
+    {
+        _worklist.emplace_back(method->_expr, owner);
+    }
+}
+
+void ClassAnalysis::dispatch(semant::ClassNode *klass, const Symbol &method)
+{
+    if (!_calls[klass].insert(method).second)
+    {
+        return;
+    }
+
+    for (const auto *instance : _instances)
+    {
+        if (semant::ClassHierarchy::conforms(*instance, *klass))
+        {
+            reach(instance->_methods.at(method));
+        }
+    }
+}
+
+void ClassAnalysis::visit(ast::Expression *expr, const semant::ClassNode *klass)
+{
+    std::visit(
+        ast::overloaded{
+            [&](const ast::AssignExpression &assign) { visit(assign._expr, klass); },
+            [&](ast::DispatchExpression &dispatch) {
+                const auto &method = dispatch._object->_object;
+                if (const auto *base = std::get_if<ast::StaticDispatchExpression>(&dispatch._base))
+                {
+                    reach(_classes.at(base->_type->_string)->_methods.at(method));
+                }
+                else
+                {
+                    const auto *const type = semant::Semant::exact_type(dispatch._expr->_type, klass->_class->_type);
+                    auto *const receiver = _classes.at(type->_string);
+                    _sites.push_back({&dispatch, receiver});
+                    this->dispatch(receiver, method);
+                }
+
+                visit(dispatch._expr, klass);
+                for (auto *const arg : dispatch._args)
+                {
+                    visit(arg, klass);
+                }
+            },
+            [&](const ast::BinaryExpression &binary) {
+                visit(binary._lhs, klass);
+                visit(binary._rhs, klass);
+            },
+            [&](const ast::UnaryExpression &unary) { visit(unary._expr, klass); },
+            [&](const ast::IfExpression &branch) {
+                visit(branch._predicate, klass);
+                visit(branch._true_path_expr, klass);
+                visit(branch._false_path_expr, klass);
+            },
+            [&](const ast::WhileExpression &loop) {
+                visit(loop._predicate, klass);
+                visit(loop._body_expr, klass);
+            },
+            [&](const ast::ListExpression &list) {
+                for (auto *const e : list._exprs)
+                {
+                    visit(e, klass);
+                }
+            },
+            [&](const ast::LetExpression &let) {
+                if (let._expr)
+                {
+                    visit(let._expr, klass);
+                }
+                visit(let._body_expr, klass);
+            },
+            [&](const ast::CaseExpression &kase) {
+                visit(kase._expr, klass);
+                for (const auto *branch : kase._cases)
+                {
+                    visit(branch->_expr, klass);
+                }
+            },
+            [&](const ast::NewExpression &alloc) {
+                // new SELF_TYPE creates the object of the class of self, it is instantiated already
+                if (!semant::Semant::is_self_type(alloc._type))
+                {
+                    auto *const instance = _classes.at(alloc._type->_string);
+                    _allocations[instance]++;
+                    instantiate(instance);
+                }
+            },
+            [&](const ast::ObjectExpression &) {}, [&](const ast::IntExpression &) {},
+            [&](const ast::StringExpression &) {}, [&](const ast::BoolExpression &) {}},
+        expr->_data);
+}
+
+std::unordered_set<const ast::Feature *> ClassAnalysis::targets(const semant::ClassNode *klass,
+                                                                const Symbol &method) const
+{
+    std::unordered_set<const ast::Feature *> targets;
+    for (const auto *instance : _instances)
+    {
+        if (semant::ClassHierarchy::conforms(*instance, *klass))
+        {
+            targets.insert(instance->_methods.at(method));
+        }
+    }
+    return targets;
+}
+
+const semant::ClassNode *ClassAnalysis::likely_receiver(const semant::ClassNode *klass, const Symbol &method) const
+{
+    // instances of every subtree are the contiguous run of instances sorted by preorder numbers
+    std::vector<const semant::ClassNode *> instances;
+    std::unordered_set<const semant::ClassNode *> candidates;
+    for (const auto *instance : _instances)
+    {
+        if (semant::ClassHierarchy::conforms(*instance, *klass))
+        {
+            instances.push_back(instance);
+
+            // only subtrees with instances are worth checking
+            for (const auto *ancestor = instance; ancestor != klass; ancestor = parent(ancestor))
+            {
+                candidates.insert(ancestor);
+            }
+        }
+    }
+    const auto preorder = [](const semant::ClassNode *lhs, const semant::ClassNode *rhs) {
+        return lhs->_index < rhs->_index;
+    };
+    std::sort(instances.begin(), instances.end(), preorder);
+
+    const semant::ClassNode *likely = nullptr;
+    auto likely_allocations = 0;
+    for (const auto *candidate : candidates)
+    {
+        const auto *const implementation = candidate->_methods.at(method);
+        auto instance = std::lower_bound(instances.begin(), instances.end(), candidate, preorder);
+
+        auto allocations = 0;
+        for (; instance != instances.end() && (*instance)->_index <= candidate->_last_descendant; instance++)
+        {
+            if ((*instance)->_methods.at(method) != implementation)
+            {
+                break;
+            }
+            allocations += _allocations.at(*instance);
+        }
+
+        // the widest subtree wins among subtrees with the same allocations
+        const auto complete = instance == instances.end() || (*instance)->_index > candidate->_last_descendant;
+        if (complete && (allocations > likely_allocations ||
+                         (allocations == likely_allocations && likely && candidate->_index < likely->_index)))
+        {
+            likely = candidate;
+            likely_allocations = allocations;
+        }
+    }
+
+    GUARANTEE_DEBUG(likely);
+    return likely;
+}
+
+void ClassAnalysis::annotate()
+{
+    // sites with the same static class and method share the guess
+    std::unordered_map<const semant::ClassNode *, std::unordered_map<Symbol, const semant::ClassNode *>> guesses;
+
+    for (const auto &site : _sites)
+    {
+        const auto &method = site._dispatch->_object->_object;
+        const auto targets = this->targets(site._klass, method);
+
+        if (targets.size() > 1)
+        {
+            _dispatched.insert(method);
+
+            auto &likely = guesses[site._klass][method];
+            if (!likely)
+            {
+                likely = likely_receiver(site._klass, method);
+            }
+            site._dispatch->_likely = likely->_class->_type;
+            continue;
+        }
+
+        const auto *const target = targets.empty() ? site._klass->_methods.at(method) : *targets.begin();
+        site._dispatch->_direct = _owners.at(target)->_class->_type;
+    }
+}
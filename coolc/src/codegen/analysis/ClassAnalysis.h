@@ -0,0 +1,116 @@
+#pragma once
+
+#include "semant/Semant.h"
+#include <unordered_map>
+#include <unordered_set>
+
+namespace codegen
+{
+
+/**
+ * @brief Whole-program class hierarchy and rapid type analysis
+ *
+ * @details
+ * Class is instantiated if the program creates its objects with new, runtime creates Main, Int, Bool and String. Class
+ * is live if it or its descendant is instantiated. Analysis starts from Main.main and visits bodies of reachable
+ * methods and initializers of attributes of live classes. Virtual dispatch on the receiver of the static class S
+ * reaches implementations of the method in instantiated subclasses of S, so it is resolved again when the new subclass
+ * of S is instantiated.
+ *
+ * Virtual dispatch with one possible implementation is annotated with the class of this implementation, see
+ * ast::DispatchExpression::_direct, and backends emit it as the direct call. Receiver of the dispatch without possible
+ * implementations is always void, so the dispatch is annotated with the implementation of S: the call is never
+ * executed, but the void check is emitted as usual. Dispatch tables keep only slots of methods that are called through
+ * them, unreachable methods are not emitted and classes that are not live have neither prototypes nor dispatch tables.
+ * Tags are not changed, case expressions and runtime tables use them.
+ *
+ * Dispatch with several possible implementations is guarded by the guess of the receiver class, see
+ * ast::DispatchExpression::_likely: backends check that the tag of the receiver is in the tag range of the subtree of
+ * the guessed class and call its implementation directly, otherwise they load the method from the dispatch table.
+ * There is no profile, so the guess is the subtree with the most allocation sites among subtrees whose instantiated
+ * classes have the same implementation.
+ */
+class ClassAnalysis
+{
+  private:
+    // virtual dispatch and the static class of its receiver
+    struct Site
+    {
+        ast::DispatchExpression *_dispatch;
+        semant::ClassNode *_klass;
+    };
+
+    std::unordered_map<Symbol, semant::ClassNode *> _classes;                   // classes by name
+    std::unordered_map<const ast::Feature *, const semant::ClassNode *> _owners; // class that defines the method
+
+    std::vector<semant::ClassNode *> _instances; // instantiated classes in the order of instantiation
+    std::unordered_map<const semant::ClassNode *, int> _allocations; // number of allocation sites of the class
+    std::unordered_set<const semant::ClassNode *> _instantiated;
+    std::unordered_set<const semant::ClassNode *> _live;
+    std::unordered_set<const ast::Feature *> _reachable;
+
+    std::unordered_map<const semant::ClassNode *, std::unordered_set<Symbol>> _calls; // methods dispatched on the class
+    std::vector<Site> _sites;
+    std::unordered_set<Symbol> _dispatched; // methods that are called through dispatch tables
+
+    // expression and the class whose code it is
+    std::vector<std::pair<ast::Expression *, const semant::ClassNode *>> _worklist;
+
+    semant::ClassNode *parent(const semant::ClassNode *klass) const;
+
+    void instantiate(semant::ClassNode *klass);
+    void reach(const ast::Feature *method);
+    void dispatch(semant::ClassNode *klass, const Symbol &method);
+    void visit(ast::Expression *expr, const semant::ClassNode *klass);
+
+    // implementations of the method in instantiated subclasses of the class
+    std::unordered_set<const ast::Feature *> targets(const semant::ClassNode *klass, const Symbol &method) const;
+
+    // the class with the most likely implementation of the polymorphic dispatch
+    const semant::ClassNode *likely_receiver(const semant::ClassNode *klass, const Symbol &method) const;
+
+    void annotate();
+
+  public:
+    /**
+     * @brief Analyze the program and annotate dispatch expressions
+     *
+     * @param root Root of the checked class hierarchy
+     */
+    explicit ClassAnalysis(const std::shared_ptr<semant::ClassNode> &root);
+
+    /**
+     * @brief Check if class or its descendant is instantiated
+     *
+     * @param klass Class name
+     * @return True if code and data of the class are emitted
+     */
+    inline bool is_live(const Symbol &klass) const
+    {
+        return _live.contains(_classes.at(klass));
+    }
+
+    /**
+     * @brief Check if method can be called
+     *
+     * @param method Method
+     * @return True if method is emitted
+     */
+    inline bool is_reachable(const ast::Feature *method) const
+    {
+        return _reachable.contains(method);
+    }
+
+    /**
+     * @brief Check if method is called through dispatch tables
+     *
+     * @param method Method name
+     * @return True if dispatch tables have slots for methods with this name
+     */
+    inline bool is_dispatched(const Symbol &method) const
+    {
+        return _dispatched.contains(method);
+    }
+};
+
+}; // namespace codegen
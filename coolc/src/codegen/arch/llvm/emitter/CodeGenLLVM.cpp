@@ -28,13 +28,14 @@ void CodeGenLLVM::add_fields()
     const auto &this_klass = _builder->klass(_current_class->_type->_string);
     for (auto field = this_klass->fields_begin(); field != this_klass->fields_end(); field++)
     {
+        const auto index = this_klass->field_offset(field - this_klass->fields_begin());
         _table.add_symbol((*field)->_object->_object,
-                          Symbol(this_klass->field_offset(field - this_klass->fields_begin()),
-                                 semant::Semant::exact_type((*field)->_type, _current_class->_type)));
+                          Symbol(index, semant::Semant::exact_type((*field)->_type, _current_class->_type),
+                                 std::static_pointer_cast<KlassLLVM>(this_klass)->is_inline_field(index)));
     }
 }
 
-void CodeGenLLVM::emit_class_method_inner(const std::shared_ptr<ast::Feature> &method)
+void CodeGenLLVM::emit_class_method_inner(ast::Feature *method)
 {
     // it is dummies for basic classes. There are external symbols
     if (semant::Semant::is_basic_type(_current_class->_type))
@@ -61,7 +62,7 @@ void CodeGenLLVM::emit_class_method_inner(const std::shared_ptr<ast::Feature> &m
 
         const auto &local = __ CreateAlloca(arg->getType(), nullptr, arg->getName());
         __ CreateStore(arg, local);
-        _table.add_symbol(static_cast<std::string>(arg->getName()),
+        _table.add_symbol(i != 0 ? formals[i - 1]->_object->_object : ::Symbol(SelfObject),
                           Symbol(local, i != 0 ? formals[i - 1]->_type : _current_class->_type));
     }
 
@@ -92,7 +93,7 @@ void CodeGenLLVM::emit_class_init_method_inner()
     auto *const self_formal = func->getArg(0);
     const auto &local = __ CreateAlloca(self_formal->getType(), nullptr, self_formal->getName());
     __ CreateStore(self_formal, local);
-    _table.add_symbol(SelfObject, Symbol(local, _current_class->_type));
+    _table.add_symbol(::Symbol(SelfObject), Symbol(local, _current_class->_type));
 
     // set default value before init for fields of this class
     for (const auto &feature : _current_class->_features)
@@ -102,12 +103,16 @@ void CodeGenLLVM::emit_class_init_method_inner()
             llvm::Value *initial_val = nullptr;
 
             const auto &this_field = _table.symbol(feature->_object->_object);
-            GUARANTEE_DEBUG(this_field._type == Symbol::FIELD); // impossible
+            GUARANTEE_DEBUG(this_field._type == Symbol::FIELD || this_field._type == Symbol::INLINE_FIELD);
 
             auto *const field_ptr =
                 __ CreateStructGEP(_data.class_struct(klass), func->getArg(0), this_field._value._offset);
 
-            if (semant::Semant::is_trivial_type(this_field._value_type))
+            if (this_field._type == Symbol::INLINE_FIELD)
+            {
+                initial_val = native_default(this_field._value_type);
+            }
+            else if (semant::Semant::is_trivial_type(this_field._value_type))
             {
                 initial_val = _data.init_value(this_field._value_type);
             }
@@ -155,12 +160,14 @@ void CodeGenLLVM::emit_class_init_method_inner()
             if (feature->_expr)
             {
                 const auto &this_field = _table.symbol(feature->_object->_object);
-                GUARANTEE_DEBUG(this_field._type == Symbol::FIELD); // impossible
+                GUARANTEE_DEBUG(this_field._type == Symbol::FIELD || this_field._type == Symbol::INLINE_FIELD);
 
                 auto *const field_ptr =
                     __ CreateStructGEP(_data.class_struct(klass), func->getArg(0), this_field._value._offset);
 
-                __ CreateStore(emit_expr(feature->_expr), field_ptr);
+                __ CreateStore(this_field._type == Symbol::INLINE_FIELD ? emit_native(feature->_expr)
+                                                                        : emit_expr(feature->_expr),
+                               field_ptr);
             }
         }
     }
@@ -214,147 +221,224 @@ llvm::Value *CodeGenLLVM::emit_ternary_operator(llvm::Value *pred, llvm::Value *
     return result;
 }
 
-llvm::Value *CodeGenLLVM::emit_binary_expr_inner(const ast::BinaryExpression &expr,
-                                                 const std::shared_ptr<ast::Type> &expr_type)
+llvm::Value *CodeGenLLVM::emit_binary_expr_inner(const ast::BinaryExpression &expr, ast::Type *expr_type)
 {
+    // Int and Bool operands are compared by values
+    if (!std::holds_alternative<ast::EqExpression>(expr._base) || semant::Semant::is_int(expr._lhs->_type) ||
+        semant::Semant::is_bool(expr._lhs->_type))
+    {
+        return emit_box(emit_native_binary(expr), expr_type);
+    }
+
     auto *const lhs = emit_expr(expr._lhs);
     auto *const rhs = emit_expr(expr._rhs);
 
-    auto logical_result = false;
-    llvm::Value *op_result = nullptr;
+    // cast to void pointers for compare
+    auto *const raw_lhs = __ CreateBitCast(lhs, _runtime.void_type()->getPointerTo());
+    auto *const raw_rhs = __ CreateBitCast(rhs, _runtime.void_type()->getPointerTo());
 
-    if (!std::holds_alternative<ast::EqExpression>(expr._base))
-    {
-        auto *const lv = emit_load_int(lhs); // load real values
-        auto *const rv = emit_load_int(rhs);
-
-        op_result = std::visit(
-            ast::overloaded{
-                [&](const ast::MinusExpression &minus) {
-                    return __ CreateSub(lv, rv, Names::comment(Names::Comment::SUB));
-                },
-                [&](const ast::PlusExpression &plus) {
-                    return __ CreateAdd(lv, rv, Names::comment(Names::Comment::ADD));
-                },
-                [&](const ast::DivExpression &div) {
-                    return __ CreateSDiv(lv, rv, Names::comment(Names::Comment::DIV)); /* TODO: SDiv? */
-                },
-                [&](const ast::MulExpression &mul) {
-                    return __ CreateMul(lv, rv, Names::comment(Names::Comment::MUL));
-                },
-                [&](const ast::LTExpression &lt) {
-                    logical_result = true;
-                    return emit_ternary_operator(__ CreateICmpSLT(lv, rv, Names::comment(Names::Comment::CMP_SLT)),
-                                                 _true_obj, _false_obj, _true_obj->getType());
-                },
-                [&](const ast::LEExpression &le) {
-                    // TODO: check this twice!
-                    logical_result = true;
-                    return emit_ternary_operator(__ CreateICmpSLE(lv, rv, Names::comment(Names::Comment::CMP_SLE)),
-                                                 _true_obj, _false_obj, _true_obj->getType());
-                },
-                [&](const ast::EqExpression &le) { return static_cast<llvm::Value *>(nullptr); }},
-            expr._base);
-    }
-    else
-    {
-        logical_result = true;
+    auto *const is_same_ref = __ CreateICmpEQ(raw_lhs, raw_rhs, Names::comment(Names::Comment::CMP_EQ));
 
-        // cast to void pointers for compare
-        auto *const raw_lhs = __ CreateBitCast(lhs, _runtime.void_type()->getPointerTo());
-        auto *const raw_rhs = __ CreateBitCast(rhs, _runtime.void_type()->getPointerTo());
+    // do control flow
+    auto *const func = __ GetInsertBlock()->getParent();
 
-        auto *const is_same_ref = __ CreateICmpEQ(raw_lhs, raw_rhs, Names::comment(Names::Comment::CMP_EQ));
+    llvm::BasicBlock *true_block = nullptr, *false_block = nullptr, *merge_block = nullptr;
+    make_control_flow(is_same_ref, true_block, false_block, merge_block);
 
-        // do control flow
-        auto *const func = __ GetInsertBlock()->getParent();
+    // true branch - just jump to merge
+    __ SetInsertPoint(true_block);
+    __ CreateBr(merge_block);
 
-        llvm::BasicBlock *true_block = nullptr, *false_block = nullptr, *merge_block = nullptr;
-        make_control_flow(is_same_ref, true_block, false_block, merge_block);
+    // false branch - runtime call to equals
+    func->getBasicBlockList().push_back(false_block);
+    __ SetInsertPoint(false_block);
 
-        // true branch - just jump to merge
-        __ SetInsertPoint(true_block);
-        __ CreateBr(merge_block);
+    const auto &equals_func_id = RuntimeLLVM::RuntimeLLVMSymbols::EQUALS;
+    auto *equals_func = _runtime.symbol_by_id(equals_func_id)->_func;
 
-        // false branch - runtime call to equals
-        func->getBasicBlockList().push_back(false_block);
-        __ SetInsertPoint(false_block);
+    auto *const eq_call_res = __ CreateCall(equals_func, {lhs, rhs},
+                                            Names::name(Names::Comment::CALL, _runtime.symbol_name(equals_func_id)));
 
-        const auto &equals_func_id = RuntimeLLVM::RuntimeLLVMSymbols::EQUALS;
-        auto *equals_func = _runtime.symbol_by_id(equals_func_id)->_func;
+    auto *const false_branch_res = emit_ternary_operator(
+        __ CreateICmpEQ(eq_call_res, llvm::ConstantInt::get(equals_func->getReturnType(), TrueValue, true)),
+        _true_obj, _false_obj, _true_obj->getType());
 
-        auto *const eq_call_res = __ CreateCall(
-            equals_func, {lhs, rhs}, Names::name(Names::Comment::CALL, _runtime.symbol_name(equals_func_id)));
+    false_block = __ GetInsertBlock(); // emit_ternary_operator changed cfg
+    __ CreateBr(merge_block);
 
-        auto *const false_branch_res = emit_ternary_operator(
-            __ CreateICmpEQ(eq_call_res, llvm::ConstantInt::get(equals_func->getReturnType(), TrueValue, true)),
-            _true_obj, _false_obj, _true_obj->getType());
+    // merge results
+    func->getBasicBlockList().push_back(merge_block);
+    __ SetInsertPoint(merge_block);
+    auto *const result = __ CreatePHI(_true_obj->getType(), 2, Names::comment(Names::Comment::PHI));
+    result->addIncoming(_true_obj, true_block);
+    result->addIncoming(false_branch_res, false_block);
 
-        false_block = __ GetInsertBlock(); // emit_ternary_operator changed cfg
-        __ CreateBr(merge_block);
+    return result;
+}
+
+llvm::Value *CodeGenLLVM::emit_native_binary(const ast::BinaryExpression &expr)
+{
+    auto *const lv = emit_native(expr._lhs);
+    auto *const rv = emit_native(expr._rhs);
+
+    // comparisons give native Bool values
+    const auto logical = [&](llvm::Value *cmp) {
+        return __ CreateSelect(cmp, _true_val, _false_val, Names::comment(Names::Comment::SELECT));
+    };
 
-        // merge results
-        func->getBasicBlockList().push_back(merge_block);
-        __ SetInsertPoint(merge_block);
-        op_result = __ CreatePHI(_true_obj->getType(), 2, Names::comment(Names::Comment::PHI));
-        static_cast<llvm::PHINode *>(op_result)->addIncoming(_true_obj, true_block);
-        static_cast<llvm::PHINode *>(op_result)->addIncoming(false_branch_res, false_block);
+    return std::visit(
+        ast::overloaded{
+            [&](const ast::MinusExpression &minus) {
+                return __ CreateSub(lv, rv, Names::comment(Names::Comment::SUB));
+            },
+            [&](const ast::PlusExpression &plus) {
+                return __ CreateAdd(lv, rv, Names::comment(Names::Comment::ADD));
+            },
+            [&](const ast::DivExpression &div) {
+                return __ CreateSDiv(lv, rv, Names::comment(Names::Comment::DIV)); /* TODO: SDiv? */
+            },
+            [&](const ast::MulExpression &mul) {
+                return __ CreateMul(lv, rv, Names::comment(Names::Comment::MUL));
+            },
+            [&](const ast::LTExpression &lt) {
+                return logical(__ CreateICmpSLT(lv, rv, Names::comment(Names::Comment::CMP_SLT)));
+            },
+            [&](const ast::LEExpression &le) {
+                return logical(__ CreateICmpSLE(lv, rv, Names::comment(Names::Comment::CMP_SLE)));
+            },
+            [&](const ast::EqExpression &eq) {
+                return logical(__ CreateICmpEQ(lv, rv, Names::comment(Names::Comment::CMP_EQ)));
+            }},
+        expr._base);
+}
+
+llvm::Value *CodeGenLLVM::emit_unary_expr_inner(const ast::UnaryExpression &expr, ast::Type *expr_type)
+{
+    if (std::holds_alternative<ast::IsVoidExpression>(expr._base))
+    {
+        auto *const operand = emit_expr(expr._expr);
+
+        return emit_ternary_operator(
+            __ CreateICmpEQ(operand,
+                            llvm::ConstantPointerNull::get(static_cast<llvm::PointerType *>(operand->getType())),
+                            Names::name(Names::Comment::CMP_EQ)),
+            _true_obj, _false_obj, _true_obj->getType());
     }
 
-    return logical_result ? op_result : emit_allocate_int(op_result);
+    return emit_box(emit_native_unary(expr), expr_type);
 }
 
-llvm::Value *CodeGenLLVM::emit_unary_expr_inner(const ast::UnaryExpression &expr,
-                                                const std::shared_ptr<ast::Type> &expr_type)
+llvm::Value *CodeGenLLVM::emit_native_unary(const ast::UnaryExpression &expr)
 {
-    auto *const operand = emit_expr(expr._expr);
+    auto *const operand = emit_native(expr._expr);
 
     return std::visit(
         ast::overloaded{
-            [&](const ast::IsVoidExpression &isvoid) {
-                return emit_ternary_operator(
-                    __ CreateICmpEQ(
-                        operand, llvm::ConstantPointerNull::get(static_cast<llvm::PointerType *>(operand->getType())),
-                        Names::name(Names::Comment::CMP_EQ)),
-                    _true_obj, _false_obj, _true_obj->getType());
-            },
             [&](const ast::NotExpression &) {
-                auto *const not_res_val =
-                    __ CreateXor(emit_load_bool(operand), _true_val, Names::name(Names::Comment::XOR));
-
-                return emit_ternary_operator(
-                    __ CreateICmpEQ(not_res_val, _true_val, Names::name(Names::Comment::CMP_EQ)), _true_obj, _false_obj,
-                    _true_obj->getType());
+                return __ CreateXor(operand, _true_val, Names::name(Names::Comment::XOR));
             },
-            [&](const ast::NegExpression &neg) {
-                return emit_allocate_int(__ CreateNeg(emit_load_int(operand), Names::name(Names::Comment::NEG)));
+            [&](const ast::NegExpression &neg) { return __ CreateNeg(operand, Names::name(Names::Comment::NEG)); },
+            [&](const ast::IsVoidExpression &isvoid) -> llvm::Value * {
+                SHOULD_NOT_REACH_HERE();
+                return nullptr;
             }},
         expr._base);
 }
 
-llvm::Value *CodeGenLLVM::emit_bool_expr(const ast::BoolExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+llvm::Value *CodeGenLLVM::emit_native(ast::Expression *expr)
+{
+    auto *const value = std::visit(
+        ast::overloaded{
+            [&](const ast::IntExpression &number) -> llvm::Value * {
+                return llvm::ConstantInt::get(_runtime.default_int(), number._value, true);
+            },
+            [&](const ast::BoolExpression &boolean) -> llvm::Value * {
+                return boolean._value ? _true_val : _false_val;
+            },
+            [&](const ast::ObjectExpression &object) -> llvm::Value * {
+                const auto &symbol = _table.symbol(object._object);
+                return symbol._type == Symbol::UNBOXED || symbol._type == Symbol::INLINE_FIELD
+                           ? __ CreateLoad(_runtime.default_int(), emit_native_ptr(symbol), object._object.str())
+                           : nullptr;
+            },
+            [&](const ast::BinaryExpression &binary) -> llvm::Value * {
+                return !std::holds_alternative<ast::EqExpression>(binary._base) ||
+                               semant::Semant::is_int(binary._lhs->_type) || semant::Semant::is_bool(binary._lhs->_type)
+                           ? emit_native_binary(binary)
+                           : nullptr;
+            },
+            [&](const ast::UnaryExpression &unary) -> llvm::Value * {
+                return !std::holds_alternative<ast::IsVoidExpression>(unary._base) ? emit_native_unary(unary) : nullptr;
+            },
+            [&](const auto &) -> llvm::Value * { return nullptr; }},
+        expr->_data);
+
+    if (value)
+    {
+        return value;
+    }
+
+    // other expressions give objects
+    auto *const object = emit_expr(expr);
+    return semant::Semant::is_int(expr->_type) ? emit_load_int(object) : emit_load_bool(object);
+}
+
+llvm::Value *CodeGenLLVM::emit_box(llvm::Value *val, ast::Type *type)
+{
+    if (semant::Semant::is_int(type))
+    {
+        return emit_allocate_int(val);
+    }
+
+    // Bool objects are constants
+    return __ CreateSelect(__ CreateICmpEQ(val, _true_val, Names::comment(Names::Comment::CMP_EQ)), _true_obj,
+                           _false_obj, Names::comment(Names::Comment::SELECT));
+}
+
+llvm::Value *CodeGenLLVM::native_default(ast::Type *type)
+{
+    return semant::Semant::is_int(type) ? llvm::ConstantInt::get(_runtime.default_int(), 0, true) : _false_val;
+}
+
+llvm::Value *CodeGenLLVM::emit_native_ptr(const Symbol &symbol)
+{
+    if (symbol._type == Symbol::UNBOXED)
+    {
+        return symbol._value._ptr;
+    }
+
+    GUARANTEE_DEBUG(symbol._type == Symbol::INLINE_FIELD);
+    return __ CreateStructGEP(_data.class_struct(_builder->klass(_current_class->_type->_string)), emit_load_self(),
+                              symbol._value._offset);
+}
+
+llvm::Value *CodeGenLLVM::emit_bool_expr(const ast::BoolExpression &expr, ast::Type *expr_type)
 {
     return _data.bool_const(expr._value);
 }
 
-llvm::Value *CodeGenLLVM::emit_int_expr(const ast::IntExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+llvm::Value *CodeGenLLVM::emit_int_expr(const ast::IntExpression &expr, ast::Type *expr_type)
 {
     return _data.int_const(expr._value);
 }
 
-llvm::Value *CodeGenLLVM::emit_string_expr(const ast::StringExpression &expr,
-                                           const std::shared_ptr<ast::Type> &expr_type)
+llvm::Value *CodeGenLLVM::emit_string_expr(const ast::StringExpression &expr, ast::Type *expr_type)
 {
     return _data.string_const(expr._string);
 }
 
-llvm::Value *CodeGenLLVM::emit_object_expr_inner(const ast::ObjectExpression &expr,
-                                                 const std::shared_ptr<ast::Type> &expr_type)
+llvm::Value *CodeGenLLVM::emit_object_expr_inner(const ast::ObjectExpression &expr, ast::Type *expr_type)
 {
     const auto &object = _table.symbol(expr._object);
+    if (object._type == Symbol::UNBOXED || object._type == Symbol::INLINE_FIELD)
+    {
+        // native value is boxed only when the object is needed
+        return emit_box(__ CreateLoad(_runtime.default_int(), emit_native_ptr(object), expr._object.str()),
+                        object._value_type);
+    }
 
     auto *ptr = static_cast<llvm::Value *>(nullptr);
-    auto type = std::shared_ptr<ast::Type>(nullptr);
+    ast::Type *type = nullptr;
 
     if (object._type == Symbol::FIELD)
     {
@@ -371,18 +455,18 @@ llvm::Value *CodeGenLLVM::emit_object_expr_inner(const ast::ObjectExpression &ex
         type = object._value_type;
     }
 
-    return __ CreateLoad(_data.class_struct(_builder->klass(type->_string))->getPointerTo(), ptr, expr._object);
+    return __ CreateLoad(_data.class_struct(_builder->klass(type->_string))->getPointerTo(), ptr, expr._object.str());
 }
 
 llvm::Value *CodeGenLLVM::emit_load_self()
 {
-    const auto &self_val = _table.symbol(SelfObject);
+    const auto &self_val = _table.symbol(::Symbol(SelfObject));
 
     return __ CreateLoad(_data.class_struct(_builder->klass(self_val._value_type->_string))->getPointerTo(),
                          self_val._value._ptr, SelfObject);
 }
 
-llvm::Value *CodeGenLLVM::emit_new_inner(const std::shared_ptr<ast::Type> &klass_type)
+llvm::Value *CodeGenLLVM::emit_new_inner(ast::Type *klass_type)
 {
     const auto &alloc_func_id = RuntimeLLVM::RuntimeLLVMSymbols::GC_ALLOC;
     auto *const func = _runtime.symbol_by_id(alloc_func_id)->_func;
@@ -442,8 +526,7 @@ llvm::Value *CodeGenLLVM::emit_new_inner(const std::shared_ptr<ast::Type> &klass
     return raw_object;
 }
 
-llvm::Value *CodeGenLLVM::emit_new_expr_inner(const ast::NewExpression &expr,
-                                              const std::shared_ptr<ast::Type> &expr_type)
+llvm::Value *CodeGenLLVM::emit_new_expr_inner(const ast::NewExpression &expr, ast::Type *expr_type)
 {
     return emit_new_inner(expr._type);
 }
@@ -473,14 +556,13 @@ llvm::Value *CodeGenLLVM::emit_load_dispatch_table(llvm::Value *obj, const std::
                          Names::name(Names::Comment::OBJ_DISP_TAB, static_cast<std::string>(obj->getName())));
 }
 
-llvm::Value *CodeGenLLVM::emit_cases_expr_inner(const ast::CaseExpression &expr,
-                                                const std::shared_ptr<ast::Type> &expr_type)
+llvm::Value *CodeGenLLVM::emit_cases_expr_inner(const ast::CaseExpression &expr, ast::Type *expr_type)
 {
     auto *const pred = emit_expr(expr._expr);
 
     // we want to generate code for the the most precise cases first, so sort cases by tag
     // TODO: can be SELF_TYPE here?
-    auto cases = expr._cases;
+    std::vector<ast::Case *> cases(expr._cases.begin(), expr._cases.end());
     std::sort(cases.begin(), cases.end(), [&](const auto &case_a, const auto &case_b) {
         return _builder->tag(case_b->_type->_string) < _builder->tag(case_a->_type->_string);
     });
@@ -582,14 +664,31 @@ llvm::Value *CodeGenLLVM::emit_cases_expr_inner(const ast::CaseExpression &expr,
     return result;
 }
 
-llvm::Value *CodeGenLLVM::emit_let_expr_inner(const ast::LetExpression &expr,
-                                              const std::shared_ptr<ast::Type> &expr_type)
+llvm::Value *CodeGenLLVM::emit_let_expr_inner(const ast::LetExpression &expr, ast::Type *expr_type)
 {
+    if (expr._unboxed)
+    {
+        // initializer is in the outer scope
+        auto *const initializer = expr._expr ? emit_native(expr._expr) : native_default(expr._type);
+
+        _table.push_scope();
+
+        const auto &name = expr._object->_object;
+        auto *const local_val =
+            __ CreateAlloca(_runtime.default_int(), nullptr, Names::name(Names::Comment::ALLOCA, name));
+        _table.add_symbol(name, Symbol(local_val, expr._type, true));
+        __ CreateStore(initializer, local_val);
+
+        auto *const result = emit_expr(expr._body_expr);
+        _table.pop_scope();
+
+        return result;
+    }
+
     return emit_in_scope(expr._object, expr._type, expr._body_expr, expr._expr ? emit_expr(expr._expr) : nullptr);
 }
 
-llvm::Value *CodeGenLLVM::emit_loop_expr_inner(const ast::WhileExpression &expr,
-                                               const std::shared_ptr<ast::Type> &expr_type)
+llvm::Value *CodeGenLLVM::emit_loop_expr_inner(const ast::WhileExpression &expr, ast::Type *expr_type)
 {
     auto *const func = __ GetInsertBlock()->getParent();
 
@@ -600,9 +699,8 @@ llvm::Value *CodeGenLLVM::emit_loop_expr_inner(const ast::WhileExpression &expr,
     __ CreateBr(loop_header);
 
     __ SetInsertPoint(loop_header);
-    __ CreateCondBr(
-        __ CreateICmpEQ(emit_load_bool(emit_expr(expr._predicate)), _true_val, Names::comment(Names::Comment::CMP_EQ)),
-        loop_body, loop_tail);
+    __ CreateCondBr(__ CreateICmpEQ(emit_native(expr._predicate), _true_val, Names::comment(Names::Comment::CMP_EQ)),
+                    loop_body, loop_tail);
     auto *const new_loop_header = __ GetInsertBlock();
 
     func->getBasicBlockList().push_back(loop_body);
@@ -617,7 +715,7 @@ llvm::Value *CodeGenLLVM::emit_loop_expr_inner(const ast::WhileExpression &expr,
     return llvm::ConstantPointerNull::get(_data.class_struct(_builder->klass(expr_type->_string))->getPointerTo());
 }
 
-llvm::Value *CodeGenLLVM::emit_if_expr_inner(const ast::IfExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+llvm::Value *CodeGenLLVM::emit_if_expr_inner(const ast::IfExpression &expr, ast::Type *expr_type)
 {
     // do control flow
     auto *const func = __ GetInsertBlock()->getParent();
@@ -627,7 +725,7 @@ llvm::Value *CodeGenLLVM::emit_if_expr_inner(const ast::IfExpression &expr, cons
             ->getPointerTo();
 
     auto *const pred =
-        __ CreateICmpEQ(emit_load_bool(emit_expr(expr._predicate)), _true_val, Names::comment(Names::Comment::CMP_EQ));
+        __ CreateICmpEQ(emit_native(expr._predicate), _true_val, Names::comment(Names::Comment::CMP_EQ));
 
     llvm::BasicBlock *true_block = nullptr, *false_block = nullptr, *merge_block = nullptr;
     make_control_flow(pred, true_block, false_block, merge_block);
@@ -656,8 +754,25 @@ llvm::Value *CodeGenLLVM::emit_if_expr_inner(const ast::IfExpression &expr, cons
     return phi;
 }
 
-llvm::Value *CodeGenLLVM::emit_dispatch_expr_inner(const ast::DispatchExpression &expr,
-                                                   const std::shared_ptr<ast::Type> &expr_type)
+llvm::Value *CodeGenLLVM::emit_table_call(const std::shared_ptr<Klass> &klass, const ::Symbol &method_name,
+                                          const std::vector<llvm::Value *> &args)
+{
+    auto *const dispatch_table_ptr = emit_load_dispatch_table(args[0], klass);
+
+    // get pointer on method address
+    // method has the same type as in this klass
+    auto *const base_method = _module.getFunction(klass->method_full_name(method_name));
+    auto *const method_ptr = __ CreateStructGEP(_data.class_disp_tab(klass)->getValueType(), dispatch_table_ptr,
+                                                klass->method_index(method_name));
+
+    // load method
+    auto *const method = __ CreateLoad(base_method->getType(), method_ptr, method_name.str());
+
+    // call
+    return __ CreateCall(base_method->getFunctionType(), method, args, Names::name(Names::Comment::CALL, method_name));
+}
+
+llvm::Value *CodeGenLLVM::emit_dispatch_expr_inner(const ast::DispatchExpression &expr, ast::Type *expr_type)
 {
     auto *const func = __ GetInsertBlock()->getParent();
 
@@ -686,26 +801,67 @@ llvm::Value *CodeGenLLVM::emit_dispatch_expr_inner(const ast::DispatchExpression
     const auto &method_name = expr._object->_object;
     auto *const call = std::visit(
         ast::overloaded{
-            [&](const ast::VirtualDispatchExpression &disp) {
-                const auto &klass =
-                    _builder->klass(semant::Semant::exact_type(expr._expr->_type, _current_class->_type)->_string);
+            [&](const ast::VirtualDispatchExpression &disp) -> llvm::Value * {
+                if (expr._direct)
+                {
+                    // the only possible implementation
+                    auto *const method =
+                        _module.getFunction(_builder->klass(expr._direct->_string)->method_full_name(method_name));
 
-                auto *const dispatch_table_ptr = emit_load_dispatch_table(receiver, klass);
+                    GUARANTEE_DEBUG(method);
 
-                // get pointer on method address
-                // method has the same type as in this klass
-                auto *const base_method = _module.getFunction(klass->method_full_name(method_name));
-                auto *const method_ptr = __ CreateStructGEP(_data.class_disp_tab(klass)->getValueType(),
-                                                            dispatch_table_ptr, klass->method_index(method_name));
+                    return __ CreateCall(method, args, Names::name(Names::Comment::CALL, method_name));
+                }
+
+                const auto &klass =
+                    _builder->klass(semant::Semant::exact_type(expr._expr->_type, _current_class->_type)->_string);
 
-                // load method
-                auto *const method = __ CreateLoad(base_method->getType(), method_ptr, method_name);
+                if (!expr._likely)
+                {
+                    return emit_table_call(klass, method_name, args);
+                }
 
-                // call
-                return __ CreateCall(base_method->getFunctionType(), method, args,
-                                     Names::name(Names::Comment::CALL, method_name));
+                // guess the class of the receiver: if its tag is in the subtree of the likely class, call the
+                // implementation directly
+                const auto &likely = _builder->klass(expr._likely->_string);
+                auto *const tag = emit_load_tag(receiver, _data.class_struct(klass));
+                auto *const tag_type = _runtime.header_elem_type(HeaderLayout::Tag);
+
+                auto *const less = __ CreateICmpSLT(tag, llvm::ConstantInt::get(tag_type, likely->tag()),
+                                                    Names::comment(Names::Comment::CMP_SLT));
+                auto *const higher = __ CreateICmpSGT(tag, llvm::ConstantInt::get(tag_type, likely->child_max_tag()),
+                                                      Names::comment(Names::Comment::CMP_SGT));
+                auto *const miss = __ CreateOr(less, higher, Names::comment(Names::Comment::OR));
+
+                llvm::BasicBlock *miss_block = nullptr, *hit_block = nullptr, *guess_merge_block = nullptr;
+                make_control_flow(miss, miss_block, hit_block, guess_merge_block);
+
+                // miss
+                auto *const table_call = __ CreateBitCast(emit_table_call(klass, method_name, args), phi_type);
+                __ CreateBr(guess_merge_block);
+                miss_block = __ GetInsertBlock();
+
+                // hit
+                func->getBasicBlockList().push_back(hit_block);
+                __ SetInsertPoint(hit_block);
+                auto *const likely_method = _module.getFunction(likely->method_full_name(method_name));
+                GUARANTEE_DEBUG(likely_method);
+                auto *const direct_call = __ CreateBitCast(
+                    __ CreateCall(likely_method, args, Names::name(Names::Comment::CALL, method_name)), phi_type);
+                __ CreateBr(guess_merge_block);
+                hit_block = __ GetInsertBlock();
+
+                // merge
+                func->getBasicBlockList().push_back(guess_merge_block);
+                __ SetInsertPoint(guess_merge_block);
+
+                auto *const phi = __ CreatePHI(phi_type, 2, Names::comment(Names::Comment::PHI));
+                phi->addIncoming(table_call, miss_block);
+                phi->addIncoming(direct_call, hit_block);
+
+                return phi;
             },
-            [&](const ast::StaticDispatchExpression &disp) {
+            [&](const ast::StaticDispatchExpression &disp) -> llvm::Value * {
                 // TODO: can be SELF_TYPE here?
                 auto *const method =
                     _module.getFunction(_builder->klass(disp._type->_string)->method_full_name(method_name));
@@ -717,6 +873,7 @@ llvm::Value *CodeGenLLVM::emit_dispatch_expr_inner(const ast::DispatchExpression
         expr._base);
     auto *const casted_call = __ CreateBitCast(call, phi_type);
     __ CreateBr(merge_block);
+    true_block = __ GetInsertBlock(); // guarded call changes cfg
 
     // it is null
     func->getBasicBlockList().push_back(false_block);
@@ -742,9 +899,22 @@ llvm::Value *CodeGenLLVM::emit_dispatch_expr_inner(const ast::DispatchExpression
     return phi;
 }
 
-llvm::Value *CodeGenLLVM::emit_assign_expr_inner(const ast::AssignExpression &expr,
-                                                 const std::shared_ptr<ast::Type> &expr_type)
+llvm::Value *CodeGenLLVM::emit_assign_expr_inner(const ast::AssignExpression &expr, ast::Type *expr_type)
 {
+    if (const auto native = _table.symbol(expr._object->_object);
+        native._type == Symbol::UNBOXED || native._type == Symbol::INLINE_FIELD)
+    {
+        // copy of the symbol, because the value can add symbols
+        auto *const value = emit_native(expr._expr);
+        __ CreateStore(value, emit_native_ptr(native));
+
+        // result of the assignment to the unboxed variable is never used
+        return native._type == Symbol::UNBOXED || expr._discarded
+                   ? llvm::UndefValue::get(
+                         _data.class_struct(_builder->klass(native._value_type->_string))->getPointerTo())
+                   : emit_box(value, native._value_type);
+    }
+
     auto *const value = emit_expr(expr._expr);
 
     const auto &symbol = _table.symbol(expr._object->_object);
@@ -760,7 +930,8 @@ llvm::Value *CodeGenLLVM::emit_assign_expr_inner(const ast::AssignExpression &ex
 
 llvm::Value *CodeGenLLVM::emit_load_int(llvm::Value *int_obj)
 {
-    return emit_load_primitive(int_obj, _data.class_struct(_builder->klass(BaseClassesNames[BaseClasses::INT])));
+    return emit_load_primitive(int_obj,
+                               _data.class_struct(_builder->klass(::Symbol(BaseClassesNames[BaseClasses::INT]))));
 }
 
 llvm::Value *CodeGenLLVM::emit_load_primitive(llvm::Value *obj, llvm::Type *obj_type)
@@ -787,17 +958,17 @@ llvm::Value *CodeGenLLVM::emit_allocate_primitive(llvm::Value *val, const std::s
 
 llvm::Value *CodeGenLLVM::emit_allocate_int(llvm::Value *val)
 {
-    return emit_allocate_primitive(val, _builder->klass(BaseClassesNames[BaseClasses::INT]));
+    return emit_allocate_primitive(val, _builder->klass(::Symbol(BaseClassesNames[BaseClasses::INT])));
 }
 
 llvm::Value *CodeGenLLVM::emit_load_bool(llvm::Value *bool_obj)
 {
-    return emit_load_primitive(bool_obj, _data.class_struct(_builder->klass(BaseClassesNames[BaseClasses::BOOL])));
+    return emit_load_primitive(bool_obj,
+                               _data.class_struct(_builder->klass(::Symbol(BaseClassesNames[BaseClasses::BOOL]))));
 }
 
-llvm::Value *CodeGenLLVM::emit_in_scope(const std::shared_ptr<ast::ObjectExpression> &object,
-                                        const std::shared_ptr<ast::Type> &object_type,
-                                        const std::shared_ptr<ast::Expression> &expr, llvm::Value *initializer)
+llvm::Value *CodeGenLLVM::emit_in_scope(ast::ObjectExpression *object, ast::Type *object_type, ast::Expression *expr,
+                                        llvm::Value *initializer)
 {
     _table.push_scope();
 
@@ -835,7 +1006,7 @@ void CodeGenLLVM::emit_runtime_main()
     auto *entry = llvm::BasicBlock::Create(_context, Names::comment(Names::Comment::ENTRY_BLOCK), runtime_main);
     __ SetInsertPoint(entry);
 
-    const auto main_klass = _builder->klass(MainClassName);
+    const auto main_klass = _builder->klass(::Symbol(MainClassName));
     auto *const main_object = emit_new_inner(main_klass->klass());
 
     const auto main_method = main_klass->method_full_name(MainMethodName);
@@ -45,50 +45,38 @@ class CodeGenLLVM : public CodeGen<llvm::Value *, Symbol>
 
     void add_fields() override;
 
-    void emit_class_method_inner(const std::shared_ptr<ast::Feature> &method) override;
+    void emit_class_method_inner(ast::Feature *method) override;
 
     void emit_class_init_method_inner() override;
 
-    llvm::Value *emit_binary_expr_inner(const ast::BinaryExpression &expr,
-                                        const std::shared_ptr<ast::Type> &expr_type) override;
+    llvm::Value *emit_binary_expr_inner(const ast::BinaryExpression &expr, ast::Type *expr_type) override;
 
-    llvm::Value *emit_unary_expr_inner(const ast::UnaryExpression &expr,
-                                       const std::shared_ptr<ast::Type> &expr_type) override;
+    llvm::Value *emit_unary_expr_inner(const ast::UnaryExpression &expr, ast::Type *expr_type) override;
 
-    llvm::Value *emit_bool_expr(const ast::BoolExpression &expr, const std::shared_ptr<ast::Type> &expr_type) override;
+    llvm::Value *emit_bool_expr(const ast::BoolExpression &expr, ast::Type *expr_type) override;
 
-    llvm::Value *emit_int_expr(const ast::IntExpression &expr, const std::shared_ptr<ast::Type> &expr_type) override;
+    llvm::Value *emit_int_expr(const ast::IntExpression &expr, ast::Type *expr_type) override;
 
-    llvm::Value *emit_string_expr(const ast::StringExpression &expr,
-                                  const std::shared_ptr<ast::Type> &expr_type) override;
+    llvm::Value *emit_string_expr(const ast::StringExpression &expr, ast::Type *expr_type) override;
 
-    llvm::Value *emit_object_expr_inner(const ast::ObjectExpression &expr,
-                                        const std::shared_ptr<ast::Type> &expr_type) override;
+    llvm::Value *emit_object_expr_inner(const ast::ObjectExpression &expr, ast::Type *expr_type) override;
 
-    llvm::Value *emit_new_expr_inner(const ast::NewExpression &expr,
-                                     const std::shared_ptr<ast::Type> &expr_type) override;
+    llvm::Value *emit_new_expr_inner(const ast::NewExpression &expr, ast::Type *expr_type) override;
 
-    llvm::Value *emit_cases_expr_inner(const ast::CaseExpression &expr,
-                                       const std::shared_ptr<ast::Type> &expr_type) override;
+    llvm::Value *emit_cases_expr_inner(const ast::CaseExpression &expr, ast::Type *expr_type) override;
 
-    llvm::Value *emit_let_expr_inner(const ast::LetExpression &expr,
-                                     const std::shared_ptr<ast::Type> &expr_type) override;
+    llvm::Value *emit_let_expr_inner(const ast::LetExpression &expr, ast::Type *expr_type) override;
 
-    llvm::Value *emit_loop_expr_inner(const ast::WhileExpression &expr,
-                                      const std::shared_ptr<ast::Type> &expr_type) override;
+    llvm::Value *emit_loop_expr_inner(const ast::WhileExpression &expr, ast::Type *expr_type) override;
 
-    llvm::Value *emit_if_expr_inner(const ast::IfExpression &expr,
-                                    const std::shared_ptr<ast::Type> &expr_type) override;
+    llvm::Value *emit_if_expr_inner(const ast::IfExpression &expr, ast::Type *expr_type) override;
 
-    llvm::Value *emit_dispatch_expr_inner(const ast::DispatchExpression &expr,
-                                          const std::shared_ptr<ast::Type> &expr_type) override;
+    llvm::Value *emit_dispatch_expr_inner(const ast::DispatchExpression &expr, ast::Type *expr_type) override;
 
-    llvm::Value *emit_assign_expr_inner(const ast::AssignExpression &expr,
-                                        const std::shared_ptr<ast::Type> &expr_type) override;
+    llvm::Value *emit_assign_expr_inner(const ast::AssignExpression &expr, ast::Type *expr_type) override;
 
-    llvm::Value *emit_in_scope(const std::shared_ptr<ast::ObjectExpression> &object,
-                               const std::shared_ptr<ast::Type> &object_type,
-                               const std::shared_ptr<ast::Expression> &expr, llvm::Value *initializer);
+    llvm::Value *emit_in_scope(ast::ObjectExpression *object, ast::Type *object_type, ast::Expression *expr,
+                               llvm::Value *initializer);
 
     // load/allocate basic values
     llvm::Value *emit_load_primitive(llvm::Value *obj, llvm::Type *obj_type);
@@ -97,13 +85,22 @@ class CodeGenLLVM : public CodeGen<llvm::Value *, Symbol>
     llvm::Value *emit_allocate_int(llvm::Value *val);
     llvm::Value *emit_load_bool(llvm::Value *bool_obj);
 
+    // native values of Int and Bool expressions. Objects are allocated only when values escape, see passes::Unboxing
+    llvm::Value *emit_native(ast::Expression *expr);
+    llvm::Value *emit_native_binary(const ast::BinaryExpression &expr);
+    llvm::Value *emit_native_unary(const ast::UnaryExpression &expr);
+    llvm::Value *emit_box(llvm::Value *val, ast::Type *type);
+    llvm::Value *native_default(ast::Type *type);
+    // pointer to the native value of the unboxed local or inline field
+    llvm::Value *emit_native_ptr(const Symbol &symbol);
+
     // void emit_gc_update(const Register &obj, const int &offset);
 
     // Main func that allocate Main object and call Main_main
     void emit_runtime_main();
 
     // helpers
-    llvm::Value *emit_new_inner(const std::shared_ptr<ast::Type> &klass);
+    llvm::Value *emit_new_inner(ast::Type *klass);
     llvm::Value *emit_load_self();
     llvm::Value *emit_ternary_operator(llvm::Value *pred, llvm::Value *true_val, llvm::Value *false_val,
                                        llvm::Type *type);
@@ -115,6 +112,10 @@ class CodeGenLLVM : public CodeGen<llvm::Value *, Symbol>
     llvm::Value *emit_load_size(llvm::Value *objv, llvm::Type *obj_type);
     llvm::Value *emit_load_dispatch_table(llvm::Value *obj, const std::shared_ptr<Klass> &klass);
 
+    // call the method from the dispatch table of the receiver, args[0]. klass is the static class of the receiver
+    llvm::Value *emit_table_call(const std::shared_ptr<Klass> &klass, const ::Symbol &method_name,
+                                 const std::vector<llvm::Value *> &args);
+
     void execute_linker(const std::string &object_file_name, const std::string &out_file_name);
     std::pair<std::string, std::string> find_best_vec_ext();
 
@@ -1,4 +1,5 @@
 #include "DataLLVM.h"
+#include "codegen/arch/llvm/klass/KlassLLVM.h"
 #include "codegen/emitter/data/Data.inline.h"
 
 using namespace codegen;
@@ -9,29 +10,29 @@ DataLLVM::DataLLVM(const std::shared_ptr<KlassBuilder> &builder, llvm::Module &m
     // publish basic classes structures
     for (auto i = static_cast<int>(BaseClasses::OBJECT); i < BaseClasses::SELF_TYPE; i++)
     {
+        const ::Symbol klass_name(BaseClassesNames[i]);
         _classes.insert(
-            {BaseClassesNames[i],
-             llvm::StructType::create(_module.getContext(), _builder->klass(BaseClassesNames[i])->prototype())});
+            {klass_name, llvm::StructType::create(_module.getContext(), _builder->klass(klass_name)->prototype())});
     }
 
-    make_base_class(_builder->klass(BaseClassesNames[BaseClasses::OBJECT]), {});
+    make_base_class(_builder->klass(::Symbol(BaseClassesNames[BaseClasses::OBJECT])), {});
 
-    make_base_class(_builder->klass(BaseClassesNames[BaseClasses::INT]), {_runtime.default_int()});
+    make_base_class(_builder->klass(::Symbol(BaseClassesNames[BaseClasses::INT])), {_runtime.default_int()});
 
     // use 64 bit field for allignment
-    make_base_class(_builder->klass(BaseClassesNames[BaseClasses::BOOL]), {_runtime.default_int()});
+    make_base_class(_builder->klass(::Symbol(BaseClassesNames[BaseClasses::BOOL])), {_runtime.default_int()});
 
     make_base_class(
-        _builder->klass(BaseClassesNames[BaseClasses::STRING]),
-        {_classes[BaseClassesNames[BaseClasses::INT]]->getPointerTo(), _runtime.int8_type()->getPointerTo()});
+        _builder->klass(::Symbol(BaseClassesNames[BaseClasses::STRING])),
+        {_classes[::Symbol(BaseClassesNames[BaseClasses::INT])]->getPointerTo(), _runtime.int8_type()->getPointerTo()});
 
-    make_base_class(_builder->klass(BaseClassesNames[BaseClasses::IO]), {});
+    make_base_class(_builder->klass(::Symbol(BaseClassesNames[BaseClasses::IO])), {});
 
     // create constants for basic classes tags
     // order in tags synchronized with RuntimeLLVM::RuntimeLLVMSymbols
-    const int tags[] = {_builder->tag(BaseClassesNames[BaseClasses::INT]),
-                        _builder->tag(BaseClassesNames[BaseClasses::BOOL]),
-                        _builder->tag(BaseClassesNames[BaseClasses::STRING])};
+    const int tags[] = {_builder->tag(::Symbol(BaseClassesNames[BaseClasses::INT])),
+                        _builder->tag(::Symbol(BaseClassesNames[BaseClasses::BOOL])),
+                        _builder->tag(::Symbol(BaseClassesNames[BaseClasses::STRING]))};
     auto *const tag_type = _runtime.header_elem_type(HeaderLayout::Tag);
     for (int i = RuntimeLLVM::RuntimeLLVMSymbols::INT_TAG_NAME; i <= RuntimeLLVM::RuntimeLLVMSymbols::STRING_TAG_NAME;
          i++)
@@ -130,12 +131,20 @@ void DataLLVM::class_struct_inner(const std::shared_ptr<Klass> &klass)
     make_header(klass, fields);
     fields.push_back(class_disp_tab(klass)->getType()); // dispatch table
 
-    // add fields
-    std::for_each(klass->fields_begin(), klass->fields_end(), [&fields, klass, this](const auto &field) {
+    // add fields. Int and Bool values are stored in the object, they have the size of the pointer
+    for (auto field = klass->fields_begin(); field != klass->fields_end(); field++)
+    {
+        if (std::static_pointer_cast<KlassLLVM>(klass)->is_inline_field(
+                klass->field_offset(field - klass->fields_begin())))
+        {
+            fields.push_back(_runtime.default_int());
+            continue;
+        }
+
         fields.push_back(
-            class_struct(_builder->klass(semant::Semant::exact_type(field->_type, klass->klass())->_string))
+            class_struct(_builder->klass(semant::Semant::exact_type((*field)->_type, klass->klass())->_string))
                 ->getPointerTo());
-    });
+    }
 
     class_structure->setBody(fields);
 
@@ -144,11 +153,9 @@ void DataLLVM::class_struct_inner(const std::shared_ptr<Klass> &klass)
 
 void DataLLVM::class_disp_tab_inner(const std::shared_ptr<Klass> &klass)
 {
-    std::vector<llvm::Type *> method_types;
-    std::vector<llvm::Constant *> methods;
-
-    for_each(klass->methods_begin(), klass->methods_end(), [this, &methods, &method_types, &klass](const auto &method) {
-        const auto method_full_name = klass->method_full_name(method.second->_object->_object);
+    // declare all methods, direct calls need them too
+    for_each(klass->methods_begin(), klass->methods_end(), [this, &klass](const auto &method) {
+        const auto method_full_name = klass->method_full_name(method.second->_object->_object.str());
 
         CODEGEN_VERBOSE_ONLY(LOG_ENTER("DECLARE METHOD \"" + method_full_name + "\""));
 
@@ -188,28 +195,44 @@ void DataLLVM::class_disp_tab_inner(const std::shared_ptr<Klass> &klass)
                 func->arg_begin()->setName(SelfObject);
                 for (auto *arg = func->arg_begin() + 1; arg != func->arg_end(); arg++)
                 {
-                    arg->setName(method_formals._formals[arg - func->arg_begin() - 1]->_object->_object);
+                    arg->setName(method_formals._formals[arg - func->arg_begin() - 1]->_object->_object.str());
                 }
             }
         }
 
         CODEGEN_VERBOSE_ONLY(LOG_EXIT("DECLARE METHOD \"" + method_full_name + "\""));
+    });
+
+    std::vector<llvm::Type *> method_types;
+    std::vector<llvm::Constant *> methods;
+
+    // unreachable method is never called through the slot
+    for (const auto &method : klass->dispatch_table())
+    {
+        auto *const func = _module.getFunction(klass->method_full_name(method.second->_object->_object.str()));
+        GUARANTEE_DEBUG(func);
 
         method_types.push_back(func->getType());
-        methods.push_back(func);
-    });
+        methods.push_back(_builder->analysis().is_reachable(method.second)
+                              ? static_cast<llvm::Constant *>(func)
+                              : llvm::ConstantPointerNull::get(func->getType()));
+    }
 
     const auto &disp_tab_name = klass->disp_tab();
-    _dispatch_tables.insert(
-        {klass->name(), make_constant_struct(disp_tab_name,
-                                             llvm::StructType::create(_module.getContext(), method_types,
-                                                                      Names::name(Names::Comment::TYPE, disp_tab_name)),
-                                             methods)});
+    auto *const disp_tab_type = llvm::StructType::create(_module.getContext(), method_types,
+                                                         Names::name(Names::Comment::TYPE, disp_tab_name));
+
+    // class without instances needs only the type of its table
+    auto *const disp_tab =
+        _builder->analysis().is_live(klass->name())
+            ? make_constant_struct(disp_tab_name, disp_tab_type, methods)
+            : static_cast<llvm::GlobalVariable *>(_module.getOrInsertGlobal(disp_tab_name, disp_tab_type));
+    _dispatch_tables.insert({klass->name(), disp_tab});
 }
 
 void DataLLVM::int_const_inner(const int64_t &value)
 {
-    const auto &klass_name = BaseClassesNames[BaseClasses::INT];
+    const ::Symbol klass_name(BaseClassesNames[BaseClasses::INT]);
 
     const auto &klass = _builder->klass(klass_name);
     auto *const int_struct = _classes.at(klass_name);
@@ -249,7 +272,7 @@ llvm::Constant *DataLLVM::make_char_string(const std::string &str)
 
 void DataLLVM::string_const_inner(const std::string &str)
 {
-    const auto &klass_name = BaseClassesNames[BaseClasses::STRING];
+    const ::Symbol klass_name(BaseClassesNames[BaseClasses::STRING]);
     const auto &klass = _builder->klass(klass_name);
 
     auto *const constant_str = make_constant_struct(
@@ -265,7 +288,7 @@ void DataLLVM::string_const_inner(const std::string &str)
 
 void DataLLVM::bool_const_inner(const bool &value)
 {
-    const auto &klass_name = BaseClassesNames[BaseClasses::BOOL];
+    const ::Symbol klass_name(BaseClassesNames[BaseClasses::BOOL]);
 
     const auto &klass = _builder->klass(klass_name);
     auto *const bool_struct = _classes.at(klass_name);
@@ -291,11 +314,14 @@ void DataLLVM::gen_class_obj_tab()
 
     std::vector<llvm::Constant *> init_methods;
 
+    // runtime creates objects only of instantiated classes
     for (const auto &klass : _builder->klasses())
     {
         auto *const init_method = _module.getFunction(klass->init_method());
         GUARANTEE_DEBUG(init_method);
-        init_methods.push_back(init_method);
+        init_methods.push_back(_builder->analysis().is_live(klass->name())
+                                   ? static_cast<llvm::Constant *>(init_method)
+                                   : llvm::ConstantPointerNull::get(init_method->getType()));
     }
 
     GUARANTEE_DEBUG(init_methods.size());
@@ -307,17 +333,20 @@ void DataLLVM::gen_class_name_tab()
 {
     std::vector<llvm::Constant *> names;
 
+    const auto &string_klass = _builder->klass(::Symbol(BaseClassesNames[BaseClasses::STRING]));
+    auto *const string_type = class_struct(string_klass)->getPointerTo();
+
+    // runtime looks up names only for tags of objects
     for (const auto &klass : _builder->klasses())
     {
-        names.push_back(string_const(klass->name()));
+        names.push_back(_builder->analysis().is_live(klass->name())
+                            ? static_cast<llvm::Constant *>(string_const(klass->name()))
+                            : llvm::ConstantPointerNull::get(string_type));
     }
 
     GUARANTEE_DEBUG(names.size());
-    make_constant_array(
-        _runtime.symbol_name(RuntimeLLVM::RuntimeLLVMSymbols::CLASS_NAME_TAB),
-        llvm::ArrayType::get(class_struct(_builder->klass(BaseClassesNames[BaseClasses::STRING]))->getPointerTo(),
-                             names.size()),
-        names);
+    make_constant_array(_runtime.symbol_name(RuntimeLLVM::RuntimeLLVMSymbols::CLASS_NAME_TAB),
+                        llvm::ArrayType::get(string_type, names.size()), names);
 }
 
 void DataLLVM::emit_inner(const std::string &out_file)
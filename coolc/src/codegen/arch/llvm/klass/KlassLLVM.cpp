@@ -11,7 +11,7 @@ std::string KlassLLVM::method_full_name(const std::string &method_name) const
     return Names::method_full_name(entry->first->_string, entry->second->_object->_object, FULL_METHOD_DELIM);
 }
 
-std::shared_ptr<Klass> KlassBuilderLLVM::make_klass(const std::shared_ptr<ast::Class> &klass)
+std::shared_ptr<Klass> KlassBuilderLLVM::make_klass(ast::Class *klass)
 {
     return klass ? std::make_shared<KlassLLVM>(klass, this) : std::make_shared<KlassLLVM>();
 }
\ No newline at end of file
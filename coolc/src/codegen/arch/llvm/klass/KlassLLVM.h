@@ -13,7 +13,7 @@ class KlassLLVM : public Klass
     static constexpr std::string_view PROTOTYPE_NAME_SUFFIX = "-protObj";
     static constexpr std::string_view DISP_TAB_NAME_SUFFIX = "-dispTab";
 
-    KlassLLVM(const std::shared_ptr<ast::Class> &klass, const KlassBuilder *builder) : Klass(klass, builder)
+    KlassLLVM(ast::Class *klass, const KlassBuilder *builder) : Klass(klass, builder)
     {
     }
 
@@ -40,12 +40,25 @@ class KlassLLVM : public Klass
      * @param field_idx Absolute index
      * @return Field type
      */
-    const std::shared_ptr<ast::Type> &field_type(const int &field_idx) const
+    ast::Type *field_type(const int &field_idx) const
     {
         GUARANTEE_DEBUG(field_idx - HeaderLayout::HeaderLayoutElemets < _fields.size());
         return _fields[field_idx - HeaderLayout::HeaderLayoutElemets]->_type;
     }
 
+    /**
+     * @brief Check if field holds the native value instead of the pointer to the object
+     *
+     * @param field_idx Absolute index
+     * @return True for Int and Bool fields of classes that are not basic
+     */
+    bool is_inline_field(const int &field_idx) const
+    {
+        auto *const type = field_type(field_idx);
+        return !semant::Semant::is_basic_type(_klass) &&
+               (semant::Semant::is_int(type) || semant::Semant::is_bool(type));
+    }
+
     std::string init_method() const override
     {
         return name() + static_cast<std::string>(INIT_METHOD_SUFFIX);
@@ -65,7 +78,7 @@ class KlassLLVM : public Klass
 class KlassBuilderLLVM : public KlassBuilder
 {
   private:
-    std::shared_ptr<Klass> make_klass(const std::shared_ptr<ast::Class> &klass) override;
+    std::shared_ptr<Klass> make_klass(ast::Class *klass) override;
 
   public:
     explicit KlassBuilderLLVM(const std::shared_ptr<semant::ClassNode> &root) : KlassBuilder(root)
@@ -11,11 +11,13 @@ struct Symbol
     enum SymbolType
     {
         FIELD,
-        LOCAL
+        INLINE_FIELD, // field that holds the native value of Int or Bool
+        LOCAL,
+        UNBOXED // local that holds the native value of Int or Bool
     };
 
     const SymbolType _type;
-    const std::shared_ptr<ast::Type> _value_type;
+    ast::Type *const _value_type;
 
     union {
         uint64_t _offset;
@@ -27,8 +29,10 @@ struct Symbol
      *
      * @param offset Offset from base
      * @param type Value type
+     * @param inlined Field holds the native value
      */
-    Symbol(const uint64_t &offset, const std::shared_ptr<ast::Type> &type) : _type(SymbolType::FIELD), _value_type(type)
+    Symbol(const uint64_t &offset, ast::Type *type, const bool &inlined = false)
+        : _type(inlined ? SymbolType::INLINE_FIELD : SymbolType::FIELD), _value_type(type)
     {
         _value._offset = offset;
     }
@@ -38,8 +42,10 @@ struct Symbol
      *
      * @param val Value
      * @param type Value type
+     * @param unboxed Value is the pointer to the native value
      */
-    Symbol(llvm::Value *val, const std::shared_ptr<ast::Type> &type) : _type(SymbolType::LOCAL), _value_type(type)
+    Symbol(llvm::Value *val, ast::Type *type, const bool &unboxed = false)
+        : _type(unboxed ? SymbolType::UNBOXED : SymbolType::LOCAL), _value_type(type)
     {
         _value._ptr = val;
     }
@@ -47,7 +53,17 @@ struct Symbol
     operator std::string() const
     {
         // TODO: maybe add more info fo local
-        return _type == SymbolType::FIELD ? "FIELD with index " + std::to_string(_value._offset) : "LOCAL";
+        switch (_type)
+        {
+        case SymbolType::FIELD:
+            return "FIELD with index " + std::to_string(_value._offset);
+        case SymbolType::INLINE_FIELD:
+            return "INLINE FIELD with index " + std::to_string(_value._offset);
+        case SymbolType::LOCAL:
+            return "LOCAL";
+        default:
+            return "UNBOXED LOCAL";
+        }
     }
 };
 }; // namespace codegen
\ No newline at end of file
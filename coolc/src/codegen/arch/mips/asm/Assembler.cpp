@@ -144,6 +144,12 @@ void Assembler::slt(const Register &result_reg, const Register &op1_reg, const R
                static_cast<std::string>(op1_reg) + " " + static_cast<std::string>(op2_reg));
 }
 
+void Assembler::sltiu(const Register &result_reg, const Register &op_reg, const int32_t &imm)
+{
+    _code.save(std::string(_ident, ' ') + "sltiu\t" + static_cast<std::string>(result_reg) + " " +
+               static_cast<std::string>(op_reg) + " " + std::to_string(imm));
+}
+
 void Assembler::ble(const Register &op1_reg, const Register &op2_reg, const Label &label)
 {
     _code.save(std::string(_ident, ' ') + "ble\t\t" + static_cast<std::string>(op1_reg) + " " +
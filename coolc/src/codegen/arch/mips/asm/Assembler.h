@@ -472,6 +472,15 @@ class Assembler
      */
     void slt(const Register &result_reg, const Register &op1_reg, const Register &op2_reg);
 
+    /**
+     * @brief Check if unsigned operand is lesser than value
+     *
+     * @param result_reg Destination register
+     * @param op_reg Operand register
+     * @param imm Operand value
+     */
+    void sltiu(const Register &result_reg, const Register &op_reg, const int32_t &imm);
+
     /**
      * @brief Shift left logical
      *
@@ -19,11 +19,21 @@ CodeGenMips::CodeGenMips(const std::shared_ptr<semant::ClassNode> &root)
     __ text_section();
 
     // we export some structures and method to global
-    __ global(Label(_builder->klass(MainClassName)->init_method()));
-    __ global(Label(_builder->klass(BaseClassesNames[BaseClasses::INT])->init_method()));
-    __ global(Label(_builder->klass(BaseClassesNames[BaseClasses::STRING])->init_method()));
-    __ global(Label(_builder->klass(BaseClassesNames[BaseClasses::BOOL])->init_method()));
-    __ global(Label(_builder->klass(MainClassName)->method_full_name(MainMethodName)));
+    __ global(Label(_builder->klass(::Symbol(MainClassName))->init_method()));
+    __ global(Label(_builder->klass(::Symbol(BaseClassesNames[BaseClasses::INT]))->init_method()));
+    __ global(Label(_builder->klass(::Symbol(BaseClassesNames[BaseClasses::STRING]))->init_method()));
+    __ global(Label(_builder->klass(::Symbol(BaseClassesNames[BaseClasses::BOOL]))->init_method()));
+    __ global(Label(_builder->klass(::Symbol(MainClassName))->method_full_name(MainMethodName)));
+
+    // methods of basic classes are external symbols. Register them before direct calls of user classes reference them
+    for (auto i = static_cast<int>(BaseClasses::OBJECT); i < BaseClasses::SELF_TYPE; i++)
+    {
+        const auto &klass = _builder->klass(::Symbol(BaseClassesNames[i]));
+        for (auto method = klass->methods_begin(); method != klass->methods_end(); method++)
+        {
+            Label(klass->method_full_name(method->second->_object->_object), Label::ALLOW_NO_BIND);
+        }
+    }
 }
 
 void CodeGenMips::emit(const std::string &out_file_name)
@@ -54,151 +64,223 @@ void CodeGenMips::add_fields()
     }
 }
 
-void CodeGenMips::emit_binary_expr_inner(const ast::BinaryExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+void CodeGenMips::emit_binary_expr_inner(const ast::BinaryExpression &expr, ast::Type *expr_type)
 {
+    if (is_native_binary(expr))
+    {
+        emit_native_binary(expr);
+        emit_box(expr_type);
+        return;
+    }
+
+    // equality of objects
     emit_expr(expr._lhs);
     // we hope to see the first argument in acc
     __ push(_a0);
     emit_expr(expr._rhs);
 
-    auto logical_result = false;
     const Register t1(Register::$t1); // allocate new temp reg
     const Register t2(Register::$t2);
-    const Register t5(Register::$t5);
 
-    // rhs in acc, load lhs to t0
+    // rhs in acc, load lhs to t1
     __ pop(t1);
-    // for arith operations create copy of the rhs for result
     __ move(t2, _a0);
-    // operand are in t2 and t1, use t5 for result
-    if (!std::holds_alternative<ast::EqExpression>(expr._base))
-    {
-        emit_load_int(t2, t2); // load real values
-        emit_load_int(t1, t1);
 
-        std::visit(ast::overloaded{[&](const ast::MinusExpression &minus) { __ sub(t5, t1, t2); },
-                                   [&](const ast::PlusExpression &plus) { __ add(t5, t1, t2); },
-                                   [&](const ast::DivExpression &div) { __ div(t5, t1, t2); },
-                                   [&](const ast::MulExpression &mul) { __ mul(t5, t1, t2); },
-                                   [&](const ast::LTExpression &lt) {
-                                       // trait it as arith result
-                                       __ slt(t5, t1, t2);
-                                       __ la(_a0, _data.bool_const(false));
-                                   },
-                                   [&](const ast::LEExpression &le) {
-                                       logical_result = true;
-
-                                       const Label true_label(Names::name(Names::Comment::TRUE_BRANCH));
-                                       const Label end_label(Names::name(Names::Comment::MERGE_BLOCK));
-
-                                       __ ble(t1, t2, true_label);          // t1 < a0
-                                       __ la(_a0, _data.bool_const(false)); // false -> a0 if false
-                                       __ j(end_label);                     // jump to end
-
-                                       {
-                                           const AssemblerMarkSection mark(_asm, true_label); // true path
-                                           __ la(_a0, _data.bool_const(true));
-                                       }
-
-                                       const AssemblerMarkSection mark(_asm, end_label); // jump here to continue
-                                   },
-                                   [&](const ast::EqExpression &le) {}},
-                   expr._base);
-    }
-    else
-    {
-        logical_result = true;
+    const Label equal_refs_label(Names::name(Names::Comment::TRUE_BRANCH));
+    const Label equal_primitive_vals_label(Names::name(Names::Comment::TRUE_BRANCH));
+    const Label equal_end_label(Names::name(Names::Comment::MERGE_BLOCK));
 
-        const Label equal_refs_label(Names::name(Names::Comment::TRUE_BRANCH));
-        const Label equal_primitive_vals_label(Names::name(Names::Comment::TRUE_BRANCH));
-        const Label equal_end_label(Names::name(Names::Comment::MERGE_BLOCK));
+    const Register a1(Register::$a1);
 
-        const Register a1(Register::$a1);
+    __ beq(t2, t1, equal_refs_label); // are they the same reference?
+    // no, they dont have the same reference
+    __ la(_a0, _data.bool_const(true)); // if no, set a0 to true, a1 to false
+    __ la(a1, _data.bool_const(false));
+    __ jal(*_runtime.symbol_by_id(
+        RuntimeMips::RuntimeMipsSymbols::EQUALITY_TEST)); // in a0 expect a0 if the same and a1 if false
+    emit_load_bool(_a0, _a0);                             // real value in a0
+    __ beq(_a0, TrueValue, equal_primitive_vals_label);   // do they have same type and value?
+    // no, they dont have the same type and value
+    __ la(_a0, _data.bool_const(false)); // end of false branch
+    __ j(equal_end_label);               // jump to end
 
-        __ beq(t2, t1, equal_refs_label); // are they the same reference?
-        // no, they dont have the same reference
-        __ la(_a0, _data.bool_const(true)); // if no, set a0 to true, a1 to false
-        __ la(a1, _data.bool_const(false));
-        __ jal(*_runtime.symbol_by_id(
-            RuntimeMips::RuntimeMipsSymbols::EQUALITY_TEST)); // in a0 expect a0 if the same and a1 if false
-        emit_load_bool(_a0, _a0);                             // real value in a0
-        __ beq(_a0, TrueValue, equal_primitive_vals_label);   // do they have same type and value?
-        // no, they dont have the same type and value
-        __ la(_a0, _data.bool_const(false)); // end of false branch
-        __ j(equal_end_label);               // jump to end
+    {
+        // yes, they have the same reference
+        const AssemblerMarkSection mark(_asm, equal_refs_label);
+        __ la(_a0, _data.bool_const(true)); // end of true branch
+        __ j(equal_end_label);              // jump to end
+    }
 
-        {
-            // yes, they have the same reference
-            const AssemblerMarkSection mark(_asm, equal_refs_label);
-            __ la(_a0, _data.bool_const(true)); // end of true branch
-            __ j(equal_end_label);              // jump to end
-        }
+    {
+        // yes, they have the same type and value
+        const AssemblerMarkSection mark(_asm, equal_primitive_vals_label);
+        __ la(_a0, _data.bool_const(true));
+    }
 
-        {
-            // yes, they have the same type and value
-            const AssemblerMarkSection mark(_asm, equal_primitive_vals_label);
-            __ la(_a0, _data.bool_const(true));
-        }
+    // Bool constants are never modified, so result is the constant itself
+    const AssemblerMarkSection mark(_asm, equal_end_label); // jump here to continue
+}
 
-        const AssemblerMarkSection mark(_asm, equal_end_label); // jump here to continue
+void CodeGenMips::emit_unary_expr_inner(const ast::UnaryExpression &expr, ast::Type *expr_type)
+{
+    if (!std::holds_alternative<ast::IsVoidExpression>(expr._base))
+    {
+        emit_native_unary(expr);
+        emit_box(expr_type);
+        return;
     }
 
-    // object in a0, result in t5
-    // create object and set field
-    __ jal(*_runtime.symbol_by_id(RuntimeMips::RuntimeMipsSymbols::OBJECT_COPY));
-    // result in a0
-    if (!logical_result)
+    emit_expr(expr._expr);
+
+    const Label its_void_label(Names::name(Names::Comment::TRUE_BRANCH));
+    const Label end_label_label(Names::name(Names::Comment::MERGE_BLOCK));
+
+    __ beq(_a0, __ zero(), its_void_label);
+    // false branch
+    __ la(_a0, _data.bool_const(false)); // end of false branch
+    __ j(end_label_label);               // jump to end
+    // true branch
     {
-        emit_store_int(_a0, t5);
+        const AssemblerMarkSection mark(_asm, its_void_label);
+        __ la(_a0, _data.bool_const(true)); // end of true branch
     }
+
+    const AssemblerMarkSection mark(_asm, end_label_label);
 }
 
-void CodeGenMips::emit_unary_expr_inner(const ast::UnaryExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+bool CodeGenMips::is_native_binary(const ast::BinaryExpression &expr)
 {
-    emit_expr(expr._expr);
-
-    auto logical_result = false;
-    // result in acc
-    const Register t5(Register::$t5);
-    std::visit(ast::overloaded{[&](const ast::IsVoidExpression &isvoid) {
-                                   logical_result = true;
+    // equality of other classes compares objects
+    return !std::holds_alternative<ast::EqExpression>(expr._base) || semant::Semant::is_int(expr._lhs->_type) ||
+           semant::Semant::is_bool(expr._lhs->_type);
+}
 
-                                   const Label its_void_label(Names::name(Names::Comment::TRUE_BRANCH));
-                                   const Label end_label_label(Names::name(Names::Comment::MERGE_BLOCK));
+bool CodeGenMips::is_call_free(ast::Expression *expr)
+{
+    return std::visit(
+        ast::overloaded{[&](const ast::IntExpression &) { return true; },
+                        [&](const ast::BoolExpression &) { return true; },
+                        [&](const ast::ObjectExpression &) { return true; },
+                        [&](const ast::BinaryExpression &binary) {
+                            return is_native_binary(binary) && is_call_free(binary._lhs) && is_call_free(binary._rhs);
+                        },
+                        [&](const ast::UnaryExpression &unary) {
+                            return !std::holds_alternative<ast::IsVoidExpression>(unary._base) &&
+                                   is_call_free(unary._expr);
+                        },
+                        [&](const auto &) { return false; }},
+        expr->_data);
+}
 
-                                   __ beq(_a0, __ zero(), its_void_label);
-                                   // false branch
-                                   __ la(_a0, _data.bool_const(false)); // end of false branch
-                                   __ j(end_label_label);               // jump to end
-                                   // true branch
+void CodeGenMips::emit_native(ast::Expression *expr)
+{
+    std::visit(ast::overloaded{[&](const ast::IntExpression &integer) { __ li(_a0, integer._value); },
+                               [&](const ast::BoolExpression &boolean) {
+                                   __ li(_a0, boolean._value ? TrueValue : FalseValue);
+                               },
+                               [&](const ast::BinaryExpression &binary) {
+                                   if (is_native_binary(binary))
                                    {
-                                       const AssemblerMarkSection mark(_asm, its_void_label);
-                                       __ la(_a0, _data.bool_const(true)); // end of true branch
+                                       emit_native_binary(binary);
+                                       return;
                                    }
-
-                                   const AssemblerMarkSection mark(_asm, end_label_label);
+                                   emit_expr(expr);
+                                   emit_load_bool(_a0, _a0);
                                },
-                               [&](const ast::NotExpression &) {
-                                   // trait it as arith result
-                                   __ move(t5, _a0);
-                                   emit_load_bool(t5, t5);
-                                   __ xori(t5, t5, TrueValue);
-                                   __ la(_a0, _data.bool_const(false));
+                               [&](const ast::UnaryExpression &unary) {
+                                   if (!std::holds_alternative<ast::IsVoidExpression>(unary._base))
+                                   {
+                                       emit_native_unary(unary);
+                                       return;
+                                   }
+                                   emit_expr(expr);
+                                   emit_load_bool(_a0, _a0);
                                },
-                               [&](const ast::NegExpression &neg) {
-                                   __ move(t5, _a0);
-                                   emit_load_int(t5, t5);
-                                   __ sub(t5, __ zero(), t5);
+                               [&](const auto &) {
+                                   // value of the object
+                                   emit_expr(expr);
+                                   emit_load_int(_a0, _a0);
+                               }},
+               expr->_data);
+}
+
+void CodeGenMips::emit_native_binary(const ast::BinaryExpression &expr)
+{
+    const auto native_lhs = is_call_free(expr._rhs);
+    if (native_lhs)
+    {
+        emit_native(expr._lhs);
+    }
+    else
+    {
+        // rhs can trigger GC, so keep the object of lhs on the stack
+        emit_expr(expr._lhs);
+    }
+    __ push(_a0);
+    emit_native(expr._rhs);
+
+    // rhs in acc, lhs in t1
+    const Register t1(Register::$t1);
+    __ pop(t1);
+    if (!native_lhs)
+    {
+        emit_load_int(t1, t1);
+    }
+
+    std::visit(ast::overloaded{[&](const ast::MinusExpression &minus) { __ sub(_a0, t1, _a0); },
+                               [&](const ast::PlusExpression &plus) { __ add(_a0, t1, _a0); },
+                               [&](const ast::DivExpression &div) { __ div(_a0, t1, _a0); },
+                               [&](const ast::MulExpression &mul) { __ mul(_a0, t1, _a0); },
+                               [&](const ast::LTExpression &lt) { __ slt(_a0, t1, _a0); },
+                               [&](const ast::LEExpression &le) {
+                                   // lhs <= rhs is not rhs < lhs
+                                   __ slt(_a0, _a0, t1);
+                                   __ xori(_a0, _a0, TrueValue);
+                               },
+                               [&](const ast::EqExpression &eq) {
+                                   __ xorr(_a0, t1, _a0);
+                                   __ sltiu(_a0, _a0, 1);
                                }},
                expr._base);
-    // object in a0, result in t5
-    // create object and set field
-    __ jal(*_runtime.symbol_by_id(RuntimeMips::RuntimeMipsSymbols::OBJECT_COPY));
-    // result in a0
-    if (!logical_result)
+}
+
+void CodeGenMips::emit_native_unary(const ast::UnaryExpression &expr)
+{
+    emit_native(expr._expr);
+
+    std::visit(ast::overloaded{[&](const ast::NotExpression &) { __ xori(_a0, _a0, TrueValue); },
+                               [&](const ast::NegExpression &neg) { __ sub(_a0, __ zero(), _a0); },
+                               [&](const ast::IsVoidExpression &isvoid) {}},
+               expr._base);
+}
+
+void CodeGenMips::emit_box(ast::Type *type)
+{
+    if (semant::Semant::is_bool(type))
     {
-        emit_store_int(_a0, t5);
+        // Bool constants are never modified, so select one of them
+        const Label false_label(Names::name(Names::Comment::FALSE_BRANCH));
+        const Label end_label(Names::name(Names::Comment::MERGE_BLOCK));
+
+        __ beq(_a0, FalseValue, false_label);
+        __ la(_a0, _data.bool_const(true));
+        __ j(end_label);
+
+        {
+            const AssemblerMarkSection mark(_asm, false_label);
+            __ la(_a0, _data.bool_const(false));
+        }
+
+        const AssemblerMarkSection mark(_asm, end_label);
+        return;
     }
+
+    const Register t5(Register::$t5);
+    __ move(t5, _a0);
+    // create object and set field
+    __ la(_a0, _data.int_const(0));
+    __ jal(*_runtime.symbol_by_id(RuntimeMips::RuntimeMipsSymbols::OBJECT_COPY));
+    emit_store_int(_a0, t5);
 }
 
 void CodeGenMips::emit_method_prologue()
@@ -256,15 +338,14 @@ void CodeGenMips::emit_class_init_method_inner()
     emit_method_epilogue(0);
 }
 
-void CodeGenMips::emit_class_method_inner(const std::shared_ptr<ast::Feature> &method)
+void CodeGenMips::emit_class_method_inner(ast::Feature *method)
 {
     const auto &class_name = _current_class->_type->_string;
     const auto &method_name = method->_object->_object;
 
-    // it is dummies for basic classes. There are external symbols
+    // it is dummies for basic classes. There are external symbols, see constructor
     if (semant::Semant::is_basic_type(_current_class->_type))
     {
-        Label(_builder->klass(class_name)->method_full_name(method_name), Label::ALLOW_NO_BIND);
         return;
     }
 
@@ -290,22 +371,22 @@ void CodeGenMips::emit_class_method_inner(const std::shared_ptr<ast::Feature> &m
     emit_method_epilogue(params_num);
 }
 
-void CodeGenMips::emit_bool_expr(const ast::BoolExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+void CodeGenMips::emit_bool_expr(const ast::BoolExpression &expr, ast::Type *expr_type)
 {
     __ la(_a0, _data.bool_const(expr._value));
 }
 
-void CodeGenMips::emit_int_expr(const ast::IntExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+void CodeGenMips::emit_int_expr(const ast::IntExpression &expr, ast::Type *expr_type)
 {
     __ la(_a0, _data.int_const(expr._value));
 }
 
-void CodeGenMips::emit_string_expr(const ast::StringExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+void CodeGenMips::emit_string_expr(const ast::StringExpression &expr, ast::Type *expr_type)
 {
     __ la(_a0, _data.string_const(expr._string));
 }
 
-void CodeGenMips::emit_object_expr_inner(const ast::ObjectExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+void CodeGenMips::emit_object_expr_inner(const ast::ObjectExpression &expr, ast::Type *expr_type)
 {
     if (!semant::Scope::can_assign(expr._object))
     {
@@ -324,7 +405,7 @@ void CodeGenMips::emit_object_expr_inner(const ast::ObjectExpression &expr, cons
     }
 }
 
-void CodeGenMips::emit_new_expr_inner(const ast::NewExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+void CodeGenMips::emit_new_expr_inner(const ast::NewExpression &expr, ast::Type *expr_type)
 {
     // we know the type
     if (!semant::Semant::is_self_type(expr._type))
@@ -354,9 +435,8 @@ void CodeGenMips::emit_new_expr_inner(const ast::NewExpression &expr, const std:
     }
 }
 
-void CodeGenMips::emit_in_scope(const std::shared_ptr<ast::ObjectExpression> &object,
-                                const std::shared_ptr<ast::Type> &object_type,
-                                const std::shared_ptr<ast::Expression> &expr, const bool &assign_acc)
+void CodeGenMips::emit_in_scope(ast::ObjectExpression *object, ast::Type *object_type, ast::Expression *expr,
+                                const bool &assign_acc)
 {
     _table.push_scope();
 
@@ -386,7 +466,7 @@ void CodeGenMips::emit_in_scope(const std::shared_ptr<ast::ObjectExpression> &ob
     __ pop(); // delete slot
 }
 
-void CodeGenMips::emit_cases_expr_inner(const ast::CaseExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+void CodeGenMips::emit_cases_expr_inner(const ast::CaseExpression &expr, ast::Type *expr_type)
 {
     emit_expr(expr._expr);
 
@@ -406,7 +486,7 @@ void CodeGenMips::emit_cases_expr_inner(const ast::CaseExpression &expr, const s
     }
 
     // we want to generate code for the the most precise cases first, so sort cases by tag
-    auto cases = expr._cases;
+    std::vector<ast::Case *> cases(expr._cases.begin(), expr._cases.end());
     std::sort(cases.begin(), cases.end(), [&](const auto &case_a, const auto &case_b) {
         return _builder->tag(case_b->_type->_string) < _builder->tag(case_a->_type->_string);
     });
@@ -448,7 +528,7 @@ void CodeGenMips::emit_cases_expr_inner(const ast::CaseExpression &expr, const s
     const AssemblerMarkSection mark(_asm, continue_label);
 }
 
-void CodeGenMips::emit_let_expr_inner(const ast::LetExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+void CodeGenMips::emit_let_expr_inner(const ast::LetExpression &expr, ast::Type *expr_type)
 {
     if (expr._expr)
     {
@@ -458,13 +538,13 @@ void CodeGenMips::emit_let_expr_inner(const ast::LetExpression &expr, const std:
     emit_in_scope(expr._object, expr._type, expr._body_expr, expr._expr != nullptr);
 }
 
-void CodeGenMips::emit_branch_to_label_if_false(const Label &label)
+void CodeGenMips::emit_branch_to_label_if_false(ast::Expression *predicate, const Label &label)
 {
-    emit_load_bool(_a0, _a0);
+    emit_native(predicate);
     __ beq(_a0, FalseValue, label);
 }
 
-void CodeGenMips::emit_loop_expr_inner(const ast::WhileExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+void CodeGenMips::emit_loop_expr_inner(const ast::WhileExpression &expr, ast::Type *expr_type)
 {
     const Label loop_header_label(Names::name(Names::Comment::LOOP_HEADER));
     const Label loop_tail_label(Names::name(Names::Comment::LOOP_TAIL));
@@ -472,8 +552,7 @@ void CodeGenMips::emit_loop_expr_inner(const ast::WhileExpression &expr, const s
     {
         const AssemblerMarkSection mark(_asm, loop_header_label);
 
-        emit_expr(expr._predicate); // result in acc
-        emit_branch_to_label_if_false(loop_tail_label);
+        emit_branch_to_label_if_false(expr._predicate, loop_tail_label);
         // loop body
         emit_expr(expr._body_expr);
         __ j(loop_header_label); // go to loop start
@@ -482,13 +561,12 @@ void CodeGenMips::emit_loop_expr_inner(const ast::WhileExpression &expr, const s
     const AssemblerMarkSection mark(_asm, loop_tail_label); // continue
 }
 
-void CodeGenMips::emit_if_expr_inner(const ast::IfExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+void CodeGenMips::emit_if_expr_inner(const ast::IfExpression &expr, ast::Type *expr_type)
 {
     const Label false_branch_label(Names::name(Names::Comment::FALSE_BRANCH));
     const Label continue_label(Names::name(Names::Comment::MERGE_BLOCK));
 
-    emit_expr(expr._predicate); // result in acc
-    emit_branch_to_label_if_false(false_branch_label);
+    emit_branch_to_label_if_false(expr._predicate, false_branch_label);
     // true branch
     emit_expr(expr._true_path_expr);
     __ j(continue_label); // continue execution
@@ -503,8 +581,7 @@ void CodeGenMips::emit_if_expr_inner(const ast::IfExpression &expr, const std::s
     const AssemblerMarkSection mark(_asm, continue_label);
 }
 
-void CodeGenMips::emit_dispatch_expr_inner(const ast::DispatchExpression &expr,
-                                           const std::shared_ptr<ast::Type> &expr_type)
+void CodeGenMips::emit_dispatch_expr_inner(const ast::DispatchExpression &expr, ast::Type *expr_type)
 {
     // put all args on stack. Callee have to get rid of them
     const auto args_num = expr._args.size();
@@ -523,10 +600,34 @@ void CodeGenMips::emit_dispatch_expr_inner(const ast::DispatchExpression &expr,
     __ beq(_a0, __ zero(), dispatch_to_void_label);
 
     const auto &method_name = expr._object->_object;
+    const Label continue_label(Names::name(Names::Comment::MERGE_BLOCK));
     // not void
     std::visit(
         ast::overloaded{
             [&](const ast::VirtualDispatchExpression &disp) {
+                if (expr._direct)
+                {
+                    // the only possible implementation
+                    __ jal(Label(_builder->klass(expr._direct->_string)->method_full_name(method_name)));
+                    return;
+                }
+
+                if (expr._likely)
+                {
+                    // guess the class of the receiver: if its tag is in the subtree of the likely class, call the
+                    // implementation directly
+                    const auto &likely = _builder->klass(expr._likely->_string);
+                    const Label miss_label(Names::name(Names::Comment::FALSE_BRANCH));
+
+                    __ lw(t1, _a0, 0); // load tag
+                    __ blt(t1, likely->tag(), miss_label);
+                    __ bgt(t1, likely->child_max_tag(), miss_label);
+                    __ jal(Label(likely->method_full_name(method_name)));
+                    __ j(continue_label);
+
+                    const AssemblerMarkSection mark(_asm, miss_label); // table dispatch
+                }
+
                 __ lw(t1, _a0, DISPATCH_TABLE_OFFSET); // load dispatch table
                 __ lw(t1, t1,
                       _builder->klass(semant::Semant::exact_type(expr._expr->_type, _current_class->_type)->_string)
@@ -539,7 +640,6 @@ void CodeGenMips::emit_dispatch_expr_inner(const ast::DispatchExpression &expr,
                 __ jal(Label(_builder->klass(disp._type->_string)->method_full_name(method_name)));
             }},
         expr._base);
-    const Label continue_label(Names::name(Names::Comment::MERGE_BLOCK));
     __ j(continue_label);
 
     // void
@@ -553,7 +653,7 @@ void CodeGenMips::emit_dispatch_expr_inner(const ast::DispatchExpression &expr,
     const AssemblerMarkSection mark(_asm, continue_label);
 }
 
-void CodeGenMips::emit_assign_expr_inner(const ast::AssignExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+void CodeGenMips::emit_assign_expr_inner(const ast::AssignExpression &expr, ast::Type *expr_type)
 {
     emit_expr(expr._expr); // result in acc
     const auto &symbol = _table.symbol(expr._object->_object);
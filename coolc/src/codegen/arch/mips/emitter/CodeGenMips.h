@@ -48,36 +48,31 @@ class CodeGenMips : public CodeGen<void, Symbol>
     void emit_method_prologue();
     void emit_method_epilogue(const int &params_num);
 
-    void emit_class_method_inner(const std::shared_ptr<ast::Feature> &method) override;
+    void emit_class_method_inner(ast::Feature *method) override;
     void emit_class_init_method_inner() override;
 
-    void emit_binary_expr_inner(const ast::BinaryExpression &expr,
-                                const std::shared_ptr<ast::Type> &expr_type) override;
-    void emit_unary_expr_inner(const ast::UnaryExpression &expr, const std::shared_ptr<ast::Type> &expr_type) override;
-    void emit_bool_expr(const ast::BoolExpression &expr, const std::shared_ptr<ast::Type> &expr_type) override;
-    void emit_int_expr(const ast::IntExpression &expr, const std::shared_ptr<ast::Type> &expr_type) override;
-    void emit_string_expr(const ast::StringExpression &expr, const std::shared_ptr<ast::Type> &expr_type) override;
-    void emit_object_expr_inner(const ast::ObjectExpression &expr,
-                                const std::shared_ptr<ast::Type> &expr_type) override;
-    void emit_new_expr_inner(const ast::NewExpression &expr, const std::shared_ptr<ast::Type> &expr_type) override;
+    void emit_binary_expr_inner(const ast::BinaryExpression &expr, ast::Type *expr_type) override;
+    void emit_unary_expr_inner(const ast::UnaryExpression &expr, ast::Type *expr_type) override;
+    void emit_bool_expr(const ast::BoolExpression &expr, ast::Type *expr_type) override;
+    void emit_int_expr(const ast::IntExpression &expr, ast::Type *expr_type) override;
+    void emit_string_expr(const ast::StringExpression &expr, ast::Type *expr_type) override;
+    void emit_object_expr_inner(const ast::ObjectExpression &expr, ast::Type *expr_type) override;
+    void emit_new_expr_inner(const ast::NewExpression &expr, ast::Type *expr_type) override;
 
     // allocate stack slot for object, assign acc value to it, evaluate expression, delete slot after that
-    void emit_in_scope(const std::shared_ptr<ast::ObjectExpression> &object,
-                       const std::shared_ptr<ast::Type> &object_type, const std::shared_ptr<ast::Expression> &expr,
+    void emit_in_scope(ast::ObjectExpression *object, ast::Type *object_type, ast::Expression *expr,
                        const bool &assign_acc = true);
 
-    void emit_cases_expr_inner(const ast::CaseExpression &expr, const std::shared_ptr<ast::Type> &expr_type) override;
-    void emit_let_expr_inner(const ast::LetExpression &expr, const std::shared_ptr<ast::Type> &expr_type) override;
+    void emit_cases_expr_inner(const ast::CaseExpression &expr, ast::Type *expr_type) override;
+    void emit_let_expr_inner(const ast::LetExpression &expr, ast::Type *expr_type) override;
 
-    // if bool result in acc is false - branch to label
-    void emit_branch_to_label_if_false(const Label &label);
+    // evaluate predicate and branch to label if it is false
+    void emit_branch_to_label_if_false(ast::Expression *predicate, const Label &label);
 
-    void emit_loop_expr_inner(const ast::WhileExpression &expr, const std::shared_ptr<ast::Type> &expr_type) override;
-    void emit_if_expr_inner(const ast::IfExpression &expr, const std::shared_ptr<ast::Type> &expr_type) override;
-    void emit_dispatch_expr_inner(const ast::DispatchExpression &expr,
-                                  const std::shared_ptr<ast::Type> &expr_type) override;
-    void emit_assign_expr_inner(const ast::AssignExpression &expr,
-                                const std::shared_ptr<ast::Type> &expr_type) override;
+    void emit_loop_expr_inner(const ast::WhileExpression &expr, ast::Type *expr_type) override;
+    void emit_if_expr_inner(const ast::IfExpression &expr, ast::Type *expr_type) override;
+    void emit_dispatch_expr_inner(const ast::DispatchExpression &expr, ast::Type *expr_type) override;
+    void emit_assign_expr_inner(const ast::AssignExpression &expr, ast::Type *expr_type) override;
 
     // load/store basic values
     // int
@@ -89,6 +84,16 @@ class CodeGenMips : public CodeGen<void, Symbol>
 
     void emit_gc_update(const Register &obj, const int &offset);
 
+    // native values of Int and Bool expressions in acc. GC treats stack slots as pointers, so native value can be saved
+    // on the stack only while expressions without calls are evaluated. Ignores ast::LetExpression::_unboxed for the
+    // same reason
+    static bool is_native_binary(const ast::BinaryExpression &expr);
+    static bool is_call_free(ast::Expression *expr);
+    void emit_native(ast::Expression *expr);
+    void emit_native_binary(const ast::BinaryExpression &expr);
+    void emit_native_unary(const ast::UnaryExpression &expr);
+    void emit_box(ast::Type *type); // box native value in acc
+
   public:
     /**
      * @brief Construct a new CodeGen object
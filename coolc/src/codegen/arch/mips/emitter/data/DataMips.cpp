@@ -12,7 +12,7 @@ void DataMips::string_const_inner(const std::string &str)
 
     __ word(MarkWordDefaultValue);
 
-    const auto &string_klass = _builder->klass(BaseClassesNames[BaseClasses::STRING]);
+    const auto &string_klass = _builder->klass(::Symbol(BaseClassesNames[BaseClasses::STRING]));
 
     const AssemblerMarkSection mark(_asm, _string_constants.find(str)->second);
     __ word(string_klass->tag());
@@ -31,7 +31,7 @@ void DataMips::bool_const_inner(const bool &value)
 
     __ word(MarkWordDefaultValue);
 
-    const auto &bool_klass = _builder->klass(BaseClassesNames[BaseClasses::BOOL]);
+    const auto &bool_klass = _builder->klass(::Symbol(BaseClassesNames[BaseClasses::BOOL]));
 
     const AssemblerMarkSection mark(_asm, _bool_constants.find(value)->second);
     __ word(bool_klass->tag());
@@ -46,7 +46,7 @@ void DataMips::int_const_inner(const int64_t &value)
 
     __ word(MarkWordDefaultValue);
 
-    const auto &int_klass = _builder->klass(BaseClassesNames[BaseClasses::INT]);
+    const auto &int_klass = _builder->klass(::Symbol(BaseClassesNames[BaseClasses::INT]));
 
     const AssemblerMarkSection mark(_asm, _int_constants.find(value)->second);
     __ word(int_klass->tag());
@@ -59,18 +59,30 @@ void DataMips::int_const_inner(const int64_t &value)
 // with the class tag to a String object containing the name of the class associated
 void DataMips::gen_class_name_tab()
 {
+    const auto &analysis = _builder->analysis();
+
     // declare all consts
     for (const auto &klass : _builder->klasses())
     {
-        string_const(klass->name());
+        if (analysis.is_live(klass->name()))
+        {
+            string_const(klass->name());
+        }
     }
 
     const AssemblerMarkSection mark(_asm, *_runtime.symbol_by_id(RuntimeMips::RuntimeMipsSymbols::CLASS_NAME_TAB));
 
-    // gather to table
+    // gather to table. Runtime looks up names only for tags of objects, so classes without instances have no names
     for (const auto &klass : _builder->klasses())
     {
-        __ word(string_const(klass->name()));
+        if (analysis.is_live(klass->name()))
+        {
+            __ word(string_const(klass->name()));
+        }
+        else
+        {
+            __ word(DefaultValue);
+        }
     }
 }
 
@@ -83,8 +95,16 @@ void DataMips::gen_class_obj_tab()
 
     for (const auto &klass : _builder->klasses())
     {
-        __ word(Label(klass->prototype()));
-        __ word(Label(klass->init_method()));
+        if (_builder->analysis().is_live(klass->name()))
+        {
+            __ word(Label(klass->prototype()));
+            __ word(Label(klass->init_method()));
+        }
+        else
+        {
+            __ word(DefaultValue);
+            __ word(DefaultValue);
+        }
     }
 }
 
@@ -93,17 +113,24 @@ void DataMips::gen_prototypes()
     int_const(DefaultValue);
     string_const("");
 
-    for (const auto &klass_iter : *_builder)
+    // in the order of tags, so the output does not depend on the order of the symbols in the hash table
+    for (const auto &klass : _builder->klasses())
     {
-        class_struct(klass_iter.second);
+        if (_builder->analysis().is_live(klass->name()))
+        {
+            class_struct(klass);
+        }
     }
 }
 
 void DataMips::gen_dispatch_tabs()
 {
-    for (const auto &klass_iter : *_builder)
+    for (const auto &klass : _builder->klasses())
     {
-        class_disp_tab(klass_iter.second);
+        if (_builder->analysis().is_live(klass->name()))
+        {
+            class_disp_tab(klass);
+        }
     }
 }
 
@@ -118,9 +145,9 @@ DataMips::DataMips(const std::shared_ptr<KlassBuilder> &builder, const RuntimeMi
     __ align(2);
 
     __ global(*_runtime.symbol_by_id(RuntimeMips::RuntimeMipsSymbols::CLASS_NAME_TAB));
-    __ global(Label(_builder->klass(MainClassName)->prototype()));
-    __ global(Label(_builder->klass(BaseClassesNames[BaseClasses::INT])->prototype()));
-    __ global(Label(_builder->klass(BaseClassesNames[BaseClasses::STRING])->prototype()));
+    __ global(Label(_builder->klass(::Symbol(MainClassName))->prototype()));
+    __ global(Label(_builder->klass(::Symbol(BaseClassesNames[BaseClasses::INT]))->prototype()));
+    __ global(Label(_builder->klass(::Symbol(BaseClassesNames[BaseClasses::STRING]))->prototype()));
     __ global(Label(Names::bool_constant())); // false
     __ global(Label(Names::bool_constant())); // true
     __ global(int_tag);
@@ -130,17 +157,17 @@ DataMips::DataMips(const std::shared_ptr<KlassBuilder> &builder, const RuntimeMi
     // now create tags for basic types
     {
         const AssemblerMarkSection mark(_asm, int_tag);
-        __ word(_builder->tag(BaseClassesNames[BaseClasses::INT]));
+        __ word(_builder->tag(::Symbol(BaseClassesNames[BaseClasses::INT])));
     }
 
     {
         const AssemblerMarkSection mark(_asm, bool_tag);
-        __ word(_builder->tag(BaseClassesNames[BaseClasses::BOOL]));
+        __ word(_builder->tag(::Symbol(BaseClassesNames[BaseClasses::BOOL])));
     }
 
     {
         const AssemblerMarkSection mark(_asm, string_tag);
-        __ word(_builder->tag(BaseClassesNames[BaseClasses::STRING]));
+        __ word(_builder->tag(::Symbol(BaseClassesNames[BaseClasses::STRING])));
     }
 
     // Generational GC Interface
@@ -226,8 +253,16 @@ void DataMips::class_disp_tab_inner(const std::shared_ptr<Klass> &klass)
     const AssemblerMarkSection mark(_asm, _dispatch_tables.find(class_name)->second);
     const auto &mips_klass = std::static_pointer_cast<KlassMips>(klass);
 
+    // unreachable method is never called through the slot
     for (auto i = 0; i < mips_klass->methods_num(); i++)
     {
-        __ word(Label(mips_klass->method_full_name(i)));
+        if (_builder->analysis().is_reachable(mips_klass->dispatch_table()[i].second))
+        {
+            __ word(Label(mips_klass->method_full_name(i)));
+        }
+        else
+        {
+            __ word(DefaultValue);
+        }
     }
 }
\ No newline at end of file
@@ -13,13 +13,13 @@ std::string KlassMips::method_full_name(const std::string &method_name) const
 
 std::string KlassMips::method_full_name(const int &n) const
 {
-    GUARANTEE_DEBUG(n < _methods.size());
+    GUARANTEE_DEBUG(n < _dispatch_table.size());
 
-    const auto &method = _methods[n];
+    const auto &method = _dispatch_table[n];
     return Names::method_full_name(method.first->_string, method.second->_object->_object, FULL_METHOD_DELIM);
 }
 
-std::shared_ptr<Klass> KlassBuilderMips::make_klass(const std::shared_ptr<ast::Class> &klass)
+std::shared_ptr<Klass> KlassBuilderMips::make_klass(ast::Class *klass)
 {
     return klass ? std::make_shared<KlassMips>(klass, this) : std::make_shared<KlassMips>();
 }
\ No newline at end of file
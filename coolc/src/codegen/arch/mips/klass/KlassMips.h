@@ -22,7 +22,7 @@ class KlassMips : public Klass
     static constexpr std::string_view PROTOTYPE_NAME_SUFFIX = "_protObj";
     static constexpr std::string_view DISP_TAB_NAME_SUFFIX = "_dispTab";
 
-    KlassMips(const std::shared_ptr<ast::Class> &klass, const KlassBuilder *builder) : Klass(klass, builder)
+    KlassMips(ast::Class *klass, const KlassBuilder *builder) : Klass(klass, builder)
     {
     }
 
@@ -44,19 +44,19 @@ class KlassMips : public Klass
     }
 
     /**
-     * @brief Number of methods
+     * @brief Number of methods in the dispatch table
      *
      * @return Number of methods
      */
     inline size_t methods_num() const
     {
-        return _methods.size();
+        return _dispatch_table.size();
     }
 
     /**
      * @brief Construct full name of the method for this Class
      *
-     * @param n Method's number
+     * @param n Method's slot in the dispatch table
      * @return Full name of the method
      */
     std::string method_full_name(const int &n) const;
@@ -80,7 +80,7 @@ class KlassMips : public Klass
 class KlassBuilderMips : public KlassBuilder
 {
   private:
-    std::shared_ptr<Klass> make_klass(const std::shared_ptr<ast::Class> &klass) override;
+    std::shared_ptr<Klass> make_klass(ast::Class *klass) override;
 
   public:
     explicit KlassBuilderMips(const std::shared_ptr<semant::ClassNode> &root) : KlassBuilder(root)
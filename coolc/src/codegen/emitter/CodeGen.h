@@ -14,7 +14,7 @@ template <class Value, class Symbol> class CodeGen
 {
   protected:
     // current generating class
-    std::shared_ptr<ast::Class> _current_class;
+    ast::Class *_current_class;
 
     // symbol table
     SymbolTable<Symbol> _table;
@@ -29,57 +29,50 @@ template <class Value, class Symbol> class CodeGen
     virtual void add_fields() = 0;
 
     // methods of class
-    void emit_class_method(const std::shared_ptr<ast::Feature> &method);
-    virtual void emit_class_method_inner(const std::shared_ptr<ast::Feature> &method) = 0;
+    void emit_class_method(ast::Feature *method);
+    virtual void emit_class_method_inner(ast::Feature *method) = 0;
 
     void emit_class_init_method();
     virtual void emit_class_init_method_inner() = 0;
 
     // emit expressions
-    Value emit_expr(const std::shared_ptr<ast::Expression> &expr);
+    Value emit_expr(ast::Expression *expr);
 
-    Value emit_binary_expr(const ast::BinaryExpression &expr, const std::shared_ptr<ast::Type> &expr_type);
-    virtual Value emit_binary_expr_inner(const ast::BinaryExpression &expr,
-                                         const std::shared_ptr<ast::Type> &expr_type) = 0;
+    Value emit_binary_expr(const ast::BinaryExpression &expr, ast::Type *expr_type);
+    virtual Value emit_binary_expr_inner(const ast::BinaryExpression &expr, ast::Type *expr_type) = 0;
 
-    Value emit_unary_expr(const ast::UnaryExpression &expr, const std::shared_ptr<ast::Type> &expr_type);
-    virtual Value emit_unary_expr_inner(const ast::UnaryExpression &expr,
-                                        const std::shared_ptr<ast::Type> &expr_type) = 0;
+    Value emit_unary_expr(const ast::UnaryExpression &expr, ast::Type *expr_type);
+    virtual Value emit_unary_expr_inner(const ast::UnaryExpression &expr, ast::Type *expr_type) = 0;
 
-    virtual Value emit_bool_expr(const ast::BoolExpression &expr, const std::shared_ptr<ast::Type> &expr_type) = 0;
-    virtual Value emit_int_expr(const ast::IntExpression &expr, const std::shared_ptr<ast::Type> &expr_type) = 0;
-    virtual Value emit_string_expr(const ast::StringExpression &expr, const std::shared_ptr<ast::Type> &expr_type) = 0;
+    virtual Value emit_bool_expr(const ast::BoolExpression &expr, ast::Type *expr_type) = 0;
+    virtual Value emit_int_expr(const ast::IntExpression &expr, ast::Type *expr_type) = 0;
+    virtual Value emit_string_expr(const ast::StringExpression &expr, ast::Type *expr_type) = 0;
 
-    Value emit_object_expr(const ast::ObjectExpression &expr, const std::shared_ptr<ast::Type> &expr_type);
-    virtual Value emit_object_expr_inner(const ast::ObjectExpression &expr,
-                                         const std::shared_ptr<ast::Type> &expr_type) = 0;
+    Value emit_object_expr(const ast::ObjectExpression &expr, ast::Type *expr_type);
+    virtual Value emit_object_expr_inner(const ast::ObjectExpression &expr, ast::Type *expr_type) = 0;
 
-    Value emit_new_expr(const ast::NewExpression &expr, const std::shared_ptr<ast::Type> &expr_type);
-    virtual Value emit_new_expr_inner(const ast::NewExpression &expr, const std::shared_ptr<ast::Type> &expr_type) = 0;
+    Value emit_new_expr(const ast::NewExpression &expr, ast::Type *expr_type);
+    virtual Value emit_new_expr_inner(const ast::NewExpression &expr, ast::Type *expr_type) = 0;
 
-    Value emit_cases_expr(const ast::CaseExpression &expr, const std::shared_ptr<ast::Type> &expr_type);
-    virtual Value emit_cases_expr_inner(const ast::CaseExpression &expr,
-                                        const std::shared_ptr<ast::Type> &expr_type) = 0;
+    Value emit_cases_expr(const ast::CaseExpression &expr, ast::Type *expr_type);
+    virtual Value emit_cases_expr_inner(const ast::CaseExpression &expr, ast::Type *expr_type) = 0;
 
-    Value emit_let_expr(const ast::LetExpression &expr, const std::shared_ptr<ast::Type> &expr_type);
-    virtual Value emit_let_expr_inner(const ast::LetExpression &expr, const std::shared_ptr<ast::Type> &expr_type) = 0;
+    Value emit_let_expr(const ast::LetExpression &expr, ast::Type *expr_type);
+    virtual Value emit_let_expr_inner(const ast::LetExpression &expr, ast::Type *expr_type) = 0;
 
-    Value emit_list_expr(const ast::ListExpression &expr, const std::shared_ptr<ast::Type> &expr_type);
+    Value emit_list_expr(const ast::ListExpression &expr, ast::Type *expr_type);
 
-    Value emit_loop_expr(const ast::WhileExpression &expr, const std::shared_ptr<ast::Type> &expr_type);
-    virtual Value emit_loop_expr_inner(const ast::WhileExpression &expr,
-                                       const std::shared_ptr<ast::Type> &expr_type) = 0;
+    Value emit_loop_expr(const ast::WhileExpression &expr, ast::Type *expr_type);
+    virtual Value emit_loop_expr_inner(const ast::WhileExpression &expr, ast::Type *expr_type) = 0;
 
-    Value emit_if_expr(const ast::IfExpression &expr, const std::shared_ptr<ast::Type> &expr_type);
-    virtual Value emit_if_expr_inner(const ast::IfExpression &expr, const std::shared_ptr<ast::Type> &expr_type) = 0;
+    Value emit_if_expr(const ast::IfExpression &expr, ast::Type *expr_type);
+    virtual Value emit_if_expr_inner(const ast::IfExpression &expr, ast::Type *expr_type) = 0;
 
-    Value emit_dispatch_expr(const ast::DispatchExpression &expr, const std::shared_ptr<ast::Type> &expr_type);
-    virtual Value emit_dispatch_expr_inner(const ast::DispatchExpression &expr,
-                                           const std::shared_ptr<ast::Type> &expr_type) = 0;
+    Value emit_dispatch_expr(const ast::DispatchExpression &expr, ast::Type *expr_type);
+    virtual Value emit_dispatch_expr_inner(const ast::DispatchExpression &expr, ast::Type *expr_type) = 0;
 
-    Value emit_assign_expr(const ast::AssignExpression &expr, const std::shared_ptr<ast::Type> &expr_type);
-    virtual Value emit_assign_expr_inner(const ast::AssignExpression &expr,
-                                         const std::shared_ptr<ast::Type> &expr_type) = 0;
+    Value emit_assign_expr(const ast::AssignExpression &expr, ast::Type *expr_type);
+    virtual Value emit_assign_expr_inner(const ast::AssignExpression &expr, ast::Type *expr_type) = 0;
 
   public:
     /**
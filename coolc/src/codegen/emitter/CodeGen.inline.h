@@ -19,7 +19,8 @@ using namespace codegen;
     }
 
 template <class Value, class Symbol>
-CodeGen<Value, Symbol>::CodeGen(const std::shared_ptr<KlassBuilder> &builder) : _builder(builder)
+CodeGen<Value, Symbol>::CodeGen(const std::shared_ptr<KlassBuilder> &builder)
+    : _current_class(nullptr), _builder(builder)
 {
 }
 
@@ -33,11 +34,16 @@ void CodeGen<Value, Symbol>::emit_class_code(const std::shared_ptr<semant::Class
     _table.push_scope();
     add_fields();
 
-    // emit methods
-    emit_class_init_method();
+    // emit methods. Class without instances in its subtree needs no init method, but its reachable methods can be
+    // called by static dispatch
+    const auto &analysis = _builder->analysis();
+    if (analysis.is_live(_current_class->_type->_string))
+    {
+        emit_class_init_method();
+    }
     for (const auto &feature : _current_class->_features)
     {
-        if (std::holds_alternative<ast::MethodFeature>(feature->_base))
+        if (std::holds_alternative<ast::MethodFeature>(feature->_base) && analysis.is_reachable(feature))
         {
             emit_class_method(feature);
         }
@@ -56,8 +62,7 @@ void CodeGen<Value, Symbol>::emit_class_code(const std::shared_ptr<semant::Class
 }
 
 template <class Value, class Symbol>
-Value CodeGen<Value, Symbol>::emit_binary_expr(const ast::BinaryExpression &expr,
-                                               const std::shared_ptr<ast::Type> &expr_type)
+Value CodeGen<Value, Symbol>::emit_binary_expr(const ast::BinaryExpression &expr, ast::Type *expr_type)
 {
     CODEGEN_VERBOSE_ONLY(LOG_ENTER("GEN BINARY EXPR"));
 
@@ -65,8 +70,7 @@ Value CodeGen<Value, Symbol>::emit_binary_expr(const ast::BinaryExpression &expr
 }
 
 template <class Value, class Symbol>
-Value CodeGen<Value, Symbol>::emit_unary_expr(const ast::UnaryExpression &expr,
-                                              const std::shared_ptr<ast::Type> &expr_type)
+Value CodeGen<Value, Symbol>::emit_unary_expr(const ast::UnaryExpression &expr, ast::Type *expr_type)
 {
     CODEGEN_VERBOSE_ONLY(LOG_ENTER("GEN UNAXRY EXPR"));
 
@@ -74,7 +78,7 @@ Value CodeGen<Value, Symbol>::emit_unary_expr(const ast::UnaryExpression &expr,
 }
 
 template <class Value, class Symbol>
-Value CodeGen<Value, Symbol>::emit_expr(const std::shared_ptr<ast::Expression> &expr)
+Value CodeGen<Value, Symbol>::emit_expr(ast::Expression *expr)
 {
     return std::visit(
         ast::overloaded{
@@ -105,7 +109,7 @@ template <class Value, class Symbol> void CodeGen<Value, Symbol>::emit_class_ini
 }
 
 template <class Value, class Symbol>
-void CodeGen<Value, Symbol>::emit_class_method(const std::shared_ptr<ast::Feature> &method)
+void CodeGen<Value, Symbol>::emit_class_method(ast::Feature *method)
 {
     CODEGEN_VERBOSE_ONLY(LOG_ENTER("GEN METHOD \"" + method->_object->_object + "\""));
 
@@ -115,8 +119,7 @@ void CodeGen<Value, Symbol>::emit_class_method(const std::shared_ptr<ast::Featur
 }
 
 template <class Value, class Symbol>
-Value CodeGen<Value, Symbol>::emit_object_expr(const ast::ObjectExpression &expr,
-                                               const std::shared_ptr<ast::Type> &expr_type)
+Value CodeGen<Value, Symbol>::emit_object_expr(const ast::ObjectExpression &expr, ast::Type *expr_type)
 {
     CODEGEN_VERBOSE_ONLY(LOG_ENTER("GEN OBJECT EXPR FOR \"" + expr._object + "\""));
 
@@ -124,7 +127,7 @@ Value CodeGen<Value, Symbol>::emit_object_expr(const ast::ObjectExpression &expr
 }
 
 template <class Value, class Symbol>
-Value CodeGen<Value, Symbol>::emit_new_expr(const ast::NewExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+Value CodeGen<Value, Symbol>::emit_new_expr(const ast::NewExpression &expr, ast::Type *expr_type)
 {
     CODEGEN_VERBOSE_ONLY(LOG_ENTER("GEN NEW EXPR"));
 
@@ -132,8 +135,7 @@ Value CodeGen<Value, Symbol>::emit_new_expr(const ast::NewExpression &expr, cons
 }
 
 template <class Value, class Symbol>
-Value CodeGen<Value, Symbol>::emit_cases_expr(const ast::CaseExpression &expr,
-                                              const std::shared_ptr<ast::Type> &expr_type)
+Value CodeGen<Value, Symbol>::emit_cases_expr(const ast::CaseExpression &expr, ast::Type *expr_type)
 {
     CODEGEN_VERBOSE_ONLY(LOG_ENTER("GEN CASE EXPR"));
 
@@ -141,7 +143,7 @@ Value CodeGen<Value, Symbol>::emit_cases_expr(const ast::CaseExpression &expr,
 }
 
 template <class Value, class Symbol>
-Value CodeGen<Value, Symbol>::emit_let_expr(const ast::LetExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+Value CodeGen<Value, Symbol>::emit_let_expr(const ast::LetExpression &expr, ast::Type *expr_type)
 {
     CODEGEN_VERBOSE_ONLY(LOG_ENTER("GEN LET EXPR"));
 
@@ -149,8 +151,7 @@ Value CodeGen<Value, Symbol>::emit_let_expr(const ast::LetExpression &expr, cons
 }
 
 template <class Value, class Symbol>
-Value CodeGen<Value, Symbol>::emit_list_expr(const ast::ListExpression &expr,
-                                             const std::shared_ptr<ast::Type> &expr_type)
+Value CodeGen<Value, Symbol>::emit_list_expr(const ast::ListExpression &expr, ast::Type *expr_type)
 {
     CODEGEN_VERBOSE_ONLY(LOG_ENTER("GEN LIST EXPR"));
 
@@ -177,8 +178,7 @@ Value CodeGen<Value, Symbol>::emit_list_expr(const ast::ListExpression &expr,
 }
 
 template <class Value, class Symbol>
-Value CodeGen<Value, Symbol>::emit_loop_expr(const ast::WhileExpression &expr,
-                                             const std::shared_ptr<ast::Type> &expr_type)
+Value CodeGen<Value, Symbol>::emit_loop_expr(const ast::WhileExpression &expr, ast::Type *expr_type)
 {
     CODEGEN_VERBOSE_ONLY(LOG_ENTER("GEN LOOP EXPR"));
 
@@ -186,7 +186,7 @@ Value CodeGen<Value, Symbol>::emit_loop_expr(const ast::WhileExpression &expr,
 }
 
 template <class Value, class Symbol>
-Value CodeGen<Value, Symbol>::emit_if_expr(const ast::IfExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+Value CodeGen<Value, Symbol>::emit_if_expr(const ast::IfExpression &expr, ast::Type *expr_type)
 {
     CODEGEN_VERBOSE_ONLY(LOG_ENTER("GEN IF EXPR"));
 
@@ -194,8 +194,7 @@ Value CodeGen<Value, Symbol>::emit_if_expr(const ast::IfExpression &expr, const
 }
 
 template <class Value, class Symbol>
-Value CodeGen<Value, Symbol>::emit_dispatch_expr(const ast::DispatchExpression &expr,
-                                                 const std::shared_ptr<ast::Type> &expr_type)
+Value CodeGen<Value, Symbol>::emit_dispatch_expr(const ast::DispatchExpression &expr, ast::Type *expr_type)
 {
     CODEGEN_VERBOSE_ONLY(LOG_ENTER("GEN DISPATCH EXPR"));
 
@@ -203,8 +202,7 @@ Value CodeGen<Value, Symbol>::emit_dispatch_expr(const ast::DispatchExpression &
 }
 
 template <class Value, class Symbol>
-Value CodeGen<Value, Symbol>::emit_assign_expr(const ast::AssignExpression &expr,
-                                               const std::shared_ptr<ast::Type> &expr_type)
+Value CodeGen<Value, Symbol>::emit_assign_expr(const ast::AssignExpression &expr, ast::Type *expr_type)
 {
     CODEGEN_VERBOSE_ONLY(LOG_ENTER("GEN ASSIGN EXPR"));
 
@@ -19,8 +19,8 @@ template <class Value, class ClassDesc = Value> class Data
     std::unordered_map<std::string, std::remove_cvref_t<Value>> _string_constants;
     std::unordered_map<int64_t, std::remove_cvref_t<Value>> _int_constants;
 
-    std::unordered_map<std::string, std::remove_cvref_t<ClassDesc>> _classes;
-    std::unordered_map<std::string, std::remove_cvref_t<Value>> _dispatch_tables;
+    std::unordered_map<::Symbol, std::remove_cvref_t<ClassDesc>> _classes;
+    std::unordered_map<::Symbol, std::remove_cvref_t<Value>> _dispatch_tables;
 
     virtual void string_const_inner(const std::string &str) = 0;
     virtual void bool_const_inner(const bool &value) = 0;
@@ -87,7 +87,7 @@ template <class Value, class ClassDesc = Value> class Data
      * @param type Type
      * @return Initial value
      */
-    Value init_value(const std::shared_ptr<ast::Type> &type);
+    Value init_value(ast::Type *type);
 
     /**
      * @brief Emit code to file
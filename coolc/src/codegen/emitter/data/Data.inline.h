@@ -9,7 +9,7 @@ Data<Value, ClassDesc>::Data(const std::shared_ptr<KlassBuilder> &builder) : _bu
     _builder->init();
 }
 
-template <class Value, class ClassDesc> Value Data<Value, ClassDesc>::init_value(const std::shared_ptr<ast::Type> &type)
+template <class Value, class ClassDesc> Value Data<Value, ClassDesc>::init_value(ast::Type *type)
 {
     if (semant::Semant::is_string(type))
     {
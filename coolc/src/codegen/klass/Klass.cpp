@@ -2,7 +2,7 @@
 
 using namespace codegen;
 
-Klass::Klass(const std::shared_ptr<ast::Class> &klass, const KlassBuilder *builder)
+Klass::Klass(ast::Class *klass, const KlassBuilder *builder)
     : _klass(klass->_type), _parent_klass(builder->_klasses.at(klass->_parent->_string))
 {
     _fields.insert(_fields.end(), _parent_klass->fields_begin(), _parent_klass->fields_end());
@@ -10,6 +10,10 @@ Klass::Klass(const std::shared_ptr<ast::Class> &klass, const KlassBuilder *build
 
     divide_features(klass->_features);
 
+    const auto &analysis = builder->analysis();
+    std::copy_if(_methods.begin(), _methods.end(), std::back_inserter(_dispatch_table),
+                 [&analysis](const auto &method) { return analysis.is_dispatched(method.second->_object->_object); });
+
     CODEGEN_VERBOSE_ONLY(dump_fields());
     CODEGEN_VERBOSE_ONLY(dump_methods());
 }
@@ -18,7 +22,7 @@ Klass::Klass() : _klass(nullptr), _parent_klass(nullptr)
 {
 }
 
-void Klass::divide_features(const std::vector<std::shared_ptr<ast::Feature>> &features)
+void Klass::divide_features(const std::vector<ast::Feature *> &features)
 {
     CODEGEN_VERBOSE_ONLY(LOG_ENTER("DIVIDE FEATURES."));
 
@@ -113,14 +117,17 @@ int KlassBuilder::build_klass(const std::shared_ptr<semant::ClassNode> &node, co
     return child_max_tag;
 }
 
-size_t Klass::method_index(const std::string &method_name) const
+size_t Klass::method_index(const ::Symbol &method_name) const
 {
-    return std::find_if(_methods.begin(), _methods.end(),
-                        [&method_name](const auto &method) { return method.second->_object->_object == method_name; }) -
-           _methods.begin();
+    const auto entry = std::find_if(_dispatch_table.begin(), _dispatch_table.end(), [&method_name](const auto &method) {
+        return method.second->_object->_object == method_name;
+    });
+    GUARANTEE_DEBUG(entry != _dispatch_table.end());
+
+    return entry - _dispatch_table.begin();
 }
 
-KlassBuilder::KlassBuilder(const std::shared_ptr<semant::ClassNode> &root) : _root(root)
+KlassBuilder::KlassBuilder(const std::shared_ptr<semant::ClassNode> &root) : _root(root), _analysis(root)
 {
 }
 
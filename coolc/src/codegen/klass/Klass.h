@@ -1,5 +1,6 @@
 #pragma once
 
+#include "codegen/analysis/ClassAnalysis.h"
 #include "codegen/symnames/NameConstructor.h"
 #include "semant/Semant.h"
 
@@ -17,7 +18,7 @@ class Klass
     friend class KlassBuilder;
 
   protected:
-    const std::shared_ptr<ast::Type> _klass;
+    ast::Type *const _klass;
     const std::shared_ptr<Klass> _parent_klass;
 
     // tags necessary for runtime and expressions constructions
@@ -25,10 +26,12 @@ class Klass
     int _child_max_tag;
 
     // All fields and methods of this class
-    std::vector<std::shared_ptr<ast::Feature>> _fields;
-    std::vector<std::pair<std::shared_ptr<ast::Type>, std::shared_ptr<ast::Feature>>> _methods;
+    std::vector<ast::Feature *> _fields;
+    std::vector<std::pair<ast::Type *, ast::Feature *>> _methods;
+    // Methods that are called through the dispatch table. Slots of the parent are the prefix of this table
+    std::vector<std::pair<ast::Type *, ast::Feature *>> _dispatch_table;
 
-    void divide_features(const std::vector<std::shared_ptr<ast::Feature>> &features);
+    void divide_features(const std::vector<ast::Feature *> &features);
 
     inline void set_tags(const int &klass_tag, const int &child_max_tag)
     {
@@ -47,7 +50,7 @@ class Klass
      * @param klass AST for this Class
      * @param builder KlassBuilder instance
      */
-    Klass(const std::shared_ptr<ast::Class> &klass, const KlassBuilder *builder);
+    Klass(ast::Class *klass, const KlassBuilder *builder);
 
     /**
      * @brief Construct new empty Klass
@@ -59,7 +62,7 @@ class Klass
      *
      * @return Class name
      */
-    inline const std::string &name() const
+    inline const ::Symbol &name() const
     {
         return _klass->_string;
     }
@@ -79,7 +82,7 @@ class Klass
      *
      * @return Class type
      */
-    inline const std::shared_ptr<ast::Type> &klass() const
+    inline ast::Type *klass() const
     {
         return _klass;
     }
@@ -98,7 +101,7 @@ class Klass
      *
      * @return Iterator to the first field
      */
-    inline std::vector<std::shared_ptr<ast::Feature>>::const_iterator fields_begin() const
+    inline std::vector<ast::Feature *>::const_iterator fields_begin() const
     {
         return _fields.begin();
     }
@@ -108,7 +111,7 @@ class Klass
      *
      * @return Iterator to the behind of the last field
      */
-    inline std::vector<std::shared_ptr<ast::Feature>>::const_iterator fields_end() const
+    inline std::vector<ast::Feature *>::const_iterator fields_end() const
     {
         return _fields.end();
     }
@@ -137,7 +140,7 @@ class Klass
      *
      * @return Iterator to the first method
      */
-    inline std::vector<std::pair<std::shared_ptr<ast::Type>, std::shared_ptr<ast::Feature>>>::const_iterator
+    inline std::vector<std::pair<ast::Type *, ast::Feature *>>::const_iterator
     methods_begin() const
     {
         return _methods.begin();
@@ -148,19 +151,29 @@ class Klass
      *
      * @return Iterator to the behind of the last method
      */
-    inline std::vector<std::pair<std::shared_ptr<ast::Type>, std::shared_ptr<ast::Feature>>>::const_iterator
+    inline std::vector<std::pair<ast::Type *, ast::Feature *>>::const_iterator
     methods_end() const
     {
         return _methods.end();
     }
 
+    /**
+     * @brief Methods that are called through the dispatch table
+     *
+     * @return Dispatch table entries in the order of slots
+     */
+    inline const std::vector<std::pair<ast::Type *, ast::Feature *>> &dispatch_table() const
+    {
+        return _dispatch_table;
+    }
+
     /**
      * @brief Get index in dispatch table for the given method
      *
      * @param method_name Name of the method
      * @return Index
      */
-    size_t method_index(const std::string &method_name) const;
+    size_t method_index(const ::Symbol &method_name) const;
 
     /**
      * @brief Construct full name of the method for this Class
@@ -230,11 +243,14 @@ class KlassBuilder
     const std::shared_ptr<semant::ClassNode> _root;
 
     // Map of classes for inheritance
-    std::unordered_map<std::string, std::shared_ptr<Klass>> _klasses;
+    std::unordered_map<::Symbol, std::shared_ptr<Klass>> _klasses;
 
     // Klasses sorted by tag
     std::vector<std::shared_ptr<Klass>> _klasses_by_tag;
 
+    // Reachable classes and methods
+    const ClassAnalysis _analysis;
+
     int build_klass(const std::shared_ptr<semant::ClassNode> &node, const int &tag);
 
     /**
@@ -244,7 +260,7 @@ class KlassBuilder
      * @param klass ast::Class representation of Cool Class
      * @return New Klass object
      */
-    virtual std::shared_ptr<Klass> make_klass(const std::shared_ptr<ast::Class> &klass) = 0;
+    virtual std::shared_ptr<Klass> make_klass(ast::Class *klass) = 0;
 
   public:
     /**
@@ -266,7 +282,7 @@ class KlassBuilder
      * @param class_name Class name
      * @return Class tag
      */
-    inline int tag(const std::string &class_name) const
+    inline int tag(const ::Symbol &class_name) const
     {
         GUARANTEE_DEBUG(_klasses.find(class_name) != _klasses.end());
         return _klasses.at(class_name)->tag();
@@ -277,7 +293,7 @@ class KlassBuilder
      *
      * @return Iterator to the first Klass
      */
-    inline std::unordered_map<std::string, std::shared_ptr<Klass>>::const_iterator begin() const
+    inline std::unordered_map<::Symbol, std::shared_ptr<Klass>>::const_iterator begin() const
     {
         return _klasses.begin();
     }
@@ -287,7 +303,7 @@ class KlassBuilder
      *
      * @return Iterator to the behind of the last Klass
      */
-    inline std::unordered_map<std::string, std::shared_ptr<Klass>>::const_iterator end() const
+    inline std::unordered_map<::Symbol, std::shared_ptr<Klass>>::const_iterator end() const
     {
         return _klasses.end();
     }
@@ -298,7 +314,7 @@ class KlassBuilder
      * @param class_name Class name
      * @return Klass instance
      */
-    inline const std::shared_ptr<Klass> &klass(const std::string &class_name) const
+    inline const std::shared_ptr<Klass> &klass(const ::Symbol &class_name) const
     {
         GUARANTEE_DEBUG(_klasses.find(class_name) != _klasses.end());
         return _klasses.at(class_name);
@@ -314,6 +330,16 @@ class KlassBuilder
         return _klasses_by_tag;
     }
 
+    /**
+     * @brief Whole-program analysis of classes and methods
+     *
+     * @return ClassAnalysis instance
+     */
+    inline const ClassAnalysis &analysis() const
+    {
+        return _analysis;
+    }
+
     /**
      * @brief Get root of the Class hierarhy
      *
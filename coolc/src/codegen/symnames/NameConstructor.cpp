@@ -13,7 +13,8 @@ const std::pair<std::string, bool> Names::COMMENT_NAMES[CommentsNumber] = {
     {"call_", false},        {"local_", false},      {"sub_", false},          {"add_", false},
     {"mul_", false},         {"div_", false},        {"slt_", false},          {"sgt_", false},
     {"sle_", false},         {"eq_", false},         {"or_", false},           {"phi_", false},
-    {"xor_", false},         {"neg_", false},        {"not_", false},          {"not_null_", false},
+    {"select_", false},      {"xor_", false},        {"neg_", false},          {"not_", false},
+    {"not_null_", false},
 
     {"obj_tag_", false},     {"obj_size_", false},   {"obj_disp_tab_", false},
 
@@ -39,6 +39,7 @@ class Names
         CMP_EQ,
         OR,
         PHI,
+        SELECT,
         XOR,
         NEG,
         NOT,
@@ -1,8 +1,8 @@
 #pragma once
 
 #include "utils/Utils.h"
+#include "utils/symbol/ScopedTable.h"
 #include <functional>
-#include <unordered_map>
 
 namespace codegen
 {
@@ -13,7 +13,7 @@ namespace codegen
 template <class T> class SymbolTable
 {
   private:
-    std::vector<std::unordered_map<std::string, T>> _symbols; // class fields and locals offsets
+    ScopedTable<T> _symbols; // class fields and locals offsets
 
 #ifdef DEBUG
     std::function<void(const std::string &, const T &)> _debug; // logging
@@ -23,25 +23,23 @@ template <class T> class SymbolTable
      * @brief Construct a new SymbolTable with initial scope
      *
      */
-    SymbolTable() : _symbols(1)
-    {
-    }
+    SymbolTable() = default;
 
     /**
      * @brief Find symbol
      *
      * @param symbol Symbol name
-     * @return Symbol object for this symbol
+     * @return Symbol object for this symbol. Reference is valid until the next add_symbol or pop_scope
      */
-    T &symbol(const std::string &symbol);
+    const T &symbol(const ::Symbol &symbol) const;
 
     /**
-     * @brief Create Symbol
+     * @brief Create Symbol in the current scope if it is not defined there yet
      *
      * @param name Symbol name
      * @param symbol Symbol object
      */
-    void add_symbol(const std::string &name, const T &symbol);
+    void add_symbol(const ::Symbol &name, const T &symbol);
 
     /**
      * @brief Push new scope
@@ -49,7 +47,7 @@ template <class T> class SymbolTable
      */
     inline void push_scope()
     {
-        _symbols.emplace_back();
+        _symbols.push_scope();
     }
 
     /**
@@ -58,8 +56,7 @@ template <class T> class SymbolTable
      */
     inline void pop_scope()
     {
-        GUARANTEE_DEBUG(!_symbols.empty());
-        _symbols.pop_back();
+        _symbols.pop_scope();
     }
 
 #ifdef DEBUG
@@ -70,22 +67,18 @@ template <class T> class SymbolTable
 #endif // DEBUG
 };
 
-template <class T> void SymbolTable<T>::add_symbol(const std::string &name, const T &symbol)
+template <class T> void SymbolTable<T>::add_symbol(const ::Symbol &name, const T &symbol)
 {
     CODEGEN_VERBOSE_ONLY(_debug(name, symbol));
-    _symbols.back().emplace(name, symbol);
+    _symbols.insert(name, symbol);
 }
 
-template <class T> T &SymbolTable<T>::symbol(const std::string &symbol)
+template <class T> const T &SymbolTable<T>::symbol(const ::Symbol &symbol) const
 {
-    // search in reverse order
-    for (auto i = _symbols.size() - 1; i >= 0; i--)
+    const auto *const symbol_ptr = _symbols.find(symbol);
+    if (symbol_ptr)
     {
-        const auto symbol_ptr = _symbols[i].find(symbol);
-        if (symbol_ptr != _symbols[i].end())
-        {
-            return symbol_ptr->second;
-        }
+        return *symbol_ptr;
     }
     CODEGEN_VERBOSE_ONLY(LOG("Can't find symbol \"" + symbol + "\""));
     SHOULD_NOT_REACH_HERE();
@@ -1,6 +1,10 @@
 #include "coolc.h"
 #include "lexer/Lexer.h"
 #include "parser/Parser.h"
+#include "parser/cache/ASTCache.h"
+#include "passes/folding/ConstantFolding.h"
+#include "passes/unboxing/Unboxing.h"
+#include "utils/parallel/Parallel.h"
 #include <numeric>
 
 /**
@@ -16,9 +20,17 @@ std::vector<std::shared_ptr<ast::Program>> do_parse(const std::vector<int> &file
  * @brief Do semantic analysis
  *
  * @param programs Vector of programs' ASTs for each file
- * @return One AST for all files
+ * @return Class hierarchy and one AST for all files that owns all nodes
  */
-std::shared_ptr<semant::ClassNode> do_semant(const std::vector<std::shared_ptr<ast::Program>> &programs);
+std::pair<std::shared_ptr<semant::ClassNode>, std::shared_ptr<ast::Program>> do_semant(
+    const std::vector<std::shared_ptr<ast::Program>> &programs);
+
+/**
+ * @brief Run passes that are shared by backends
+ *
+ * @param program Class hierarchy after semant
+ */
+void do_passes(const std::shared_ptr<semant::ClassNode> &program);
 
 /**
  * @brief Generate code
@@ -35,48 +47,88 @@ int main(int argc, char *argv[])
     const auto parsed_program = do_parse(files.first, argv);
     const auto analysed_program = do_semant(parsed_program);
 
-    do_codegen(analysed_program, files.second);
+    do_passes(analysed_program.first);
+    do_codegen(analysed_program.first, files.second);
 
     return 0;
 }
 
 std::vector<std::shared_ptr<ast::Program>> do_parse(const std::vector<int> &files, char *argv[])
 {
-    std::vector<std::shared_ptr<ast::Program>> programs;
-
-    for (const auto &i : files)
-    {
-        DEBUG_ONLY(if (TokensOnly) {
+    DEBUG_ONLY(if (TokensOnly) {
+        for (const auto &i : files)
+        {
             lexer::Lexer l(argv[i]);
             std::cout << "#name \"" << l.file_name() << "\"" << std::endl;
 
-            auto token = l.next();
-            while (token.has_value())
+            l.tokenize();
+        }
+
+        exit(0);
+    });
+
+    // files are independent until semant, so parse them concurrently. Results are reported in command line order
+    std::vector<std::shared_ptr<ast::Program>> programs(files.size());
+    std::vector<std::string> errors(files.size());
+    std::vector<std::exception_ptr> exceptions(files.size());
+
+    auto jobs = Jobs;
+    auto pipeline = PipelineLexer;
+    // traces are not synchronized
+    DEBUG_ONLY(if (TraceLexer || TraceParser) {
+        jobs = 1;
+        pipeline = false;
+    });
+
+    // unchanged files are loaded from the cache without lexing and parsing. Entries are complete ASTs, so they are not
+    // written when method bodies are parsed lazily
+    const auto cache = ASTCacheDir.empty() ? nullptr : std::make_unique<parser::ASTCache>(ASTCacheDir);
+
+    parallel_for(jobs, files.size(), [&](const size_t &i) {
+        try
+        {
+            const auto lexer = std::make_shared<lexer::Lexer>(argv[files[i]]);
+            if (cache && (programs[i] = cache->load(lexer->file_name(), lexer->source())))
             {
-                token = l.next();
+                return;
             }
 
-            continue;
-        });
+            parser::Parser parser(lexer, pipeline, LazyMethodBodies);
+            programs[i] = parser.parse_program();
+            if (!programs[i])
+            {
+                errors[i] = parser.error_msg();
+            }
+            else if (cache && !LazyMethodBodies)
+            {
+                cache->store(lexer->source(), *programs[i]);
+            }
+        }
+        catch (...)
+        {
+            // rethrow in order, as if files were parsed sequentially
+            exceptions[i] = std::current_exception();
+        }
+    });
 
-        parser::Parser parser(std::make_shared<lexer::Lexer>(argv[i]));
-        if (const auto ast = parser.parse_program())
+    for (size_t i = 0; i < programs.size(); i++)
+    {
+        if (exceptions[i])
         {
-            programs.push_back(ast);
+            std::rethrow_exception(exceptions[i]);
         }
-        else
+        if (!programs[i])
         {
-            std::cout << parser.error_msg() << std::endl;
+            std::cout << errors[i] << std::endl;
             exit(-1);
         }
     }
 
-    DEBUG_ONLY(if (TokensOnly) { exit(0); });
-
     return programs;
 }
 
-std::shared_ptr<semant::ClassNode> do_semant(const std::vector<std::shared_ptr<ast::Program>> &programs)
+std::pair<std::shared_ptr<semant::ClassNode>, std::shared_ptr<ast::Program>> do_semant(
+    const std::vector<std::shared_ptr<ast::Program>> &programs)
 {
     semant::Semant semant(std::move(programs));
     const auto result = semant.infer_types_and_check();
@@ -89,7 +141,14 @@ std::shared_ptr<semant::ClassNode> do_semant(const std::vector<std::shared_ptr<a
 
     DEBUG_ONLY(if (PrintFinalAST) { ast::dump_program(*(result.second)); });
 
-    return result.first;
+    return result;
+}
+
+void do_passes(const std::shared_ptr<semant::ClassNode> &program)
+{
+    // unboxing sees the folded constants
+    passes::ConstantFolding().run(program);
+    passes::Unboxing().run(program);
 }
 
 void do_codegen(const std::shared_ptr<semant::ClassNode> &program, const std::string &out_file)
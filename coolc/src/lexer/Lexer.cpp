@@ -2,8 +2,10 @@
 
 using namespace lexer;
 
-const std::regex Lexer::LEXER_SPEC_REGEX(
-    std::string(
+const std::regex &Lexer::lexer_spec_regex()
+{
+    // libstdc++ rejects null character in the pattern, so match_tokens_with_regex handles \x00 itself
+    static const std::regex LEXER_SPEC_REGEX(
         // keywords
         "[cC][lL][aA][sS][sS]|[eE][lL][sS][eE]|[fF][iI]|[iI][fF]"
         "|[iI][nN]|[iI][nN][hH][eE][rR][iI][tT][sS]|[lL][eE][tT]|"
@@ -20,59 +22,97 @@ const std::regex Lexer::LEXER_SPEC_REGEX(
         // whitespaces
         "[\f\r\t\v ]+|"
         // error
-        "." // . does not accept \x00
-        "|\x00",
-        LEXER_SPEC_REGEX_SIZE),
-    std::regex::extended);
+        ".",
+        std::regex::extended);
 
-const std::regex Lexer::STR_SYMBOLS_REGEX("\\\"|\\\\|\\x00");
-const std::regex Lexer::COMM_SYMBOLS_REGEX("\\(\\*|\\*\\)");
+    return LEXER_SPEC_REGEX;
+}
 
-Lexer::Lexer(const std::string &input_file_name) : _file_name(input_file_name)
+Lexer::Lexer(const std::string &input_file_name)
+    : _file_name(input_file_name), _source(input_file_name, MmapInput), _source_pos(0), _eof(false)
 {
     _line_number = 0;
 
-    _input_file.open(input_file_name);
-    if (!_input_file.is_open())
+    if (!_source.is_open())
     {
         throw std::runtime_error("Lexer::Lexer: can't open file " + input_file_name + "!");
     }
 }
 
+void Lexer::read_line(std::string_view &line)
+{
+    const auto content = _source.content();
+    if (_source_pos >= content.length())
+    {
+        line = std::string_view();
+        _eof = true;
+        return;
+    }
+
+    const auto line_end = content.find('\n', _source_pos);
+    if (line_end == std::string_view::npos)
+    {
+        // the last line without line break
+        line = content.substr(_source_pos);
+        _source_pos = content.length();
+        _eof = true;
+    }
+    else
+    {
+        line = content.substr(_source_pos, line_end - _source_pos);
+        _source_pos = line_end + 1;
+    }
+}
+
 // append a suffix to prefix if can
 // set new error message
-void Lexer::append_to_string_if_can(std::string &prefix, const std::string &suffix, std::string &error_msg,
-                                    int &error_line_num)
+void Lexer::append_to_string_if_can(std::string &prefix, size_t &prefix_length, const bool &is_slice,
+                                    const std::string_view &suffix, std::string_view &error_msg, int &error_line_num)
 {
     if (!error_msg.empty())
     {
         return;
     }
-    if (prefix.length() + suffix.length() > MAX_STR_CONST - 1)
+    if (prefix_length + suffix.length() > MAX_STR_CONST - 1)
     {
         error_msg = "String constant too long";
         error_line_num = _line_number;
     }
     else
     {
-        prefix += suffix;
+        if (!is_slice)
+        {
+            prefix += suffix;
+        }
+        prefix_length += suffix.length();
     }
 }
 
-Token Lexer::match_string(const std::string &start_string)
+Token Lexer::match_string(const std::string_view &start_string)
 {
 
     auto escape = false;
-    std::string error_msg;
+    std::string_view error_msg;
     int error_line_num;
 
     auto processed_string = start_string;
     std::string builded_string;
+    size_t builded_length = 0;
+    auto is_slice = true;
+
+    // escape sequence or line break is met, so string constant cannot be a slice of the source anymore
+    const auto stop_slicing = [&]() {
+        if (is_slice)
+        {
+            builded_string = start_string.substr(0, builded_length);
+            is_slice = false;
+        }
+    };
 
     while (true)
     {
         // we read all lines from the file
-        if (_input_file.eof() && processed_string.empty())
+        if (_eof && processed_string.empty())
         {
             if (error_msg.empty())
             {
@@ -80,15 +120,15 @@ Token Lexer::match_string(const std::string &start_string)
                 error_line_num = _line_number;
             }
 
-            _current_line.clear();
+            _current_line = std::string_view();
             return Token(Token::ERROR, error_msg, error_line_num);
         }
         if (processed_string.empty())
         {
-            std::getline(_input_file, processed_string);
+            read_line(processed_string);
             _line_number++;
 
-            LEXER_VERBOSE_ONLY(LOG("New line: \"" + processed_string + "\""));
+            LEXER_VERBOSE_ONLY(LOG("New line: \"" + std::string(processed_string) + "\""));
             LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("new line symbol", "", 0)));
 
             // we read a new line, so check if '\n' is escaped
@@ -100,14 +140,15 @@ Token Lexer::match_string(const std::string &start_string)
                              error_msg.empty() ? _line_number : error_line_num);
             }
 
-            append_to_string_if_can(builded_string, "\n", error_msg, error_line_num);
+            stop_slicing();
+            append_to_string_if_can(builded_string, builded_length, is_slice, "\n", error_msg, error_line_num);
             escape = 0;
         }
 
         // escape next character
         if (escape)
         {
-            // we analyze the first character not in the regular expression,
+            // we analyze the first character not in the scanner,
             // so catch the special case when it is \x00
             if (processed_string[0] == '\0')
             {
@@ -119,7 +160,7 @@ Token Lexer::match_string(const std::string &start_string)
             }
             else
             {
-                auto ch = processed_string.substr(0, 1);
+                std::string_view ch = processed_string.substr(0, 1);
                 switch (processed_string[0])
                 {
                 case 'n':
@@ -138,34 +179,43 @@ Token Lexer::match_string(const std::string &start_string)
                     ch = "\\";
                 }
 
-                append_to_string_if_can(builded_string, ch, error_msg, error_line_num);
+                stop_slicing();
+                append_to_string_if_can(builded_string, builded_length, is_slice, ch, error_msg, error_line_num);
             }
             escape = 0;
             processed_string = processed_string.substr(1);
         }
 
         // match escape characters and closing "
-        std::smatch matches;
-        if (std::regex_search(processed_string, matches, STR_SYMBOLS_REGEX))
+        const auto symbol_pos = SymbolScanner::find_string_symbol(processed_string);
+        if (symbol_pos != std::string_view::npos)
         {
-            const auto ch = processed_string[matches.position(0)];
+            const auto ch = processed_string[symbol_pos];
 
-            append_to_string_if_can(builded_string, processed_string.substr(0, matches.position(0)), error_msg,
-                                    error_line_num);
-            processed_string = processed_string.substr(matches.position(0) + 1);
+            append_to_string_if_can(builded_string, builded_length, is_slice, processed_string.substr(0, symbol_pos),
+                                    error_msg, error_line_num);
+            processed_string = processed_string.substr(symbol_pos + 1);
 
             switch (ch)
             {
             case '\"': {
-                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("closing \"", "", matches.position(0))));
+                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("closing \"", "", symbol_pos)));
 
                 _current_line = processed_string;
-                return Token(error_msg.empty() ? Token::STR_CONST : Token::ERROR,
-                             error_msg.empty() ? builded_string : error_msg,
-                             error_msg.empty() ? _line_number : error_line_num);
+                if (!error_msg.empty())
+                {
+                    return Token(Token::ERROR, error_msg, error_line_num);
+                }
+                if (is_slice)
+                {
+                    return Token(Token::STR_CONST, start_string.substr(0, builded_length), _line_number);
+                }
+
+                // interned string outlives the lexer
+                return Token(Token::STR_CONST, Symbol(builded_string).str(), _line_number);
             }
             case '\\': {
-                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("closing \\", "", matches.position(0))));
+                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("closing \\", "", symbol_pos)));
 
                 if (error_msg.empty())
                 {
@@ -174,7 +224,7 @@ Token Lexer::match_string(const std::string &start_string)
                 break;
             }
             case '\0': {
-                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("null character", "", matches.position(0))));
+                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("null character", "", symbol_pos)));
 
                 if (error_msg.empty())
                 {
@@ -187,211 +237,314 @@ Token Lexer::match_string(const std::string &start_string)
         }
         else
         {
-            // did not catch any special characters using regular expression
-            append_to_string_if_can(builded_string, processed_string, error_msg, error_line_num);
-            processed_string.clear();
+            // did not catch any special characters
+            append_to_string_if_can(builded_string, builded_length, is_slice, processed_string, error_msg,
+                                    error_line_num);
+            processed_string = std::string_view();
         }
     }
 }
 
-std::optional<Token> Lexer::skip_comment(const std::string &start_string)
+std::optional<Token> Lexer::skip_comment(const std::string_view &start_string)
 {
     auto processed_string = start_string;
     auto comm_level = 1;
 
     while (true)
     {
-        if (_input_file.eof() && processed_string.empty())
+        if (_eof && processed_string.empty())
         {
-            _current_line.clear();
+            _current_line = std::string_view();
             return Token(Token::ERROR, "EOF in comment", _line_number);
         }
         if (processed_string.empty())
         {
-            std::getline(_input_file, processed_string);
+            read_line(processed_string);
             _line_number++;
 
-            LEXER_VERBOSE_ONLY(LOG("New line: \"" + processed_string + "\""));
+            LEXER_VERBOSE_ONLY(LOG("New line: \"" + std::string(processed_string) + "\""));
         }
 
-        std::smatch matches;
-        if (std::regex_search(processed_string, matches, COMM_SYMBOLS_REGEX))
+        const auto symbol_pos = SymbolScanner::find_comment_symbol(processed_string);
+        if (symbol_pos != std::string_view::npos)
         {
-            for (auto i = 0; i < matches.size(); i++)
-            {
-                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("controls", matches[i], matches.position(i))));
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("controls", processed_string.substr(symbol_pos, 2), symbol_pos)));
 
-                const auto ch = processed_string[matches.position(i)];
-                if (ch == '(')
-                {
-                    comm_level++; // open a nested comment
-                }
-                else
-                {
-                    comm_level--; // close a nested comment
-                }
-                // all comments are closed
-                if (comm_level == 0)
-                {
-                    _current_line = processed_string.substr(matches.position(i) + 2);
-                    return std::nullopt;
-                }
+            if (processed_string[symbol_pos] == '(')
+            {
+                comm_level++; // open a nested comment
+            }
+            else
+            {
+                comm_level--; // close a nested comment
             }
-            processed_string = processed_string.substr(matches.position(matches.size() - 1) + 2);
+            // all comments are closed
+            if (comm_level == 0)
+            {
+                _current_line = processed_string.substr(symbol_pos + 2);
+                return std::nullopt;
+            }
+            processed_string = processed_string.substr(symbol_pos + 2);
         }
         else
         {
             // skip this line
-            processed_string.clear();
+            processed_string = std::string_view();
         }
     }
 }
 
-std::optional<Token> Lexer::next()
+void Lexer::match_tokens(const std::string_view &str, std::vector<Token> &tokens) const
 {
-    std::string current_line_suffix;
-    if (_saved_tokens.empty())
+    size_t length = 0;
+    for (size_t pos = 0; pos < str.length(); pos += length)
     {
-        while (_saved_tokens.empty())
-        {
-            if (_current_line.empty())
-            {
-                std::getline(_input_file, _current_line);
-                _line_number++;
+        const auto accept = DFA::longest_match(str, pos, length);
+        const auto lexeme = str.substr(pos, length);
 
-                LEXER_VERBOSE_ONLY(LOG("New line: \"" + _current_line + "\""));
-            }
-            if (_input_file.eof() && _current_line.empty())
-            {
-                // end of file
-                return std::nullopt;
-            }
-
-            // try to match Cool string
-            const auto string_start = _current_line.find("\"");
-            // try to match Cool comments
-            const auto par_comm_start = _current_line.find("(*");
-            const auto dash_comm_start = _current_line.find("--");
+        switch (accept)
+        {
+        case dfa::IDENTIFIER: {
+            const auto keyword = Token::keyword_type(lexeme);
 
-            auto suffix_start = -1;
-            auto shift = -1;
-            // save string suffix for further lexing
-            if (string_start < par_comm_start && string_start < dash_comm_start)
+            if (keyword && *keyword != Token::BOOL_CONST)
             {
-                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("start of the string", "", string_start)));
-                suffix_start = string_start;
-                shift = 1;
+                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("keyword", lexeme, pos)));
+                tokens.emplace_back(*keyword, lexeme, _line_number);
             }
-            else if (par_comm_start < string_start && par_comm_start < dash_comm_start)
+            else if (keyword)
             {
-                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("start of the comment", "", par_comm_start)));
-                suffix_start = par_comm_start;
-                shift = 2;
+                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("boolean", lexeme, pos)));
+                tokens.emplace_back(Token::BOOL_CONST, Token::bool_lexeme(lexeme[0] == 't'), _line_number);
             }
-            else if (dash_comm_start < string_start && dash_comm_start < par_comm_start)
+            else if (Token::is_typeid(lexeme))
             {
-                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("start of the dash comment", "", dash_comm_start)));
-                suffix_start = dash_comm_start;
-                shift = 2;
+                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("typeid", lexeme, pos)));
+                tokens.emplace_back(Token::TYPEID, lexeme, _line_number);
             }
-            if (suffix_start != -1)
-            {
-                current_line_suffix = _current_line.substr(suffix_start + shift);
-                _current_line = _current_line.substr(0, suffix_start);
-            }
-            // throw out suffix for comments starting from --
-            if (suffix_start == dash_comm_start)
+            else
             {
-                current_line_suffix.clear();
-                suffix_start = -1;
+                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("object", lexeme, pos)));
+                tokens.emplace_back(Token::OBJECTID, lexeme, _line_number);
             }
+            break;
+        }
+        case dfa::NUMBER: {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("number", lexeme, pos)));
+            tokens.emplace_back(Token::INT_CONST, lexeme, _line_number);
+            break;
+        }
+        case dfa::SYMBOL: {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("symbol", lexeme, pos)));
+            tokens.emplace_back(Token::str_to_token(lexeme), lexeme, _line_number);
+            break;
+        }
+        case dfa::CLOSE_COMMENT: {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("", lexeme, pos)));
+            tokens.emplace_back(Token::ERROR, "Unmatched *)", _line_number);
+            break;
+        }
+        case dfa::WHITESPACE: {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("whitespace", lexeme, pos)));
+            break;
+        }
+        default: {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("invalid character", lexeme, pos)));
+            tokens.emplace_back(Token::ERROR, lexeme, _line_number);
+        }
+        }
+    }
+}
 
-            // match all substring before Cool string and Cool comments
-            auto match_begin = std::sregex_iterator(_current_line.begin(), _current_line.end(), LEXER_SPEC_REGEX);
-            auto match_end = std::sregex_iterator();
+void Lexer::match_tokens_with_regex(const std::string_view &str, std::vector<Token> &tokens) const
+{
+    // regex does not match \x00, so it is the error token between slices of the line
+    size_t begin = 0;
+    for (auto null_pos = str.find('\0'); null_pos != std::string_view::npos; null_pos = str.find('\0', begin))
+    {
+        match_slice_with_regex(str.substr(begin, null_pos - begin), tokens);
+        tokens.emplace_back(Token::ERROR, str.substr(null_pos, 1), _line_number);
+        begin = null_pos + 1;
+    }
+    match_slice_with_regex(str.substr(begin), tokens);
+}
 
-            for (auto it = match_begin; it != match_end; ++it)
-            {
-                auto str_in_lowercase = it->str();
-                std::transform(str_in_lowercase.begin(), str_in_lowercase.end(), str_in_lowercase.begin(), ::tolower);
+void Lexer::match_slice_with_regex(const std::string_view &str, std::vector<Token> &tokens) const
+{
+    auto match_begin = std::cregex_iterator(str.data(), str.data() + str.length(), lexer_spec_regex());
+    auto match_end = std::cregex_iterator();
 
-                // we are not interested in characters (\x00) over the line length
-                if (it->position() >= _current_line.size())
-                {
-                    continue;
-                }
-                // if we matched \x00 in the string so create a string containing \x00
-                Token t(Token::ERROR, (it->str()).length() != 0 ? it->str() : std::string("\0", 1), _line_number);
+    for (auto it = match_begin; it != match_end; ++it)
+    {
+        const auto lexeme = str.substr(it->position(), it->length());
+        Token t(Token::ERROR, lexeme, _line_number);
 
-                if (Token::is_keyword(str_in_lowercase))
-                {
-                    LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("keyword or symbol", it->str(), it->position())));
-                    t = Token(Token::str_to_token(str_in_lowercase), it->str(), _line_number);
-                }
-                else if (Token::is_number(it->str()))
-                {
-                    LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("number", it->str(), it->position())));
-                    t = Token(Token::INT_CONST, str_in_lowercase, _line_number);
-                }
-                else if (Token::is_boolean(it->str()))
-                {
-                    LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("boolean", it->str(), it->position())));
-                    t = Token(Token::BOOL_CONST, str_in_lowercase, _line_number);
-                }
-                else if (Token::is_typeid(it->str()))
-                {
-                    LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("typeid", it->str(), it->position())));
-                    t = Token(Token::TYPEID, it->str(), _line_number);
-                }
-                else if (Token::is_object(it->str()))
-                {
-                    LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("object", it->str(), it->position())));
-                    t = Token(Token::OBJECTID, it->str(), _line_number);
-                }
-                else if (Token::is_close_par_comment(it->str()))
-                {
-                    LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("", it->str(), it->position())));
-                    t = Token(Token::ERROR, "Unmatched *)", _line_number);
-                }
-                else if (Token::is_whitespace(it->str()))
-                {
-                    LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("whitespace", it->str(), it->position())));
-                    continue;
-                }
-                _saved_tokens.push(t);
-            }
-            _current_line.clear();
+        if (Token::is_keyword(it->str()))
+        {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("keyword", it->str(), it->position())));
+            t = Token(*Token::keyword_type(it->str()), lexeme, _line_number);
+        }
+        else if (Token::is_symbol(it->str()))
+        {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("symbol", it->str(), it->position())));
+            t = Token(Token::str_to_token(it->str()), lexeme, _line_number);
+        }
+        else if (Token::is_number(it->str()))
+        {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("number", it->str(), it->position())));
+            t = Token(Token::INT_CONST, lexeme, _line_number);
+        }
+        else if (Token::is_boolean(it->str()))
+        {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("boolean", it->str(), it->position())));
+            t = Token(Token::BOOL_CONST, Token::bool_lexeme(it->str()[0] == 't'), _line_number);
+        }
+        else if (Token::is_typeid(it->str()))
+        {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("typeid", it->str(), it->position())));
+            t = Token(Token::TYPEID, lexeme, _line_number);
+        }
+        else if (Token::is_object(it->str()))
+        {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("object", it->str(), it->position())));
+            t = Token(Token::OBJECTID, lexeme, _line_number);
+        }
+        else if (Token::is_close_par_comment(it->str()))
+        {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("", it->str(), it->position())));
+            t = Token(Token::ERROR, "Unmatched *)", _line_number);
+        }
+        else if (Token::is_whitespace(it->str()))
+        {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("whitespace", it->str(), it->position())));
+            continue;
+        }
+        tokens.push_back(t);
+    }
+}
 
-            LEXER_VERBOSE_ONLY(LOG("Start analyzing a rest of the string."));
+void Lexer::check_tokens(const std::string_view &str, const std::span<const Token> &tokens) const
+{
+    std::vector<Token> legacy_tokens;
+    match_tokens_with_regex(str, legacy_tokens);
+
+    const auto same = std::equal(tokens.begin(), tokens.end(), legacy_tokens.begin(), legacy_tokens.end(),
+                                 [](const Token &a, const Token &b) {
+                                     return a.type() == b.type() && a.value() == b.value() &&
+                                            a.line_number() == b.line_number();
+                                 });
+    if (!same)
+    {
+        throw std::runtime_error("Lexer::check_tokens: DFA and regex lexers disagree in " + _file_name + " at line " +
+                                 std::to_string(_line_number) + "!");
+    }
+}
+
+bool Lexer::lex_line(std::vector<Token> &tokens)
+{
+    std::string_view current_line_suffix;
+
+    if (_current_line.empty())
+    {
+        read_line(_current_line);
+        _line_number++;
 
-            // analyze a rest of the string
-            if (suffix_start != -1)
+        LEXER_VERBOSE_ONLY(LOG("New line: \"" + std::string(_current_line) + "\""));
+    }
+    if (_eof && _current_line.empty())
+    {
+        // end of file
+        return false;
+    }
+
+    // try to match Cool string
+    const auto string_start = _current_line.find("\"");
+    // try to match Cool comments
+    const auto par_comm_start = _current_line.find("(*");
+    const auto dash_comm_start = _current_line.find("--");
+
+    auto suffix_start = -1;
+    auto shift = -1;
+    // save string suffix for further lexing
+    if (string_start < par_comm_start && string_start < dash_comm_start)
+    {
+        LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("start of the string", "", string_start)));
+        suffix_start = string_start;
+        shift = 1;
+    }
+    else if (par_comm_start < string_start && par_comm_start < dash_comm_start)
+    {
+        LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("start of the comment", "", par_comm_start)));
+        suffix_start = par_comm_start;
+        shift = 2;
+    }
+    else if (dash_comm_start < string_start && dash_comm_start < par_comm_start)
+    {
+        LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("start of the dash comment", "", dash_comm_start)));
+        suffix_start = dash_comm_start;
+        shift = 2;
+    }
+    if (suffix_start != -1)
+    {
+        current_line_suffix = _current_line.substr(suffix_start + shift);
+        _current_line = _current_line.substr(0, suffix_start);
+    }
+    // throw out suffix for comments starting from --
+    if (suffix_start == dash_comm_start)
+    {
+        current_line_suffix = std::string_view();
+        suffix_start = -1;
+    }
+
+    // match all substring before Cool string and Cool comments
+    const auto first_token = tokens.size();
+    match_tokens(_current_line, tokens);
+    if (CheckLexer)
+    {
+        check_tokens(_current_line, std::span<const Token>(tokens).subspan(first_token));
+    }
+    _current_line = std::string_view();
+
+    LEXER_VERBOSE_ONLY(LOG("Start analyzing a rest of the string."));
+
+    // analyze a rest of the string
+    if (suffix_start != -1)
+    {
+        // it is start of the Cool string
+        if (suffix_start == string_start)
+        {
+            tokens.push_back(match_string(current_line_suffix));
+        }
+        else
+        {
+            // it is start of the Cool comment
+            auto t = skip_comment(current_line_suffix);
+            if (t.has_value())
             {
-                // it is start of the Cool string
-                if (suffix_start == string_start)
-                {
-                    _saved_tokens.push(match_string(current_line_suffix));
-                }
-                else
-                {
-                    // it is start of the Cool comment
-                    auto t = skip_comment(current_line_suffix);
-                    if (t.has_value())
-                    {
-                        _saved_tokens.push(t.value());
-                    }
-                }
+                tokens.push_back(t.value());
             }
-
-            LEXER_VERBOSE_ONLY(LOG("End analyzing the rest of the string."));
         }
+    }
 
-        const auto t = _saved_tokens.front();
-        _saved_tokens.pop();
+    LEXER_VERBOSE_ONLY(LOG("End analyzing the rest of the string."));
+
+    return true;
+}
 
-        DEBUG_ONLY(if (TokensOnly) { LOG(t.to_string()); });
+std::optional<Token> Lexer::next()
+{
+    while (_saved_tokens.empty())
+    {
+        std::vector<Token> tokens;
+        if (!lex_line(tokens))
+        {
+            return std::nullopt;
+        }
 
-        return t;
+        for (const auto &t : tokens)
+        {
+            _saved_tokens.push(t);
+        }
     }
 
     const auto t = _saved_tokens.front();
@@ -400,4 +553,51 @@ std::optional<Token> Lexer::next()
     DEBUG_ONLY(if (TokensOnly) { LOG(t.to_string()); });
 
     return t;
-}
\ No newline at end of file
+}
+
+TokenBuffer Lexer::tokenize()
+{
+    TokenBuffer buffer(_source.content());
+
+    std::vector<Token> tokens;
+    while (lex_line(tokens))
+    {
+        for (const auto &t : tokens)
+        {
+            DEBUG_ONLY(if (TokensOnly) { LOG(t.to_string()); });
+            buffer.push(t);
+        }
+        tokens.clear();
+    }
+
+    return buffer;
+}
+
+void Lexer::tokenize(TokenRing &ring)
+{
+    TokenBuffer batch(_source.content());
+
+    std::vector<Token> tokens;
+    while (lex_line(tokens))
+    {
+        for (const auto &t : tokens)
+        {
+            batch.push(t);
+        }
+        tokens.clear();
+
+        if (batch.size() >= PIPELINE_BATCH_SIZE)
+        {
+            if (!ring.push(std::move(batch)))
+            {
+                return;
+            }
+            batch = TokenBuffer(_source.content());
+        }
+    }
+
+    if (batch.size() != 0)
+    {
+        ring.push(std::move(batch));
+    }
+}
@@ -1,11 +1,17 @@
 #pragma once
 
+#include "dfa/DFA.h"
+#include "pipeline/TokenRing.h"
+#include "simd/SymbolScanner.h"
+#include "source/SourceBuffer.h"
 #include "token/Token.h"
+#include "token/TokenBuffer.h"
 #include "utils/Utils.h"
-#include <fstream>
 #include <optional>
 #include <queue>
 #include <regex>
+#include <span>
+#include <string_view>
 
 #ifdef DEBUG
 #define LEXER_LOG_MATCH(type, str, pos)                                                                                \
@@ -25,28 +31,47 @@ class Lexer
 {
   private:
     static constexpr int MAX_STR_CONST = 1025;
+    static constexpr size_t PIPELINE_BATCH_SIZE = 512; // minimal number of tokens in one batch for the TokenRing
 
-    std::ifstream _input_file;
     const std::string _file_name;
     int _line_number;
 
-    // lexer specification that is used outside of Cool strings and Cool comments
-    static const std::regex LEXER_SPEC_REGEX;
-    static constexpr int LEXER_SPEC_REGEX_SIZE = 417; // length of the LEXER_SPEC_REGEX with null character
+    // whole source file, all lexemes are slices of it
+    SourceBuffer _source;
+    size_t _source_pos; // start of the next line
+    bool _eof;          // the last line was read
 
-    static const std::regex STR_SYMBOLS_REGEX;
-    static const std::regex COMM_SYMBOLS_REGEX;
+    // legacy lexer specification that is used outside of Cool strings and Cool comments.
+    // DFA replaces it, regex is built on the first use and is only needed to cross-check lexers with +CheckLexer
+    static const std::regex &lexer_spec_regex();
 
-    std::string _current_line;
+    std::string_view _current_line;
     std::queue<Token> _saved_tokens; // see next() description
 
+    // read the next line from the _source like std::getline does
+    void read_line(std::string_view &line);
+
+    // lex the next line (and the following lines if it has multiline string or comment) and append its tokens.
+    // return false for EOF
+    bool lex_line(std::vector<Token> &tokens);
+
     // return either STR_CONST or ERROR token
-    Token match_string(const std::string &start_string);
+    Token match_string(const std::string_view &start_string);
     // return either std::nullopt if OK or ERROR token
-    std::optional<Token> skip_comment(const std::string &start_string);
+    std::optional<Token> skip_comment(const std::string_view &start_string);
+
+    // match all tokens in the line part without strings and comments using DFA
+    void match_tokens(const std::string_view &str, std::vector<Token> &tokens) const;
+    // the same as match_tokens, but uses the legacy regex
+    void match_tokens_with_regex(const std::string_view &str, std::vector<Token> &tokens) const;
+    void match_slice_with_regex(const std::string_view &str, std::vector<Token> &tokens) const; // slice without \x00
+    // throw if DFA and regex lexers produce different tokens
+    void check_tokens(const std::string_view &str, const std::span<const Token> &tokens) const;
 
-    void append_to_string_if_can(std::string &prefix, const std::string &suffix, std::string &error_msg,
-                                 int &error_line_num);
+    // string constant is a slice of the source until the first escape sequence or line break, after that it is
+    // builded in the prefix
+    void append_to_string_if_can(std::string &prefix, size_t &prefix_length, const bool &is_slice,
+                                 const std::string_view &suffix, std::string_view &error_msg, int &error_line_num);
 
   public:
     /**
@@ -59,10 +84,10 @@ class Lexer
     /**
      * @brief Get maybe next token
      *
-     * @return Next token or nullopt
+     * @return Next token or nullopt. Token lexeme is valid while this Lexer is alive
      *
      * @details
-     * next() reads a line from the _input_file and save it in the _current_line.
+     * next() reads a line from the _source and save it in the _current_line.
      * next() tries to match all possible tokens in the _current_line during a call and save them in the
      * _saved_tokens. next next() calls will be pop tokens from the _saved_tokens if it is not empty. next() can read
      * more than one line if it recognised start of Cool string or Cool comment, in such cases next() will read new
@@ -70,6 +95,20 @@ class Lexer
      */
     std::optional<Token> next();
 
+    /**
+     * @brief Lex the rest of the file in a single pass
+     *
+     * @return Tokens in struct-of-arrays layout. They are valid while this Lexer is alive
+     */
+    TokenBuffer tokenize();
+
+    /**
+     * @brief Lex the rest of the file in batches of tokens
+     *
+     * @param ring Ring for batches. Lexing stops if consumer cancels the ring. Ring is not closed
+     */
+    void tokenize(TokenRing &ring);
+
     /**
      * @brief Get the file name
      *
@@ -80,6 +119,16 @@ class Lexer
         return _file_name;
     }
 
+    /**
+     * @brief Get the whole source file
+     *
+     * @return File contents that live while this Lexer is alive
+     */
+    inline std::string_view source() const
+    {
+        return _source.content();
+    }
+
     /**
      * @brief Get the line number
      *
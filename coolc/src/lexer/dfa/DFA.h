@@ -0,0 +1,198 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace lexer
+{
+
+namespace dfa
+{
+
+/**
+ * @brief Kind of the longest match
+ *
+ */
+enum Accept : uint8_t
+{
+    NONE,
+    IDENTIFIER,    // keyword, boolean, type or object identifier
+    NUMBER,        // integer constant
+    WHITESPACE,    // [\f\r\t\v ]+
+    SYMBOL,        // control symbol or operator
+    CLOSE_COMMENT, // *)
+    INVALID        // any other character
+};
+
+enum CharClass : uint8_t
+{
+    LETTER,
+    DIGIT,
+    UNDERSCORE,
+    SPACE,
+    LT,
+    EQ,
+    GT,
+    MINUS,
+    STAR,
+    RPAREN,
+    PUNCT, // ; { } : ( . @ ~ / + ,
+    OTHER,
+    CHAR_CLASS_NUM
+};
+
+enum State : uint8_t
+{
+    START,
+    IN_IDENTIFIER,
+    IN_NUMBER,
+    IN_WHITESPACE,
+    AFTER_LT,
+    AFTER_EQ,
+    AFTER_STAR,
+    IN_SYMBOL,
+    IN_CLOSE_COMMENT,
+    IN_INVALID,
+    DEAD,
+    STATE_NUM
+};
+
+constexpr std::array<CharClass, 256> make_char_classes()
+{
+    std::array<CharClass, 256> classes{};
+    for (auto &cls : classes)
+    {
+        cls = OTHER;
+    }
+
+    for (int c = 'a'; c <= 'z'; c++)
+    {
+        classes[c] = LETTER;
+        classes[c - 'a' + 'A'] = LETTER;
+    }
+    for (int c = '0'; c <= '9'; c++)
+    {
+        classes[c] = DIGIT;
+    }
+    for (const char c : {'\f', '\r', '\t', '\v', ' '})
+    {
+        classes[(unsigned char)c] = SPACE;
+    }
+    for (const char c : {';', '{', '}', ':', '(', '.', '@', '~', '/', '+', ','})
+    {
+        classes[(unsigned char)c] = PUNCT;
+    }
+
+    classes['_'] = UNDERSCORE;
+    classes['<'] = LT;
+    classes['='] = EQ;
+    classes['>'] = GT;
+    classes['-'] = MINUS;
+    classes['*'] = STAR;
+    classes[')'] = RPAREN;
+
+    return classes;
+}
+
+constexpr std::array<std::array<State, CHAR_CLASS_NUM>, STATE_NUM> make_transitions()
+{
+    std::array<std::array<State, CHAR_CLASS_NUM>, STATE_NUM> table{};
+    for (auto &row : table)
+    {
+        for (auto &state : row)
+        {
+            state = DEAD;
+        }
+    }
+
+    auto &start = table[START];
+    start[LETTER] = IN_IDENTIFIER;
+    start[DIGIT] = IN_NUMBER;
+    start[UNDERSCORE] = IN_INVALID;
+    start[SPACE] = IN_WHITESPACE;
+    start[LT] = AFTER_LT;
+    start[EQ] = AFTER_EQ;
+    start[GT] = IN_INVALID;
+    start[MINUS] = IN_SYMBOL;
+    start[STAR] = AFTER_STAR;
+    start[RPAREN] = IN_SYMBOL;
+    start[PUNCT] = IN_SYMBOL;
+    start[OTHER] = IN_INVALID;
+
+    table[IN_IDENTIFIER][LETTER] = IN_IDENTIFIER;
+    table[IN_IDENTIFIER][DIGIT] = IN_IDENTIFIER;
+    table[IN_IDENTIFIER][UNDERSCORE] = IN_IDENTIFIER;
+
+    table[IN_NUMBER][DIGIT] = IN_NUMBER;
+
+    table[IN_WHITESPACE][SPACE] = IN_WHITESPACE;
+
+    // <= and <-
+    table[AFTER_LT][EQ] = IN_SYMBOL;
+    table[AFTER_LT][MINUS] = IN_SYMBOL;
+    // =>
+    table[AFTER_EQ][GT] = IN_SYMBOL;
+    // *)
+    table[AFTER_STAR][RPAREN] = IN_CLOSE_COMMENT;
+
+    return table;
+}
+
+// indexed by State
+constexpr std::array<Accept, STATE_NUM> ACCEPTS = {
+    NONE, IDENTIFIER, NUMBER, WHITESPACE, SYMBOL, SYMBOL, SYMBOL, SYMBOL, CLOSE_COMMENT, INVALID, NONE};
+
+constexpr auto CHAR_CLASSES = make_char_classes();
+constexpr auto TRANSITIONS = make_transitions();
+
+} // namespace dfa
+
+/**
+ * @brief Table-driven DFA for the part of the Cool lexical specification that is used outside of Cool strings and Cool
+ * comments
+ *
+ * @details
+ * The automaton is equivalent to the old LEXER_SPEC_REGEX: keywords, booleans, type and object identifiers share one
+ * identifier state and are distinguished by the lexeme after the longest match. Transition tables are built at
+ * compile time.
+ */
+class DFA
+{
+  public:
+    /**
+     * @brief Find the longest token at the given position
+     *
+     * @param str String to scan
+     * @param pos Start position, must be less than str length
+     * @param length Length of the longest match, it is never zero
+     * @return Kind of the longest match
+     */
+    static dfa::Accept longest_match(const std::string_view &str, const size_t &pos, size_t &length)
+    {
+        using namespace dfa;
+
+        auto state = START;
+        auto accept = NONE;
+        length = 0;
+
+        for (auto i = pos; i < str.length(); i++)
+        {
+            state = TRANSITIONS[state][CHAR_CLASSES[(unsigned char)str[i]]];
+            if (state == DEAD)
+            {
+                break;
+            }
+
+            if (ACCEPTS[state] != NONE)
+            {
+                accept = ACCEPTS[state];
+                length = i - pos + 1;
+            }
+        }
+
+        return accept;
+    }
+};
+
+} // namespace lexer
@@ -0,0 +1,36 @@
+#include "TokenPipeline.h"
+#include "lexer/Lexer.h"
+
+using namespace lexer;
+
+TokenPipeline::TokenPipeline(const std::shared_ptr<Lexer> &lexer) : _lexer(lexer)
+{
+    _thread = std::thread([this]() {
+        try
+        {
+            _lexer->tokenize(_ring);
+        }
+        catch (...)
+        {
+            _exception = std::current_exception();
+        }
+        _ring.close();
+    });
+}
+
+TokenPipeline::~TokenPipeline()
+{
+    _ring.cancel();
+    _thread.join();
+}
+
+std::optional<TokenBuffer> TokenPipeline::next_batch()
+{
+    auto batch = _ring.pop();
+    if (!batch && _exception)
+    {
+        std::rethrow_exception(_exception);
+    }
+
+    return batch;
+}
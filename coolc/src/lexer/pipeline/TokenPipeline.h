@@ -0,0 +1,50 @@
+#pragma once
+
+#include "TokenRing.h"
+#include <exception>
+#include <memory>
+#include <thread>
+
+namespace lexer
+{
+
+class Lexer;
+
+/**
+ * @brief Run the Lexer on its own thread and hand token batches over the TokenRing
+ *
+ */
+class TokenPipeline
+{
+  private:
+    std::shared_ptr<Lexer> _lexer;
+    TokenRing _ring;
+    std::exception_ptr _exception; // lexer failure, rethrown by the consumer after the last batch
+    std::thread _thread;
+
+  public:
+    /**
+     * @brief Start lexing
+     *
+     * @param lexer Lexer that is used only by the pipeline thread until the ring is closed
+     */
+    explicit TokenPipeline(const std::shared_ptr<Lexer> &lexer);
+
+    /**
+     * @brief Cancel lexing if it is not finished and wait for the thread
+     *
+     */
+    ~TokenPipeline();
+
+    TokenPipeline(const TokenPipeline &) = delete;
+    TokenPipeline &operator=(const TokenPipeline &) = delete;
+
+    /**
+     * @brief Get the next batch of tokens
+     *
+     * @return Next batch or nullopt at the end of file. Lexer state can be read after nullopt
+     */
+    std::optional<TokenBuffer> next_batch();
+};
+
+} // namespace lexer
@@ -0,0 +1,44 @@
+#include "TokenRing.h"
+
+#include <thread>
+
+using namespace lexer;
+
+bool TokenRing::push(TokenBuffer &&batch)
+{
+    const auto tail = _tail.load(std::memory_order_relaxed);
+    while (tail - _head.load(std::memory_order_acquire) == CAPACITY)
+    {
+        if (_cancelled.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+
+    _slots[tail % CAPACITY] = std::move(batch);
+    _tail.store(tail + 1, std::memory_order_release);
+
+    return !_cancelled.load(std::memory_order_acquire);
+}
+
+std::optional<TokenBuffer> TokenRing::pop()
+{
+    const auto head = _head.load(std::memory_order_relaxed);
+    while (head == _tail.load(std::memory_order_acquire))
+    {
+        // producer can push the last batch right before closing, so check the tail again
+        if (_closed.load(std::memory_order_acquire) && head == _tail.load(std::memory_order_acquire))
+        {
+            return std::nullopt;
+        }
+        std::this_thread::yield();
+    }
+
+    auto &slot = _slots[head % CAPACITY];
+    auto batch = std::move(slot);
+    slot.reset();
+    _head.store(head + 1, std::memory_order_release);
+
+    return batch;
+}
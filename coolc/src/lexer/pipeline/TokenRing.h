@@ -0,0 +1,73 @@
+#pragma once
+
+#include "lexer/token/TokenBuffer.h"
+#include <array>
+#include <atomic>
+#include <optional>
+
+namespace lexer
+{
+
+/**
+ * @brief Lock-free single-producer single-consumer ring of token batches
+ *
+ * @details
+ * Lexer thread pushes batches and closes the ring at the end of the file, parser thread pops them. Both sides spin
+ * with yield when the ring is full or empty. Consumer can cancel the ring, e.g. after a syntax error, then the
+ * producer stops at the next push.
+ */
+class TokenRing
+{
+  private:
+    static constexpr size_t CAPACITY = 64;
+
+    std::array<std::optional<TokenBuffer>, CAPACITY> _slots;
+
+    std::atomic<size_t> _head; // next slot to pop, written by consumer
+    std::atomic<size_t> _tail; // next slot to push, written by producer
+    std::atomic<bool> _closed;
+    std::atomic<bool> _cancelled;
+
+  public:
+    TokenRing() : _head(0), _tail(0), _closed(false), _cancelled(false)
+    {
+    }
+
+    TokenRing(const TokenRing &) = delete;
+    TokenRing &operator=(const TokenRing &) = delete;
+
+    /**
+     * @brief Push a batch, wait while the ring is full
+     *
+     * @param batch Tokens
+     * @return False if consumer cancelled the ring
+     */
+    bool push(TokenBuffer &&batch);
+
+    /**
+     * @brief Pop a batch, wait while the ring is empty
+     *
+     * @return Next batch or nullopt if producer closed the ring and all batches were popped
+     */
+    std::optional<TokenBuffer> pop();
+
+    /**
+     * @brief Producer has no more batches
+     *
+     */
+    inline void close()
+    {
+        _closed.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Consumer does not need more batches
+     *
+     */
+    inline void cancel()
+    {
+        _cancelled.store(true, std::memory_order_release);
+    }
+};
+
+} // namespace lexer
@@ -0,0 +1,175 @@
+#include "SymbolScanner.h"
+
+#ifdef __SSE2__
+#define LEXER_SIMD_X86
+#include <immintrin.h>
+#endif // __SSE2__
+
+using namespace lexer;
+
+namespace
+{
+
+inline bool is_string_symbol(const char &c)
+{
+    return c == '\"' || c == '\\' || c == '\0';
+}
+
+inline bool is_comment_symbol(const char &c, const char &next)
+{
+    return (c == '(' && next == '*') || (c == '*' && next == ')');
+}
+
+size_t find_string_symbol_scalar(const char *data, const size_t &length, size_t pos)
+{
+    for (; pos < length; pos++)
+    {
+        if (is_string_symbol(data[pos]))
+        {
+            return pos;
+        }
+    }
+    return std::string_view::npos;
+}
+
+size_t find_comment_symbol_scalar(const char *data, const size_t &length, size_t pos)
+{
+    for (; pos + 1 < length; pos++)
+    {
+        if (is_comment_symbol(data[pos], data[pos + 1]))
+        {
+            return pos;
+        }
+    }
+    return std::string_view::npos;
+}
+
+#ifdef LEXER_SIMD_X86
+
+size_t find_string_symbol_sse2(const char *data, const size_t &length)
+{
+    const auto quote = _mm_set1_epi8('\"');
+    const auto backslash = _mm_set1_epi8('\\');
+    const auto zero = _mm_setzero_si128();
+
+    size_t pos = 0;
+    for (; pos + 16 <= length; pos += 16)
+    {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+        const auto found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                                        _mm_cmpeq_epi8(chunk, zero));
+
+        const unsigned mask = _mm_movemask_epi8(found);
+        if (mask)
+        {
+            return pos + __builtin_ctz(mask);
+        }
+    }
+
+    return find_string_symbol_scalar(data, length, pos);
+}
+
+size_t find_comment_symbol_sse2(const char *data, const size_t &length)
+{
+    const auto lparen = _mm_set1_epi8('(');
+    const auto star = _mm_set1_epi8('*');
+    const auto rparen = _mm_set1_epi8(')');
+
+    size_t pos = 0;
+    // every byte of the chunk is compared with the next one, so one more byte must be available
+    for (; pos + 16 < length; pos += 16)
+    {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+        const auto next = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos + 1));
+
+        const auto open = _mm_and_si128(_mm_cmpeq_epi8(chunk, lparen), _mm_cmpeq_epi8(next, star));
+        const auto close = _mm_and_si128(_mm_cmpeq_epi8(chunk, star), _mm_cmpeq_epi8(next, rparen));
+
+        const unsigned mask = _mm_movemask_epi8(_mm_or_si128(open, close));
+        if (mask)
+        {
+            return pos + __builtin_ctz(mask);
+        }
+    }
+
+    return find_comment_symbol_scalar(data, length, pos);
+}
+
+__attribute__((target("avx2"))) size_t find_string_symbol_avx2(const char *data, const size_t &length)
+{
+    const auto quote = _mm256_set1_epi8('\"');
+    const auto backslash = _mm256_set1_epi8('\\');
+    const auto zero = _mm256_setzero_si256();
+
+    size_t pos = 0;
+    for (; pos + 32 <= length; pos += 32)
+    {
+        const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos));
+        const auto found = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+            _mm256_cmpeq_epi8(chunk, zero));
+
+        const unsigned mask = _mm256_movemask_epi8(found);
+        if (mask)
+        {
+            return pos + __builtin_ctz(mask);
+        }
+    }
+
+    return find_string_symbol_scalar(data, length, pos);
+}
+
+__attribute__((target("avx2"))) size_t find_comment_symbol_avx2(const char *data, const size_t &length)
+{
+    const auto lparen = _mm256_set1_epi8('(');
+    const auto star = _mm256_set1_epi8('*');
+    const auto rparen = _mm256_set1_epi8(')');
+
+    size_t pos = 0;
+    for (; pos + 32 < length; pos += 32)
+    {
+        const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos));
+        const auto next = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos + 1));
+
+        const auto open = _mm256_and_si256(_mm256_cmpeq_epi8(chunk, lparen), _mm256_cmpeq_epi8(next, star));
+        const auto close = _mm256_and_si256(_mm256_cmpeq_epi8(chunk, star), _mm256_cmpeq_epi8(next, rparen));
+
+        const unsigned mask = _mm256_movemask_epi8(_mm256_or_si256(open, close));
+        if (mask)
+        {
+            return pos + __builtin_ctz(mask);
+        }
+    }
+
+    return find_comment_symbol_scalar(data, length, pos);
+}
+
+bool has_avx2()
+{
+    static const bool HAS_AVX2 = __builtin_cpu_supports("avx2");
+    return HAS_AVX2;
+}
+
+#endif // LEXER_SIMD_X86
+
+} // namespace
+
+size_t SymbolScanner::find_string_symbol(const std::string_view &str)
+{
+#ifdef LEXER_SIMD_X86
+    return has_avx2() ? find_string_symbol_avx2(str.data(), str.length())
+                      : find_string_symbol_sse2(str.data(), str.length());
+#else
+    return find_string_symbol_scalar(str.data(), str.length(), 0);
+#endif // LEXER_SIMD_X86
+}
+
+size_t SymbolScanner::find_comment_symbol(const std::string_view &str)
+{
+#ifdef LEXER_SIMD_X86
+    return has_avx2() ? find_comment_symbol_avx2(str.data(), str.length())
+                      : find_comment_symbol_sse2(str.data(), str.length());
+#else
+    return find_comment_symbol_scalar(str.data(), str.length(), 0);
+#endif // LEXER_SIMD_X86
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string_view>
+
+namespace lexer
+{
+
+/**
+ * @brief Vectorized search of the special symbols in Cool strings and Cool comments
+ *
+ * @details
+ * Replaces STR_SYMBOLS_REGEX and COMM_SYMBOLS_REGEX. The input is processed in 32-byte chunks with AVX2 or in 16-byte
+ * chunks with SSE2, the tail that does not fill a whole chunk is processed by the scalar loop. AVX2 kernel is chosen
+ * at runtime if CPU supports it. Non-x86 targets use the scalar loop only.
+ */
+class SymbolScanner
+{
+  public:
+    /**
+     * @brief Find the first symbol that stops a plain run of a Cool string: '"', '\\' or '\0'
+     *
+     * @param str String to scan
+     * @return Position of the symbol or std::string_view::npos
+     */
+    static size_t find_string_symbol(const std::string_view &str);
+
+    /**
+     * @brief Find the first opening "(*" or closing "*)" of a Cool comment
+     *
+     * @param str String to scan
+     * @return Position of the first character of the pair or std::string_view::npos
+     */
+    static size_t find_comment_symbol(const std::string_view &str);
+};
+
+} // namespace lexer
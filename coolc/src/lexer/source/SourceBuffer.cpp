@@ -0,0 +1,75 @@
+#include "SourceBuffer.h"
+
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace lexer;
+
+SourceBuffer::SourceBuffer(const std::string &file_name, const bool &use_mmap)
+    : _mapping(nullptr), _mapping_size(0), _is_open(false)
+{
+    // fallback to the plain reading if file cannot be mapped (e.g. it is a pipe)
+    _is_open = (use_mmap && map(file_name)) || read(file_name);
+}
+
+SourceBuffer::~SourceBuffer()
+{
+    if (_mapping)
+    {
+        munmap(const_cast<char *>(_mapping), _mapping_size);
+    }
+}
+
+bool SourceBuffer::map(const std::string &file_name)
+{
+    const auto fd = open(file_name.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == -1 || !S_ISREG(file_stat.st_mode))
+    {
+        close(fd);
+        return false;
+    }
+
+    // mmap does not accept zero length
+    if (file_stat.st_size != 0)
+    {
+        const auto addr = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED)
+        {
+            close(fd);
+            return false;
+        }
+
+        _mapping = static_cast<const char *>(addr);
+        _mapping_size = file_stat.st_size;
+        _content = std::string_view(_mapping, _mapping_size);
+
+        madvise(addr, _mapping_size, MADV_SEQUENTIAL);
+    }
+
+    close(fd);
+    return true;
+}
+
+bool SourceBuffer::read(const std::string &file_name)
+{
+    std::ifstream input_file(file_name, std::ios::binary);
+    if (!input_file.is_open())
+    {
+        return false;
+    }
+
+    _buffer.assign(std::istreambuf_iterator<char>(input_file), std::istreambuf_iterator<char>());
+    _content = _buffer;
+
+    return true;
+}
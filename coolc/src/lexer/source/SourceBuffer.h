@@ -0,0 +1,65 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace lexer
+{
+
+/**
+ * @brief Read-only contents of the source file
+ *
+ * @details
+ * The whole file is either mapped into memory or read into the owned buffer. Lexemes are slices of the contents, so
+ * SourceBuffer must outlive all tokens built from it.
+ */
+class SourceBuffer
+{
+  private:
+    const char *_mapping;
+    size_t _mapping_size;
+
+    std::string _buffer; // used when file is not mapped
+    std::string_view _content;
+
+    bool _is_open;
+
+    bool map(const std::string &file_name);
+    bool read(const std::string &file_name);
+
+  public:
+    /**
+     * @brief Construct a new SourceBuffer
+     *
+     * @param file_name Name of the source file
+     * @param use_mmap Map file into memory instead of reading it
+     */
+    SourceBuffer(const std::string &file_name, const bool &use_mmap);
+
+    SourceBuffer(const SourceBuffer &) = delete;
+    SourceBuffer &operator=(const SourceBuffer &) = delete;
+
+    ~SourceBuffer();
+
+    /**
+     * @brief Check if the file was opened
+     *
+     * @return True if file was opened
+     */
+    inline bool is_open() const
+    {
+        return _is_open;
+    }
+
+    /**
+     * @brief Get the file contents
+     *
+     * @return File contents
+     */
+    inline std::string_view content() const
+    {
+        return _content;
+    }
+};
+
+} // namespace lexer
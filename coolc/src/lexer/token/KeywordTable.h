@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+namespace lexer
+{
+
+/**
+ * @brief Compile-time perfect hash table with case-insensitive lookup
+ *
+ * @tparam Value Type of the mapped value
+ * @tparam N Number of keys
+ *
+ * @details
+ * Keys must be lowercase and unique. The hash mixes length, the first, the middle and the last characters of the key,
+ * the seed is searched at compile time so that no two keys share a slot. Lookup costs one hash and one comparison and
+ * does not allocate.
+ */
+template <typename Value, size_t N> class KeywordTable
+{
+  private:
+    static constexpr size_t SIZE = 64;
+    static_assert(N <= SIZE / 2, "KeywordTable: too many keys for the table size!");
+
+    struct Slot
+    {
+        std::string_view _key;
+        Value _value{};
+    };
+
+    std::array<Slot, SIZE> _slots{};
+    uint32_t _seed;
+
+    static constexpr char lower(const char &c)
+    {
+        return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+    }
+
+    // str must be non-empty
+    static constexpr size_t hash(const std::string_view &str, const uint32_t &seed)
+    {
+        constexpr uint32_t PRIME = 0x01000193; // FNV prime
+
+        uint32_t h = seed ^ (uint32_t)str.length();
+        h = (h ^ (unsigned char)lower(str[0])) * PRIME;
+        h = (h ^ (unsigned char)lower(str[str.length() / 2])) * PRIME;
+        h = (h ^ (unsigned char)lower(str[str.length() - 1])) * PRIME;
+        return (h ^ (h >> 16)) & (SIZE - 1);
+    }
+
+    static constexpr bool is_perfect(const std::array<std::pair<std::string_view, Value>, N> &keys,
+                                     const uint32_t &seed)
+    {
+        std::array<bool, SIZE> used{};
+        for (const auto &key : keys)
+        {
+            const auto slot = hash(key.first, seed);
+            if (used[slot])
+            {
+                return false;
+            }
+            used[slot] = true;
+        }
+        return true;
+    }
+
+  public:
+    /**
+     * @brief Build the table at compile time
+     *
+     * @param keys Lowercase keys and their values
+     */
+    constexpr explicit KeywordTable(const std::array<std::pair<std::string_view, Value>, N> &keys) : _seed(0)
+    {
+        while (!is_perfect(keys, _seed))
+        {
+            _seed++;
+        }
+
+        for (const auto &key : keys)
+        {
+            auto &slot = _slots[hash(key.first, _seed)];
+            slot._key = key.first;
+            slot._value = key.second;
+        }
+    }
+
+    /**
+     * @brief Find a key ignoring case
+     *
+     * @param str Lexeme
+     * @return Pointer to the value or nullptr
+     */
+    constexpr const Value *find(const std::string_view &str) const
+    {
+        if (str.empty())
+        {
+            return nullptr;
+        }
+
+        const auto &slot = _slots[hash(str, _seed)];
+        if (slot._key.length() != str.length())
+        {
+            return nullptr;
+        }
+
+        for (size_t i = 0; i < str.length(); i++)
+        {
+            if (lower(str[i]) != slot._key[i])
+            {
+                return nullptr;
+            }
+        }
+
+        return &slot._value;
+    }
+};
+
+} // namespace lexer
@@ -1,4 +1,5 @@
 #include "Token.h"
+#include "KeywordTable.h"
 
 using namespace lexer;
 
@@ -15,18 +16,18 @@ std::string Token::to_string() const
     auto out = "#" + std::to_string(_line_number) + " ";
     if (_type >= SEMICOLON && _type <= COMMA)
     {
-        out += "\'" + _lexeme + "\'";
+        out += "\'" + std::string(_lexeme) + "\'";
     }
     else
     {
         out += TOKEN_TYPE_TO_STR[_type];
         if (_type >= INT_CONST && _type < STR_CONST)
         {
-            out += " " + _lexeme;
+            out += " " + std::string(_lexeme);
         }
         else if (_type == STR_CONST || _type == ERROR)
         {
-            out += " " + printable_string(_lexeme);
+            out += " " + printable_string(std::string(_lexeme));
         }
     }
 
@@ -34,24 +35,7 @@ std::string Token::to_string() const
 }
 #endif // DEBUG
 
-const std::unordered_map<std::string, Token::TokenType> Token::STR_TO_TOKEN_TYPE = {
-    {"class", Token::TokenType::CLASS},
-    {"else", Token::TokenType::ELSE},
-    {"fi", Token::TokenType::FI},
-    {"if", Token::TokenType::IF},
-    {"in", Token::TokenType::IN},
-    {"inherits", Token::TokenType::INHERITS},
-    {"let", Token::TokenType::LET},
-    {"loop", Token::TokenType::LOOP},
-    {"pool", Token::TokenType::POOL},
-    {"then", Token::TokenType::THEN},
-    {"while", Token::TokenType::WHILE},
-    {"case", Token::TokenType::CASE},
-    {"esac", Token::TokenType::ESAC},
-    {"of", Token::TokenType::OF},
-    {"not", Token::TokenType::NOT},
-    {"new", Token::TokenType::NEW},
-    {"isvoid", Token::TokenType::ISVOID},
+const std::unordered_map<std::string, Token::TokenType, Token::LexemeHash, std::equal_to<>> Token::STR_TO_TOKEN_TYPE = {
     {";", Token::TokenType::SEMICOLON},
     {"{", Token::TokenType::LEFT_CURLY_BRACKET},
     {"}", Token::TokenType::RIGHT_CURLY_BRACKET},
@@ -72,14 +56,44 @@ const std::unordered_map<std::string, Token::TokenType> Token::STR_TO_TOKEN_TYPE
     {"<-", Token::TokenType::ASSIGN},
     {"<=", Token::TokenType::LE}};
 
-bool Token::is_boolean(const std::string &str)
+namespace
 {
-    auto str_in_lowercase = str;
-    if (str[0] != 'f' && str[0] != 't')
+
+constexpr KeywordTable<Token::TokenType, 19> KEYWORDS(std::array<std::pair<std::string_view, Token::TokenType>, 19>{{
+    {"class", Token::TokenType::CLASS},
+    {"else", Token::TokenType::ELSE},
+    {"fi", Token::TokenType::FI},
+    {"if", Token::TokenType::IF},
+    {"in", Token::TokenType::IN},
+    {"inherits", Token::TokenType::INHERITS},
+    {"let", Token::TokenType::LET},
+    {"loop", Token::TokenType::LOOP},
+    {"pool", Token::TokenType::POOL},
+    {"then", Token::TokenType::THEN},
+    {"while", Token::TokenType::WHILE},
+    {"case", Token::TokenType::CASE},
+    {"esac", Token::TokenType::ESAC},
+    {"of", Token::TokenType::OF},
+    {"not", Token::TokenType::NOT},
+    {"new", Token::TokenType::NEW},
+    {"isvoid", Token::TokenType::ISVOID},
+    {"true", Token::TokenType::BOOL_CONST},
+    {"false", Token::TokenType::BOOL_CONST}}});
+
+} // namespace
+
+std::optional<Token::TokenType> Token::keyword_type(const std::string_view &str)
+{
+    const auto *type = KEYWORDS.find(str);
+    if (!type)
     {
-        return false;
+        return std::nullopt;
+    }
+    // true and false must start with a lowercase letter
+    if (*type == BOOL_CONST && str[0] != 't' && str[0] != 'f')
+    {
+        return std::nullopt;
     }
-    std::transform(str_in_lowercase.begin(), str_in_lowercase.end(), str_in_lowercase.begin(), ::tolower);
 
-    return (str_in_lowercase == "true" || str_in_lowercase == "false");
-}
\ No newline at end of file
+    return *type;
+}
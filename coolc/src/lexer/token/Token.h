@@ -1,9 +1,12 @@
 #pragma once
 
 #include "utils/Utils.h"
+#include "utils/symbol/Symbol.h"
 #include <algorithm>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -64,12 +67,24 @@ class Token
     };
 
   private:
-    // name to token and token to name
-    static const std::unordered_map<std::string, TokenType> STR_TO_TOKEN_TYPE;
+    // hash for lookup by std::string_view without std::string construction
+    struct LexemeHash
+    {
+        using is_transparent = void;
+
+        inline size_t operator()(const std::string_view &str) const
+        {
+            return std::hash<std::string_view>()(str);
+        }
+    };
+
+    // symbol to token and token to name. Keywords are in the perfect hash table, see keyword_type()
+    static const std::unordered_map<std::string, TokenType, LexemeHash, std::equal_to<>> STR_TO_TOKEN_TYPE;
     static const std::vector<std::string> TOKEN_TYPE_TO_STR;
 
     TokenType _type;
-    std::string _lexeme;
+    std::string_view _lexeme; // slice of the source or interned string
+    Symbol _symbol;           // interned lexeme for identifiers and string constants
 
     int _line_number;
 
@@ -78,34 +93,62 @@ class Token
      * @brief Construct a new Token
      *
      * @param type Type of token from TOKEN_TYPE
-     * @param substr Lexeme
+     * @param substr Lexeme. Token does not own it
      * @param line_number Where this token was found in the file
      */
-    Token(const TokenType &type, const std::string &substr, const int &line_number)
+    Token(const TokenType &type, const std::string_view &substr, const int &line_number)
         : _type(type), _lexeme(substr), _line_number(line_number)
     {
+        if (_type == TYPEID || _type == OBJECTID || _type == STR_CONST)
+        {
+            _symbol = Symbol(_lexeme);
+        }
     }
 
     /**
-     * @brief Get token type for Cool reserved words
+     * @brief Get token type for Cool control symbols and operators
      *
      * @param str Lexeme
      * @return Token type for lexeme
      */
-    inline static const TokenType &str_to_token(const std::string &str)
+    inline static const TokenType &str_to_token(const std::string_view &str)
     {
         return STR_TO_TOKEN_TYPE.find(str)->second;
     }
 
     /**
-     * @brief Check if lexeme is a keyword
+     * @brief Check if lexeme is a control symbol or an operator
      *
      * @param str Lexeme
+     * @return True if it is a control symbol or an operator
+     */
+    inline static bool is_symbol(const std::string_view &str)
+    {
+        return STR_TO_TOKEN_TYPE.find(str) != STR_TO_TOKEN_TYPE.end();
+    }
+
+    /**
+     * @brief Classify an identifier lexeme as a keyword or a boolean
+     *
+     * @param str Lexeme in any case
+     * @return Keyword token type, BOOL_CONST if lexeme is a boolean or nullopt
+     *
+     * @details
+     * Keywords are case-insensitive. Booleans are case-insensitive too except for the first letter, it must be
+     * lowercase.
+     */
+    static std::optional<TokenType> keyword_type(const std::string_view &str);
+
+    /**
+     * @brief Check if lexeme is a keyword
+     *
+     * @param str Lexeme in any case
      * @return True if it is a keyword
      */
-    inline static bool is_keyword(const std::string &str)
+    inline static bool is_keyword(const std::string_view &str)
     {
-        return !(STR_TO_TOKEN_TYPE.find(str) == STR_TO_TOKEN_TYPE.end());
+        const auto type = keyword_type(str);
+        return type && *type != BOOL_CONST;
     }
 
     /**
@@ -114,7 +157,7 @@ class Token
      * @param str Lexeme
      * @return True if it is a whitespace
      */
-    inline static bool is_whitespace(const std::string &str)
+    inline static bool is_whitespace(const std::string_view &str)
     {
         return (str[0] == ' ' || str[0] == '\f' || str[0] == '\r' || str[0] == '\t' || str[0] == '\v');
     }
@@ -125,7 +168,7 @@ class Token
      * @param str Lexeme
      * @return True if it is a number
      */
-    inline static bool is_number(const std::string &str)
+    inline static bool is_number(const std::string_view &str)
     {
         return isdigit(str[0]);
     }
@@ -136,7 +179,10 @@ class Token
      * @param str Lexeme
      * @return True if it is a boolean
      */
-    static bool is_boolean(const std::string &str);
+    inline static bool is_boolean(const std::string_view &str)
+    {
+        return keyword_type(str) == BOOL_CONST;
+    }
 
     /**
      * @brief Check if lexeme is a type name
@@ -144,7 +190,7 @@ class Token
      * @param str Lexeme
      * @return True if it is a type name
      */
-    inline static bool is_typeid(const std::string &str)
+    inline static bool is_typeid(const std::string_view &str)
     {
         return str[0] >= 'A' && str[0] <= 'Z' && !is_keyword(str);
     }
@@ -155,7 +201,7 @@ class Token
      * @param str Lexeme
      * @return True if it is an object name
      */
-    inline static bool is_object(const std::string &str)
+    inline static bool is_object(const std::string_view &str)
     {
         return str[0] >= 'a' && str[0] <= 'z' && !is_keyword(str);
     }
@@ -166,11 +212,22 @@ class Token
      * @param str Lexeme
      * @return True if it a closing comment bracket
      */
-    inline static bool is_close_par_comment(const std::string &str)
+    inline static bool is_close_par_comment(const std::string_view &str)
     {
         return str == "*)";
     }
 
+    /**
+     * @brief Get the lexeme of the boolean constant
+     *
+     * @param value Boolean value
+     * @return "true" or "false"
+     */
+    inline static std::string_view bool_lexeme(const bool &value)
+    {
+        return value ? "true" : "false";
+    }
+
     /**
      * @brief Get the type as string
      *
@@ -181,6 +238,17 @@ class Token
         return TOKEN_TYPE_TO_STR[_type];
     }
 
+    /**
+     * @brief Get the given type as string
+     *
+     * @param type Type from TOKEN_TYPE
+     * @return String for type
+     */
+    inline static const std::string &type_to_str(const TokenType &type)
+    {
+        return TOKEN_TYPE_TO_STR[type];
+    }
+
     /**
      * @brief Get the line number
      *
@@ -207,11 +275,21 @@ class Token
      *
      * @return Lexeme
      */
-    inline const std::string &value() const
+    inline const std::string_view &value() const
     {
         return _lexeme;
     }
 
+    /**
+     * @brief Get the interned lexeme
+     *
+     * @return Symbol for TYPEID, OBJECTID and STR_CONST, empty symbol for others
+     */
+    inline const Symbol &symbol() const
+    {
+        return _symbol;
+    }
+
     /**
      * @brief Get the type
      *
@@ -0,0 +1,38 @@
+#include "TokenBuffer.h"
+
+using namespace lexer;
+
+TokenBuffer::TokenBuffer(const std::string_view &source) : _source(source)
+{
+    if (_source.length() > UINT32_MAX)
+    {
+        throw std::runtime_error("TokenBuffer::TokenBuffer: source is too large!");
+    }
+}
+
+void TokenBuffer::push(const Token &token)
+{
+    const auto &lexeme = token.value();
+
+    size_t offset = 0;
+    if (lexeme.data() >= _source.data() && lexeme.data() + lexeme.length() <= _source.data() + _source.length())
+    {
+        offset = lexeme.data() - _source.data();
+    }
+    else
+    {
+        offset = _source.length() + _pool.length();
+        _pool += lexeme;
+    }
+
+    if (offset + lexeme.length() > UINT32_MAX)
+    {
+        throw std::runtime_error("TokenBuffer::push: too many lexemes!");
+    }
+
+    _types.push_back(token.type());
+    _offsets.push_back(offset);
+    _lengths.push_back(lexeme.length());
+    _line_numbers.push_back(token.line_number());
+    _symbols.push_back(token.symbol());
+}
@@ -0,0 +1,201 @@
+#pragma once
+
+#include "Token.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lexer
+{
+
+/**
+ * @brief Tokens of the whole file in struct-of-arrays layout
+ *
+ * @details
+ * Token i is described by the i-th elements of the parallel arrays. Lexeme is stored as an offset and a length: offsets
+ * below the source length point into the source, the others point into the pool that holds lexemes that are not
+ * slices of the source (e.g. error messages). TokenBuffer does not own the source, so the Lexer must outlive it.
+ */
+class TokenBuffer
+{
+  private:
+    std::string_view _source;
+    std::string _pool;
+
+    std::vector<uint8_t> _types;
+    std::vector<uint32_t> _offsets;
+    std::vector<uint32_t> _lengths;
+    std::vector<int> _line_numbers;
+    std::vector<Symbol> _symbols;
+
+  public:
+    /**
+     * @brief Construct an empty TokenBuffer without source
+     *
+     */
+    TokenBuffer() = default;
+
+    /**
+     * @brief Construct a new TokenBuffer
+     *
+     * @param source Source file contents
+     */
+    explicit TokenBuffer(const std::string_view &source);
+
+    /**
+     * @brief Append token to the end of the buffer
+     *
+     * @param token Token
+     */
+    void push(const Token &token);
+
+    /**
+     * @brief Get the number of tokens
+     *
+     * @return Number of tokens
+     */
+    inline size_t size() const
+    {
+        return _types.size();
+    }
+
+    /**
+     * @brief Get the token type
+     *
+     * @param i Index of the token
+     * @return Type
+     */
+    inline Token::TokenType type(const size_t &i) const
+    {
+        return static_cast<Token::TokenType>(_types[i]);
+    }
+
+    /**
+     * @brief Get the lexeme
+     *
+     * @param i Index of the token
+     * @return Lexeme
+     */
+    inline std::string_view value(const size_t &i) const
+    {
+        const size_t offset = _offsets[i];
+        const size_t length = _lengths[i];
+        return offset + length <= _source.length() ? _source.substr(offset, length)
+                                                   : std::string_view(_pool).substr(offset - _source.length(), length);
+    }
+
+    /**
+     * @brief Get the line number
+     *
+     * @param i Index of the token
+     * @return Line number
+     */
+    inline int line_number(const size_t &i) const
+    {
+        return _line_numbers[i];
+    }
+
+    /**
+     * @brief Get the interned lexeme
+     *
+     * @param i Index of the token
+     * @return Symbol for TYPEID, OBJECTID and STR_CONST, empty symbol for others
+     */
+    inline const Symbol &symbol(const size_t &i) const
+    {
+        return _symbols[i];
+    }
+};
+
+/**
+ * @brief Position in the TokenBuffer with the same interface as Token
+ *
+ * @details
+ * Cursor is false after the last token. operator-> lets the cursor be used in place of std::optional<Token>.
+ */
+class TokenCursor
+{
+  private:
+    const TokenBuffer *_buffer;
+    size_t _index;
+
+  public:
+    /**
+     * @brief Construct a new TokenCursor
+     *
+     * @param buffer Tokens
+     * @param index Index of the token to point to
+     */
+    explicit TokenCursor(const TokenBuffer &buffer, const size_t &index = 0) : _buffer(&buffer), _index(index)
+    {
+    }
+
+    /**
+     * @brief Get the position in the buffer
+     *
+     * @return Index of the current token
+     */
+    inline size_t index() const
+    {
+        return _index;
+    }
+
+    /**
+     * @brief Check if cursor points to a token
+     *
+     * @return False after the last token
+     */
+    inline explicit operator bool() const
+    {
+        return _index < _buffer->size();
+    }
+
+    inline const TokenCursor *operator->() const
+    {
+        return this;
+    }
+
+    /**
+     * @brief Move to the next token
+     *
+     * @return This cursor
+     */
+    inline TokenCursor &operator++()
+    {
+        _index++;
+        return *this;
+    }
+
+    inline Token::TokenType type() const
+    {
+        return _buffer->type(_index);
+    }
+
+    inline std::string_view value() const
+    {
+        return _buffer->value(_index);
+    }
+
+    inline int line_number() const
+    {
+        return _buffer->line_number(_index);
+    }
+
+    inline const Symbol &symbol() const
+    {
+        return _buffer->symbol(_index);
+    }
+
+    inline bool same_token_type(const Token::TokenType &type) const
+    {
+        return _buffer->type(_index) == type;
+    }
+
+    inline const std::string &type_as_str() const
+    {
+        return Token::type_to_str(type());
+    }
+};
+
+} // namespace lexer
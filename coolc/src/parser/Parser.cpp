@@ -3,6 +3,20 @@
 
 using namespace parser;
 
+// --------------------------------------- Tokens ---------------------------------------
+void Parser::next_batch()
+{
+    while (auto batch = _pipeline->next_batch())
+    {
+        if (batch->size() != 0)
+        {
+            _tokens = std::make_shared<lexer::TokenBuffer>(std::move(*batch));
+            _next_token = lexer::TokenCursor(*_tokens);
+            return;
+        }
+    }
+}
+
 // --------------------------------------- Error handling ---------------------------------------
 void Parser::report_error()
 {
@@ -18,18 +32,18 @@ void Parser::report_error()
     }
     else
     {
-        const auto &token = _next_token.value();
+        const auto &token = _next_token;
         const auto &type = token.type();
 
         _error = "\"" + _lexer->file_name() + "\", line " + std::to_string(token.line_number()) +
                  ": syntax error at or near ";
         if (type >= lexer::Token::SEMICOLON && type <= lexer::Token::COMMA)
         {
-            _error += "\'" + token.value() + "\'";
+            _error += "\'" + std::string(token.value()) + "\'";
         }
         else if (type >= lexer::Token::INT_CONST && type <= lexer::Token::STR_CONST)
         {
-            _error += token.type_as_str() + " = " + token.value();
+            _error += token.type_as_str() + " = " + std::string(token.value());
         }
         else
         {
@@ -37,8 +51,10 @@ void Parser::report_error()
         }
     }
 
-    PARSER_VERBOSE_ONLY(
-        LOG("Actual token: \"" + _next_token->value() + "\", actual type = " + std::to_string(_next_token->type())));
+    PARSER_VERBOSE_ONLY(if (_next_token) {
+        LOG("Actual token: \"" + std::string(_next_token->value()) +
+            "\", actual type = " + std::to_string(_next_token->type()));
+    });
 }
 
 bool Parser::check_next_and_report_error(const lexer::Token::TokenType &expected_type)
@@ -62,24 +78,29 @@ std::shared_ptr<ast::Program> Parser::parse_program()
 
     const auto program = std::make_shared<ast::Program>();
     program->_line_number = _next_token->line_number();
+    program->_arenas.push_back(_arena);
 
-    bool result = parse_list<std::shared_ptr<ast::Class>>(program->_classes, std::bind(&Parser::parse_class, this),
-                                                          lexer::Token::CLASS);
-    PARSER_RETURN_IF_FALSE(result);
-    if (_next_token)
+    auto result = parse_list(program->_classes, [this]() { return parse_class(); }, lexer::Token::CLASS);
+    if (result && _next_token)
     {
-        PARSER_REPORT_AND_RETURN();
+        report_error();
+        result = false;
+    }
+    if (!result)
+    {
+        report_error_in_skipped_bodies();
+        return nullptr;
     }
 
     PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE PROGRAM")));
     return program;
 }
 
-std::shared_ptr<ast::Class> Parser::parse_class()
+ast::Class *Parser::parse_class()
 {
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE CLASS")));
 
-    const auto klass = std::make_shared<ast::Class>();
+    const auto klass = _arena->make<ast::Class>();
     klass->_line_number = _next_token->line_number();
 
     PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::CLASS));
@@ -93,15 +114,14 @@ std::shared_ptr<ast::Class> Parser::parse_class()
     }
     else
     {
-        klass->_parent = std::make_shared<ast::Type>();
-        klass->_parent->_string = BaseClassesNames[BaseClasses::OBJECT];
+        klass->_parent = _arena->make<ast::Type>();
+        klass->_parent->_string = Symbol(BaseClassesNames[BaseClasses::OBJECT]);
     }
 
     PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::LEFT_CURLY_BRACKET));
     if (!_next_token->same_token_type(lexer::Token::RIGHT_CURLY_BRACKET))
     {
-        bool result = parse_list<std::shared_ptr<ast::Feature>>(
-            klass->_features, std::bind(&Parser::parse_feature, this), lexer::Token::OBJECTID);
+        bool result = parse_list(klass->_features, [this]() { return parse_feature(); }, lexer::Token::OBJECTID);
         PARSER_RETURN_IF_FALSE(result);
     }
     PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::RIGHT_CURLY_BRACKET));
@@ -113,11 +133,11 @@ std::shared_ptr<ast::Class> Parser::parse_class()
     return klass;
 }
 
-std::shared_ptr<ast::Feature> Parser::parse_feature()
+ast::Feature *Parser::parse_feature()
 {
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE FEATURE")));
 
-    const auto feature = std::make_shared<ast::Feature>();
+    const auto feature = _arena->make<ast::Feature>();
     feature->_line_number = _next_token->line_number();
 
     PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::OBJECTID), feature->_object = parse_object());
@@ -131,9 +151,8 @@ std::shared_ptr<ast::Feature> Parser::parse_feature()
         // parse arguments
         if (!_next_token->same_token_type(lexer::Token::RIGHT_PAREN))
         {
-            bool result = parse_list<std::shared_ptr<ast::Formal>>(
-                std::get<ast::MethodFeature>(feature->_base)._formals, std::bind(&Parser::parse_formal, this),
-                lexer::Token::OBJECTID);
+            bool result = parse_list(std::get<ast::MethodFeature>(feature->_base)._formals,
+                                     [this]() { return parse_formal(); }, lexer::Token::OBJECTID);
             PARSER_RETURN_IF_FALSE(result);
         }
         PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::RIGHT_PAREN));
@@ -148,7 +167,10 @@ std::shared_ptr<ast::Feature> Parser::parse_feature()
     case lexer::Token::LEFT_CURLY_BRACKET: {
         // parse method body
         PARSER_ADVANCE_AND_RETURN_IF_EOF();
-        PARSER_ACT_ELSE_RETURN(true, feature->_expr = parse_expr());
+        if (!skip_method_body(feature))
+        {
+            PARSER_ACT_ELSE_RETURN(true, feature->_expr = parse_expr());
+        }
         PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::RIGHT_CURLY_BRACKET));
         break;
     }
@@ -164,11 +186,11 @@ std::shared_ptr<ast::Feature> Parser::parse_feature()
     return feature;
 }
 
-std::shared_ptr<ast::Formal> Parser::parse_formal()
+ast::Formal *Parser::parse_formal()
 {
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE FORMAL")));
 
-    const auto formal = std::make_shared<ast::Formal>();
+    const auto formal = _arena->make<ast::Formal>();
     formal->_line_number = _next_token->line_number();
 
     PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::OBJECTID), formal->_object = parse_object());
@@ -186,319 +208,436 @@ std::shared_ptr<ast::Formal> Parser::parse_formal()
     return formal;
 }
 
-std::shared_ptr<ast::Expression> Parser::parse_expr()
+// --------------------------------------- Lazy method bodies ---------------------------------------
+bool Parser::skip_method_body(ast::Feature *feature)
 {
-    std::shared_ptr<ast::Expression> expr = nullptr;
-
-    save_precedence_level();
-
-    switch (_next_token->type())
+    if (!_lazy_bodies || !std::holds_alternative<ast::MethodFeature>(feature->_base))
     {
-    case lexer::Token::OBJECTID: {
-        expr = parse_expr_object();
-        break;
-    }
-    case lexer::Token::INT_CONST: {
-        expr = parse_int();
-        break;
-    }
-    case lexer::Token::STR_CONST: {
-        expr = parse_string();
-        break;
-    }
-    case lexer::Token::BOOL_CONST: {
-        expr = parse_bool();
-        break;
-    }
-    case lexer::Token::NOT: {
-        expr = parse_not();
-        break;
-    }
-    case lexer::Token::IF: {
-        expr = parse_if();
-        break;
-    }
-    case lexer::Token::WHILE: {
-        expr = parse_while();
-        break;
-    }
-    case lexer::Token::NEG: {
-        expr = parse_neg();
-        break;
-    }
-    case lexer::Token::LEFT_CURLY_BRACKET: {
-        expr = parse_curly_brackets();
-        break;
-    }
-    case lexer::Token::LEFT_PAREN: {
-        expr = parse_paren();
-        break;
-    }
-    case lexer::Token::LET: {
-        expr = parse_let();
-        break;
-    }
-    case lexer::Token::CASE: {
-        expr = parse_case();
-        break;
-    }
-    case lexer::Token::NEW: {
-        expr = parse_new();
-        break;
-    }
-    case lexer::Token::ISVOID: {
-        expr = parse_isvoid();
-        break;
+        return false;
     }
-    default:
-        PARSER_REPORT_AND_RETURN();
+
+    // brackets appear only in blocks, so the body ends at the first unmatched closing bracket
+    const auto begin = _next_token.index();
+    size_t depth = 0;
+    for (auto token = _next_token; token; ++token)
+    {
+        if (token.same_token_type(lexer::Token::LEFT_CURLY_BRACKET))
+        {
+            depth++;
+        }
+        else if (token.same_token_type(lexer::Token::RIGHT_CURLY_BRACKET) && depth-- == 0)
+        {
+            PARSER_VERBOSE_ONLY(LOG(PARSER_APPEND_LINE_NUM("SKIP METHOD BODY")));
+            auto *const body = _arena->make<LazyMethodBody>(_lexer, _tokens, begin);
+            feature->_lazy_body = body;
+            _skipped_bodies.push_back(body);
+            _next_token = token;
+            return true;
+        }
     }
 
-    restore_precedence_level();
+    // unbalanced brackets, parse body now to report the error in place
+    return false;
+}
 
-    return expr == nullptr ? expr : parse_maybe_dispatch_or_oper(expr);
+void Parser::report_error_in_skipped_bodies()
+{
+    const auto arena = std::make_shared<Arena>();
+    for (auto *const body : _skipped_bodies)
+    {
+        std::string error;
+        if (!body->parse(arena, error))
+        {
+            _error = error;
+            return;
+        }
+    }
 }
 
-// --------------------------------------- Helper parse methods ---------------------------------------
-std::shared_ptr<ast::Expression> Parser::parse_if()
+ast::Expression *Parser::parse_method_body()
 {
-    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE IF")));
-    const auto line = _next_token->line_number();
+    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE METHOD BODY")));
 
-    PARSER_ADVANCE_AND_RETURN_IF_EOF();
-    const auto predicate = parse_expr();
+    const auto body = parse_expr();
+    PARSER_RETURN_IF_FALSE(body);
+    PARSER_RETURN_IF_FALSE(check_next_and_report_error(lexer::Token::RIGHT_CURLY_BRACKET));
 
-    PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::THEN));
-    const auto true_path = parse_expr();
+    PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE METHOD BODY")));
+    return body;
+}
 
-    PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::ELSE));
-    const auto false_path = parse_expr();
+ast::Expression *LazyMethodBody::parse(const std::shared_ptr<Arena> &arena, std::string &error)
+{
+    Parser parser(_lexer, _tokens, _begin, arena);
+    const auto body = parser.parse_method_body();
+    error = parser.error_msg();
 
-    PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::FI));
+    // body is parsed only once, so tokens are not needed anymore. Body with the error can be parsed again to report it
+    // in the order of the file
+    if (body)
+    {
+        _lexer.reset();
+        _tokens.reset();
+    }
 
-    PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE IF")));
-    return make_expr(std::move(ast::IfExpression{predicate, true_path, false_path}), line);
+    return body;
 }
 
-std::shared_ptr<ast::Expression> Parser::parse_while()
+ast::Expression *Parser::parse_expr()
 {
-    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE WHILE")));
-    const auto line = _next_token->line_number();
+    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE EXPR")));
+    GUARANTEE_DEBUG(_frames.empty());
 
-    PARSER_ADVANCE_AND_RETURN_IF_EOF();
-
-    const auto predicate = parse_expr();
+    while (_error.empty())
+    {
+        // go down: open constructs until the first atom
+        auto expr = parse_operand();
 
-    PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::LOOP));
-    const auto body = parse_expr();
+        // go up: complete constructs while they get their last subexpression
+        while (expr)
+        {
+            expr = parse_dispatch_or_operator(expr);
+            if (expr && _frames.empty())
+            {
+                PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE EXPR")));
+                return expr;
+            }
+
+            if (expr)
+            {
+                expr = continue_frame(expr);
+            }
+        }
+    }
 
-    PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::POOL));
+    // drop unfinished constructs
+    _frames.clear();
+    _operands.clear();
+    _cases.clear();
 
-    PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE WHILE")));
-    return make_expr(std::move(ast::WhileExpression{predicate, body}), line);
+    return nullptr;
 }
 
-std::shared_ptr<ast::Expression> Parser::parse_case()
+// --------------------------------------- Iterative expression parsing ---------------------------------------
+Parser::Frame *Parser::push_frame(const Continuation &continuation, const int &line, const int &precedence)
 {
-    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE CASE")));
-    const auto line = _next_token->line_number();
-    ast::CaseExpression case_expr;
+    _frames.push_back(
+        {continuation, line, precedence, _operands.size(), _cases.size(), lexer::Token::ERROR, nullptr, nullptr});
+    return &_frames.back();
+}
 
-    PARSER_ADVANCE_AND_RETURN_IF_EOF();
-    case_expr._expr = parse_expr();
+ast::Expression *Parser::pop_frame(ast::Expression *expr)
+{
+    GUARANTEE_DEBUG(!_frames.empty());
 
-    PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::OF));
-    bool result = parse_list<std::shared_ptr<ast::Case>>(case_expr._cases, std::bind(&Parser::parse_one_case, this),
-                                                         lexer::Token::SEMICOLON, true, lexer::Token::ESAC);
-    PARSER_RETURN_IF_FALSE(result);
-    PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::ESAC));
+    _operands.resize(_frames.back()._operands);
+    _cases.resize(_frames.back()._cases);
+    _frames.pop_back();
 
-    PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE CASE")));
-    return make_expr(std::move(case_expr), line);
+    return expr;
 }
 
-std::shared_ptr<ast::Expression> Parser::parse_new()
+int Parser::current_precedence_level() const
 {
-    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE NEW")));
-    const auto line = _next_token->line_number();
-
-    PARSER_ADVANCE_AND_RETURN_IF_EOF();
-
-    PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE NEW")));
-    return make_expr(std::move(ast::NewExpression{parse_type()}), line);
+    return _frames.empty() ? -1 : _frames.back()._precedence;
 }
 
-std::shared_ptr<ast::Expression> Parser::parse_isvoid()
+ast::Expression *Parser::parse_operand()
 {
-    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE ISVOID")));
+    PARSER_RETURN_IF_EOF();
     const auto line = _next_token->line_number();
-    set_precedence_level(precedence_level(lexer::Token::ISVOID));
+    const auto type = _next_token->type();
 
-    PARSER_ADVANCE_AND_RETURN_IF_EOF();
+    switch (type)
+    {
+    case lexer::Token::OBJECTID:
+        return parse_expr_object();
+    case lexer::Token::INT_CONST:
+        return parse_int();
+    case lexer::Token::STR_CONST:
+        return parse_string();
+    case lexer::Token::BOOL_CONST:
+        return parse_bool();
+    case lexer::Token::NEW:
+        return parse_new();
+    case lexer::Token::NOT:
+    case lexer::Token::NEG:
+    case lexer::Token::ISVOID: {
+        PARSER_ADVANCE_AND_RETURN_IF_EOF();
+        push_frame(Continuation::UNARY_OPERAND, line, precedence_level(type))->_token = type;
+        return nullptr;
+    }
+    case lexer::Token::IF: {
+        PARSER_ADVANCE_AND_RETURN_IF_EOF();
+        push_frame(Continuation::IF_PREDICATE, line);
+        return nullptr;
+    }
+    case lexer::Token::WHILE: {
+        PARSER_ADVANCE_AND_RETURN_IF_EOF();
+        push_frame(Continuation::WHILE_PREDICATE, line);
+        return nullptr;
+    }
+    case lexer::Token::CASE: {
+        PARSER_ADVANCE_AND_RETURN_IF_EOF();
+        push_frame(Continuation::CASE_EXPR, line);
+        return nullptr;
+    }
+    case lexer::Token::LEFT_CURLY_BRACKET: {
+        PARSER_ADVANCE_AND_RETURN_IF_EOF();
+        push_frame(Continuation::BLOCK_EXPR, line);
+        return nullptr;
+    }
+    case lexer::Token::LEFT_PAREN: {
+        PARSER_ADVANCE_AND_RETURN_IF_EOF();
+        push_frame(Continuation::PAREN_EXPR, line);
+        return nullptr;
+    }
+    case lexer::Token::LET:
+        return parse_let_define();
+    }
 
-    PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE ISVOID")));
-    return make_expr(std::move(ast::UnaryExpression{ast::IsVoidExpression(), parse_expr()}), line);
+    PARSER_REPORT_AND_RETURN();
 }
 
-std::shared_ptr<ast::Case> Parser::parse_one_case()
+ast::Expression *Parser::parse_dispatch_or_operator(ast::Expression *expr)
 {
-    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE ONE CASE")));
-    const auto kase = std::make_shared<ast::Case>();
-    kase->_line_number = _next_token->line_number();
-
-    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::OBJECTID), kase->_object = parse_object());
-    PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::COLON));
-    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::TYPEID), kase->_type = parse_type());
-    PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::DARROW));
-    PARSER_ACT_ELSE_RETURN(true, kase->_expr = parse_expr());
+    while (_next_token && (_next_token->same_token_type(lexer::Token::AT) ||
+                           _next_token->same_token_type(lexer::Token::DOT)))
+    {
+        PARSER_VERBOSE_ONLY(LOG(PARSER_APPEND_LINE_NUM("PARSE DISPATCH")));
+        const auto line = _next_token->line_number();
 
-    PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE ONE CASE")));
-    return kase;
-}
+        ast::Type *type = nullptr;
+        if (_next_token->same_token_type(lexer::Token::AT))
+        {
+            PARSER_ADVANCE_AND_RETURN_IF_EOF();
+            PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::TYPEID), type = parse_type());
+        }
 
-std::shared_ptr<ast::Expression> Parser::parse_not()
-{
-    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE NOT")));
-    const auto line = _next_token->line_number();
-    set_precedence_level(precedence_level(lexer::Token::NOT));
+        ast::ObjectExpression *method = nullptr;
+        PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::DOT));
+        PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::OBJECTID), method = parse_object());
 
-    PARSER_ADVANCE_AND_RETURN_IF_EOF();
+        expr = parse_dispatch_args(expr, method, type, line);
+        PARSER_RETURN_IF_FALSE(expr);
+    }
 
-    PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE NOT")));
-    return make_expr(std::move(ast::UnaryExpression{ast::NotExpression(), parse_expr()}), line);
-}
+    if (_next_token && (token_is_left_assoc_operator() || token_is_non_assoc_operator()))
+    {
+        const auto type = _next_token->type();
+        const auto precedence = precedence_level(type);
 
-std::shared_ptr<ast::Expression> Parser::parse_let()
-{
-    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE LET")));
+        // operator with lower precedence is attached to the enclosing expression
+        if (precedence > current_precedence_level())
+        {
+            PARSER_VERBOSE_ONLY(LOG(PARSER_APPEND_LINE_NUM("PARSE OPERATOR")));
+            push_frame(Continuation::BINARY_RHS, _next_token->line_number(), precedence)->_token = type;
+            _operands.push_back(expr);
 
-    PARSER_RETURN_IF_FALSE(check_next_and_report_error(lexer::Token::LET));
-    const auto expr = parse_let_define();
+            PARSER_ADVANCE_AND_RETURN_IF_EOF();
+            return nullptr;
+        }
+    }
 
-    PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE LET")));
     return expr;
 }
 
-std::shared_ptr<ast::Expression> Parser::parse_let_define()
+ast::Expression *Parser::continue_frame(ast::Expression *expr)
 {
-    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE LET DEFINE")));
-    ast::LetExpression def;
+    auto &frame = _frames.back();
+    const auto &operands = frame._operands;
+    const auto &line = frame._line_number;
 
-    PARSER_ADVANCE_AND_RETURN_IF_EOF(); // skip "LET" or ","
-    const auto line = _next_token->line_number();
+    switch (frame._continuation)
+    {
+    case Continuation::ASSIGN_VALUE:
+        return pop_frame(make_expr(ast::AssignExpression{frame._object, expr}, line));
+    case Continuation::UNARY_OPERAND:
+        return pop_frame(make_unary(frame._token, expr, line));
+    case Continuation::BINARY_RHS: {
+        PARSER_RETURN_IF_EOF();
+        if (token_is_non_assoc_operator() && _next_token->same_token_type(frame._token))
+        {
+            PARSER_REPORT_AND_RETURN();
+        }
 
-    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::OBJECTID), def._object = parse_object());
-    PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::COLON));
-    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::TYPEID), def._type = parse_type());
+        return pop_frame(make_binary(frame._token, _operands[operands], expr, line));
+    }
+    case Continuation::IF_PREDICATE: {
+        _operands.push_back(expr);
+        PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::THEN));
+        frame._continuation = Continuation::IF_TRUE_PATH;
+        return nullptr;
+    }
+    case Continuation::IF_TRUE_PATH: {
+        _operands.push_back(expr);
+        PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::ELSE));
+        frame._continuation = Continuation::IF_FALSE_PATH;
+        return nullptr;
+    }
+    case Continuation::IF_FALSE_PATH: {
+        PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::FI));
+        return pop_frame(make_expr(ast::IfExpression{_operands[operands], _operands[operands + 1], expr}, line));
+    }
+    case Continuation::WHILE_PREDICATE: {
+        _operands.push_back(expr);
+        PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::LOOP));
+        frame._continuation = Continuation::WHILE_BODY;
+        return nullptr;
+    }
+    case Continuation::WHILE_BODY: {
+        PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::POOL));
+        return pop_frame(make_expr(ast::WhileExpression{_operands[operands], expr}, line));
+    }
+    case Continuation::LET_INIT: {
+        _operands.push_back(expr);
+        return parse_let_body();
+    }
+    case Continuation::LET_BODY: {
+        const auto init = _operands.size() > operands ? _operands[operands] : nullptr;
+        return pop_frame(make_expr(ast::LetExpression{frame._object, frame._type, init, expr}, line));
+    }
+    case Continuation::CASE_EXPR: {
+        _operands.push_back(expr);
+        PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::OF));
+        return parse_case_branch();
+    }
+    case Continuation::CASE_BRANCH: {
+        _cases.back()->_expr = expr;
+        if (_next_token && _next_token->same_token_type(lexer::Token::SEMICOLON))
+        {
+            PARSER_ADVANCE_AND_RETURN_IF_EOF();
+            if (!_next_token->same_token_type(lexer::Token::ESAC))
+            {
+                return parse_case_branch();
+            }
+        }
+        PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::ESAC));
 
-    PARSER_RETURN_IF_EOF();
-    if (_next_token->same_token_type(lexer::Token::ASSIGN))
-    {
-        PARSER_ADVANCE_AND_RETURN_IF_EOF();
-        PARSER_ACT_ELSE_RETURN(true, def._expr = parse_expr());
+        const auto cases = _arena->make_array(std::span(_cases).subspan(frame._cases));
+        return pop_frame(make_expr(ast::CaseExpression{_operands[operands], cases}, line));
     }
+    case Continuation::BLOCK_EXPR: {
+        _operands.push_back(expr);
+        if (_next_token && _next_token->same_token_type(lexer::Token::SEMICOLON))
+        {
+            PARSER_ADVANCE_AND_RETURN_IF_EOF();
+            if (!_next_token->same_token_type(lexer::Token::RIGHT_CURLY_BRACKET))
+            {
+                return nullptr;
+            }
+        }
+        PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::RIGHT_CURLY_BRACKET));
 
-    if (_next_token->same_token_type(lexer::Token::IN))
-    {
-        PARSER_ADVANCE_AND_RETURN_IF_EOF();
-        PARSER_ACT_ELSE_RETURN(true, def._body_expr = parse_expr());
-
-        PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE LET DEFINE FOR IN")));
-        return make_expr(std::move(def), line);
+        const auto exprs = _arena->make_array(std::span(_operands).subspan(operands));
+        return pop_frame(make_expr(ast::ListExpression{exprs}, line));
+    }
+    case Continuation::PAREN_EXPR: {
+        PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::RIGHT_PAREN));
+        return pop_frame(expr);
     }
+    case Continuation::DISPATCH_ARG: {
+        _operands.push_back(expr);
+        if (_next_token && _next_token->same_token_type(lexer::Token::COMMA))
+        {
+            PARSER_ADVANCE_AND_RETURN_IF_EOF();
+            return nullptr;
+        }
+        PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::RIGHT_PAREN));
 
-    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::COMMA), def._body_expr = parse_let_define());
+        // the first operand is the dispatched expression
+        const auto args = _arena->make_array(std::span(_operands).subspan(operands + 1));
+        return pop_frame(make_dispatch(_operands[operands], frame._object, frame._type, args, line));
+    }
+    }
 
-    PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE LET DEFINE")));
-    return make_expr(std::move(def), line);
+    GUARANTEE_DEBUG(false);
+    return nullptr;
 }
 
-std::shared_ptr<ast::Expression> Parser::parse_neg()
+ast::Expression *Parser::parse_let_define()
 {
-    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE NEG")));
+    PARSER_VERBOSE_ONLY(LOG(PARSER_APPEND_LINE_NUM("PARSE LET DEFINE")));
+
+    PARSER_ADVANCE_AND_RETURN_IF_EOF(); // skip "LET" or ","
     const auto line = _next_token->line_number();
-    set_precedence_level(precedence_level(lexer::Token::NEG));
 
-    PARSER_ADVANCE_AND_RETURN_IF_EOF();
+    ast::ObjectExpression *object = nullptr;
+    ast::Type *type = nullptr;
+    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::OBJECTID), object = parse_object());
+    PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::COLON));
+    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::TYPEID), type = parse_type());
 
-    const auto expr = parse_expr();
+    auto *const frame = push_frame(Continuation::LET_INIT, line);
+    frame->_object = object;
+    frame->_type = type;
 
-    PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE NEG")));
-    return make_expr(std::move(ast::UnaryExpression{ast::NegExpression(), expr}), line);
+    if (_next_token->same_token_type(lexer::Token::ASSIGN))
+    {
+        PARSER_ADVANCE_AND_RETURN_IF_EOF();
+        return nullptr;
+    }
+
+    return parse_let_body();
 }
 
-std::shared_ptr<ast::Expression> Parser::parse_paren()
+ast::Expression *Parser::parse_let_body()
 {
-    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE PAREN")));
-
-    PARSER_ADVANCE_AND_RETURN_IF_EOF();
+    PARSER_RETURN_IF_EOF();
+    _frames.back()._continuation = Continuation::LET_BODY;
 
-    const auto expr = parse_expr();
-    PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::RIGHT_PAREN));
+    if (_next_token->same_token_type(lexer::Token::IN))
+    {
+        PARSER_ADVANCE_AND_RETURN_IF_EOF();
+        return nullptr;
+    }
 
-    PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE PAREN")));
-    return expr;
+    // the next variable is defined by the nested let that is the body of this one
+    PARSER_RETURN_IF_FALSE(check_next_and_report_error(lexer::Token::COMMA));
+    return parse_let_define();
 }
 
-std::shared_ptr<ast::Expression> Parser::parse_curly_brackets()
+ast::Expression *Parser::parse_case_branch()
 {
-    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE BRACKETS")));
-    const auto line = _next_token->line_number();
+    PARSER_VERBOSE_ONLY(LOG(PARSER_APPEND_LINE_NUM("PARSE CASE BRANCH")));
 
-    // parse block
-    ast::ListExpression expr_list;
-
-    PARSER_ADVANCE_AND_RETURN_IF_EOF();
+    PARSER_RETURN_IF_EOF();
+    const auto kase = _arena->make<ast::Case>();
+    kase->_line_number = _next_token->line_number();
 
-    bool result =
-        parse_list<std::shared_ptr<ast::Expression>>(expr_list._exprs, std::bind(&Parser::parse_expr, this),
-                                                     lexer::Token::SEMICOLON, true, lexer::Token::RIGHT_CURLY_BRACKET);
-    PARSER_RETURN_IF_FALSE(result);
-    PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::RIGHT_CURLY_BRACKET));
+    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::OBJECTID), kase->_object = parse_object());
+    PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::COLON));
+    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::TYPEID), kase->_type = parse_type());
+    PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::DARROW));
 
-    PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE BRACKETS")));
-    return make_expr(std::move(expr_list), line);
+    _cases.push_back(kase);
+    _frames.back()._continuation = Continuation::CASE_BRANCH;
+    return nullptr;
 }
 
-bool Parser::parse_dispatch_list(std::vector<std::shared_ptr<ast::Expression>> &list)
+ast::Expression *Parser::parse_dispatch_args(ast::Expression *expr, ast::ObjectExpression *method, ast::Type *type,
+                                             const int &line)
 {
-    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE DISPATCH LIST")));
+    PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::LEFT_PAREN));
+    PARSER_RETURN_IF_EOF();
 
-    if (check_next_and_report_error(lexer::Token::LEFT_PAREN))
+    if (_next_token->same_token_type(lexer::Token::RIGHT_PAREN))
     {
         advance_token();
-    }
-    else
-    {
-        return false;
+        return make_dispatch(expr, method, type, {}, line);
     }
 
-    if (!_next_token->same_token_type(lexer::Token::RIGHT_PAREN))
-    {
-        const auto result = parse_list<std::shared_ptr<ast::Expression>>(list, std::bind(&Parser::parse_expr, this),
-                                                                         lexer::Token::COMMA, true);
-        if (!result)
-        {
-            return false;
-        }
-    }
-    PARSER_VERBOSE_ONLY(LOG("Current token: \"" + _next_token->value() + "\""););
-    if (check_next_and_report_error(lexer::Token::RIGHT_PAREN))
-    {
-        advance_token();
-    }
-    else
-    {
-        return false;
-    }
+    auto *const frame = push_frame(Continuation::DISPATCH_ARG, line);
+    frame->_object = method;
+    frame->_type = type;
+    _operands.push_back(expr);
 
-    PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE DISPATCH LIST")));
-    return true;
+    return nullptr;
 }
+
 // --------------------------------------- Parse arithmetic or logical operators ---------------------------------------
 bool Parser::token_is_left_assoc_operator() const
 {
-    const auto &type = _next_token->type();
     return _next_token->same_token_type(lexer::Token::LESS) || _next_token->same_token_type(lexer::Token::PLUS) ||
            _next_token->same_token_type(lexer::Token::MINUS) || _next_token->same_token_type(lexer::Token::ASTERISK) ||
            _next_token->same_token_type(lexer::Token::SLASH);
@@ -511,105 +650,126 @@ bool Parser::token_is_non_assoc_operator() const
 
 int Parser::precedence_level(const lexer::Token::TokenType &type) const
 {
-    static const std::unordered_map<lexer::Token::TokenType, int> PRECEDENCE{
-        {lexer::Token::ASSIGN, 0}, {lexer::Token::NOT, 1},  {lexer::Token::LESS, 2},  {lexer::Token::EQUALS, 3},
-        {lexer::Token::LE, 3},     {lexer::Token::PLUS, 4}, {lexer::Token::MINUS, 4}, {lexer::Token::ASTERISK, 5},
-        {lexer::Token::SLASH, 5},  {lexer::Token::NEG, 6},  {lexer::Token::ISVOID, 7}};
-
-    return PRECEDENCE.at(type);
-}
-
-void Parser::restore_precedence_level()
-{
-    GUARANTEE_DEBUG(!_precedence_level.empty());
-    _precedence_level.pop();
-}
-
-int Parser::current_precedence_level() const
-{
-    GUARANTEE_DEBUG(!_precedence_level.empty());
-    return _precedence_level.top();
-}
-
-void Parser::set_precedence_level(const int &lvl)
-{
-    GUARANTEE_DEBUG(!_precedence_level.empty());
-    _precedence_level.top() = lvl;
-}
-
-std::shared_ptr<ast::Expression> Parser::parse_operators(const std::shared_ptr<ast::Expression> &lhs)
-{
-    if (_next_token->same_token_type(lexer::Token::PLUS))
+    switch (type)
     {
-        return parse_operator<ast::PlusExpression>(lhs);
-    }
-
-    if (_next_token->same_token_type(lexer::Token::MINUS))
-    {
-        return parse_operator<ast::MinusExpression>(lhs);
-    }
-
-    if (_next_token->same_token_type(lexer::Token::ASTERISK))
+    case lexer::Token::ASSIGN:
+        return 0;
+    case lexer::Token::NOT:
+        return 1;
+    case lexer::Token::LESS:
+        return 2;
+    case lexer::Token::EQUALS:
+    case lexer::Token::LE:
+        return 3;
+    case lexer::Token::PLUS:
+    case lexer::Token::MINUS:
+        return 4;
+    case lexer::Token::ASTERISK:
+    case lexer::Token::SLASH:
+        return 5;
+    case lexer::Token::NEG:
+        return 6;
+    case lexer::Token::ISVOID:
+        return 7;
+    }
+
+    throw std::runtime_error("Parser::precedence_level: unexpected token type!");
+}
+
+ast::Expression *Parser::make_unary(const lexer::Token::TokenType &type, ast::Expression *expr, const int &line)
+{
+    ast::UnaryExpression unary{ast::NegExpression(), expr};
+    switch (type)
     {
-        return parse_operator<ast::MulExpression>(lhs);
+    case lexer::Token::ISVOID:
+        unary._base = ast::IsVoidExpression();
+        break;
+    case lexer::Token::NOT:
+        unary._base = ast::NotExpression();
+        break;
     }
 
-    if (_next_token->same_token_type(lexer::Token::SLASH))
-    {
-        return parse_operator<ast::DivExpression>(lhs);
-    }
+    return make_expr(std::move(unary), line);
+}
 
-    if (_next_token->same_token_type(lexer::Token::LESS))
+ast::Expression *Parser::make_binary(const lexer::Token::TokenType &type, ast::Expression *lhs, ast::Expression *rhs,
+                                     const int &line)
+{
+    ast::BinaryExpression binary{ast::PlusExpression(), lhs, rhs};
+    switch (type)
     {
-        return parse_operator<ast::LTExpression>(lhs);
+    case lexer::Token::MINUS:
+        binary._base = ast::MinusExpression();
+        break;
+    case lexer::Token::ASTERISK:
+        binary._base = ast::MulExpression();
+        break;
+    case lexer::Token::SLASH:
+        binary._base = ast::DivExpression();
+        break;
+    case lexer::Token::LESS:
+        binary._base = ast::LTExpression();
+        break;
+    case lexer::Token::EQUALS:
+        binary._base = ast::EqExpression();
+        break;
+    case lexer::Token::LE:
+        binary._base = ast::LEExpression();
+        break;
     }
 
-    if (_next_token->same_token_type(lexer::Token::EQUALS))
-    {
-        return parse_operator<ast::EqExpression>(lhs);
-    }
+    return make_expr(std::move(binary), line);
+}
 
-    if (_next_token->same_token_type(lexer::Token::LE))
+ast::Expression *Parser::make_dispatch(ast::Expression *expr, ast::ObjectExpression *method, ast::Type *type,
+                                       const std::span<ast::Expression *> &args, const int &line)
+{
+    ast::DispatchExpression dispatch;
+    if (type)
     {
-        return parse_operator<ast::LEExpression>(lhs);
+        dispatch._base = ast::StaticDispatchExpression{type};
     }
+    dispatch._expr = expr;
+    dispatch._object = method;
+    dispatch._args = args;
 
-    return lhs;
+    return make_expr(std::move(dispatch), line);
 }
 
 // ----------------- Methods for parsing expression with complex type of starting -----------------
-std::shared_ptr<ast::Type> Parser::parse_type()
+ast::Type *Parser::parse_type()
 {
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE TYPE")));
 
-    const auto type = std::make_shared<ast::Type>();
+    const auto type = _arena->make<ast::Type>();
 
-    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::TYPEID), type->_string = _next_token->value());
+    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::TYPEID), type->_string = _next_token->symbol());
     PARSER_ADVANCE_AND_RETURN_IF_EOF();
 
     PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE TYPE")));
     return type;
 }
 
-std::shared_ptr<ast::ObjectExpression> Parser::parse_object()
+ast::ObjectExpression *Parser::parse_object()
 {
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE OBJECT")));
 
-    const auto obj = std::make_shared<ast::ObjectExpression>();
+    const auto obj = _arena->make<ast::ObjectExpression>();
 
-    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::OBJECTID), obj->_object = _next_token->value());
+    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::OBJECTID), obj->_object = _next_token->symbol());
     PARSER_ADVANCE_AND_RETURN_IF_EOF();
 
     PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE OBJECT")));
     return obj;
 }
 
-std::shared_ptr<ast::Expression> Parser::parse_expr_object()
+ast::Expression *Parser::parse_expr_object()
 {
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE EXPR OBJECT")));
     const auto line = _next_token->line_number();
 
     const auto lhs = parse_object();
+    PARSER_RETURN_IF_FALSE(lhs);
 
     switch (_next_token->type())
     {
@@ -617,17 +777,12 @@ std::shared_ptr<ast::Expression> Parser::parse_expr_object()
         PARSER_ADVANCE_AND_RETURN_IF_EOF();
 
         PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE EXPR OBJECT FOR ASSIGN")));
-        return make_expr(std::move(ast::AssignExpression{lhs, parse_expr()}), line);
+        push_frame(Continuation::ASSIGN_VALUE, line)->_object = lhs;
+        return nullptr;
     }
     case lexer::Token::LEFT_PAREN: {
-        ast::DispatchExpression dispatch;
-        dispatch._expr = make_expr(std::move(ast::ObjectExpression{SelfObject}), line);
-        dispatch._object = lhs;
-
-        PARSER_RETURN_IF_FALSE(parse_dispatch_list(dispatch._args));
-
         PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE EXPR_OBJECT FOR (")));
-        return make_expr(std::move(dispatch), line);
+        return parse_dispatch_args(make_expr(ast::ObjectExpression{Symbol(SelfObject)}, line), lhs, nullptr, line);
     }
     }
 
@@ -635,31 +790,31 @@ std::shared_ptr<ast::Expression> Parser::parse_expr_object()
     return make_expr(std::move(*lhs), line);
 }
 
-std::shared_ptr<ast::Expression> Parser::parse_int()
+ast::Expression *Parser::parse_int()
 {
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE INT")));
     const auto line = _next_token->line_number();
 
-    const auto value = std::stoi(_next_token->value());
+    const auto value = std::stoi(std::string(_next_token->value()));
     PARSER_ADVANCE_AND_RETURN_IF_EOF();
 
     PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE INT")));
     return make_expr(std::move(ast::IntExpression{value}), line);
 }
 
-std::shared_ptr<ast::Expression> Parser::parse_string()
+ast::Expression *Parser::parse_string()
 {
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE STRING")));
     const auto line = _next_token->line_number();
 
-    const auto value = _next_token->value();
+    const auto value = _next_token->symbol();
     PARSER_ADVANCE_AND_RETURN_IF_EOF();
 
     PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE STRING")));
     return make_expr(std::move(ast::StringExpression{value}), line);
 }
 
-std::shared_ptr<ast::Expression> Parser::parse_bool()
+ast::Expression *Parser::parse_bool()
 {
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE BOOL")));
     const auto line = _next_token->line_number();
@@ -671,42 +826,15 @@ std::shared_ptr<ast::Expression> Parser::parse_bool()
     return make_expr(std::move(ast::BoolExpression{value}), line);
 }
 
-std::shared_ptr<ast::Expression> Parser::parse_maybe_dispatch_or_oper(const std::shared_ptr<ast::Expression> &expr)
+ast::Expression *Parser::parse_new()
 {
-    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE MAYBE DISPATCH OR OPER")));
+    PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE NEW")));
     const auto line = _next_token->line_number();
 
-    ast::DispatchExpression dispatch;
-    dispatch._expr = expr;
-    auto is_dispatch = false;
-
-    const auto &oper = _next_token->value();
-    if (_next_token->same_token_type(lexer::Token::AT))
-    {
-        is_dispatch = true;
-        dispatch._base = ast::StaticDispatchExpression();
-
-        PARSER_ADVANCE_AND_RETURN_IF_EOF();
-        PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::TYPEID),
-                               std::get<ast::StaticDispatchExpression>(dispatch._base)._type = parse_type());
-    }
-    else if (_next_token->same_token_type(lexer::Token::DOT))
-    {
-        is_dispatch = true;
-        dispatch._base = ast::VirtualDispatchExpression();
-    }
-
-    if (is_dispatch)
-    {
-        PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::DOT));
-        PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::OBJECTID), dispatch._object = parse_object());
-
-        PARSER_RETURN_IF_FALSE(parse_dispatch_list(dispatch._args));
-
-        PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE MAYBE DISPATCH OR OPER FOR DISPATCH")));
-        return parse_maybe_dispatch_or_oper(make_expr(std::move(dispatch), line));
-    }
+    PARSER_ADVANCE_AND_RETURN_IF_EOF();
+    const auto type = parse_type();
+    PARSER_RETURN_IF_FALSE(type);
 
-    PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE MAYBE DISPATCH OR OPER")));
-    return parse_operators(expr);
-}
\ No newline at end of file
+    PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE NEW")));
+    return make_expr(std::move(ast::NewExpression{type}), line);
+}
@@ -3,8 +3,8 @@
 #include "ast/AST.h"
 #include "decls/Decls.h"
 #include "lexer/Lexer.h"
-#include <functional>
-#include <stack>
+#include "lexer/pipeline/TokenPipeline.h"
+#include <concepts>
 
 #ifdef DEBUG
 #define PARSER_APPEND_LINE_NUM(msg)                                                                                    \
@@ -14,7 +14,7 @@
 #endif // DEBUG
 
 #define PARSER_ACT_ELSE_RETURN(pred, action)                                                                           \
-    PARSER_VERBOSE_ONLY(LOG("Current token: \"" + _next_token->value() + "\""););                                      \
+    PARSER_VERBOSE_ONLY(LOG("Current token: \"" + std::string(_next_token->value()) + "\""););                         \
     if (pred)                                                                                                          \
     {                                                                                                                  \
         action;                                                                                                        \
@@ -24,7 +24,7 @@
         return nullptr;
 
 #define PARSER_RETURN_IF_EOF()                                                                                         \
-    if (!_next_token.has_value())                                                                                      \
+    if (!_next_token)                                                                                                  \
     {                                                                                                                  \
         report_error();                                                                                                \
         return nullptr;                                                                                                \
@@ -35,7 +35,7 @@
     PARSER_RETURN_IF_EOF();
 
 #define PARSER_ADVANCE_ELSE_RETURN(pred)                                                                               \
-    PARSER_VERBOSE_ONLY(LOG("Current token: \"" + _next_token->value() + "\""););                                      \
+    PARSER_VERBOSE_ONLY(LOG("Current token: \"" + std::string(_next_token->value()) + "\""););                         \
     if (pred)                                                                                                          \
         advance_token();                                                                                               \
     else                                                                                                               \
@@ -51,94 +51,178 @@
 
 namespace parser
 {
+class LazyMethodBody;
+
 class Parser
 {
   private:
     std::shared_ptr<lexer::Lexer> _lexer;
-    std::optional<lexer::Token> _next_token;
+    std::unique_ptr<lexer::TokenPipeline> _pipeline; // lexer thread, if it is used
+
+    std::shared_ptr<const lexer::TokenBuffer> _tokens; // whole file or the current batch from the _pipeline
+    lexer::TokenCursor _next_token;
+
+    std::shared_ptr<Arena> _arena; // AST nodes of this file
+    const bool _lazy_bodies;       // skip method bodies, see LazyMethodBody
+
+    std::vector<LazyMethodBody *> _skipped_bodies; // in the order of the file
 
     std::string _error; // error message
 
     inline void advance_token()
     {
-        _next_token = std::move(_lexer->next());
+        ++_next_token;
+        if (!_next_token && _pipeline)
+        {
+            next_batch();
+        }
+    }
+
+    // take the next batch from the _pipeline, leave _next_token after the last token at the end of file
+    void next_batch();
+
+    // parser for the method body that starts at position in tokens of the whole file
+    Parser(const std::shared_ptr<lexer::Lexer> &lexer, const std::shared_ptr<const lexer::TokenBuffer> &tokens,
+           const size_t &position, const std::shared_ptr<Arena> &arena)
+        : _lexer(lexer), _tokens(tokens), _next_token(*_tokens, position), _arena(arena), _lazy_bodies(false)
+    {
     }
 
+    friend class LazyMethodBody;
+
     // error handling
     void report_error();
+    // the first error of the file can be in a body that was skipped before the error, report it instead
+    void report_error_in_skipped_bodies();
     // check type of the _next_token and report error if it has unexpected type
     bool check_next_and_report_error(const lexer::Token::TokenType &expected_type);
 
     // main parse methods
-    std::shared_ptr<ast::Class> parse_class();
-    std::shared_ptr<ast::Feature> parse_feature();
-    std::shared_ptr<ast::Formal> parse_formal();
-    std::shared_ptr<ast::Expression> parse_expr();
+    ast::Class *parse_class();
+    ast::Feature *parse_feature();
+    ast::Formal *parse_formal();
+    ast::Expression *parse_expr();
+    // parse the body of a method and check closing bracket
+    ast::Expression *parse_method_body();
+    // in the lazy mode save the body of a method to parse it later and move to the closing bracket. Return false if
+    // body must be parsed now
+    bool skip_method_body(ast::Feature *feature);
 
     // helper parse methods
 
-    // parse using parse_func and push a result to container while _next_token is expected_lexeme or has expected_type
-    template <class T>
-    bool parse_list(std::vector<T> &container, std::function<T()> func, const lexer::Token::TokenType &expected_type,
+    // parse using parse and push a result to container while _next_token has expected_type. parse is a template
+    // parameter rather than std::function, so the call is direct and can be inlined
+    template <class T, std::invocable Parse>
+    bool parse_list(std::vector<T> &container, const Parse &parse, const lexer::Token::TokenType &expected_type,
                     bool skip_expected_token = false, const lexer::Token::TokenType &cutout_type = lexer::Token::ERROR);
 
-    std::shared_ptr<ast::Expression> parse_if();
-    std::shared_ptr<ast::Expression> parse_while();
-    std::shared_ptr<ast::Expression> parse_case();
-    std::shared_ptr<ast::Case> parse_one_case();
-    std::shared_ptr<ast::Expression> parse_new();
-    std::shared_ptr<ast::Expression> parse_isvoid();
-    std::shared_ptr<ast::Expression> parse_not();
-    std::shared_ptr<ast::Expression> parse_let();
-    std::shared_ptr<ast::Expression> parse_let_define();
-    // try to attach lhs to some operator after this expression
-    std::shared_ptr<ast::Expression> parse_operators(const std::shared_ptr<ast::Expression> &lhs);
-    std::shared_ptr<ast::Expression> parse_neg();
-    std::shared_ptr<ast::Expression> parse_curly_brackets();
-    std::shared_ptr<ast::Expression> parse_paren();
-    // try to attach expr to some method dispatch after this expression
-    std::shared_ptr<ast::Expression> parse_maybe_dispatch_or_oper(const std::shared_ptr<ast::Expression> &expr);
-    bool parse_dispatch_list(std::vector<std::shared_ptr<ast::Expression>> &list);
-
-    std::shared_ptr<ast::Type> parse_type();
-    std::shared_ptr<ast::ObjectExpression> parse_object();
-    // parse expressions starting from object
-    std::shared_ptr<ast::Expression> parse_expr_object();
-    std::shared_ptr<ast::Expression> parse_int();
-    std::shared_ptr<ast::Expression> parse_string();
-    std::shared_ptr<ast::Expression> parse_bool();
+    // ----------------------------- Iterative expression parsing -----------------------------
+    // Nested expressions do not recurse: every unfinished construct waits for its next subexpression in a frame on the
+    // explicit stack, so the native stack depth does not depend on nesting. Methods that open or continue a construct
+    // return nullptr when it waits for a subexpression and report errors to _error
 
-    // parse arithmetic or logical operators
-    std::stack<int> _precedence_level; // prevent right recursion for left associative operators
+    // what the construct does with the next parsed subexpression
+    enum class Continuation
+    {
+        ASSIGN_VALUE,
+        BINARY_RHS,
+        UNARY_OPERAND,
+        IF_PREDICATE,
+        IF_TRUE_PATH,
+        IF_FALSE_PATH,
+        WHILE_PREDICATE,
+        WHILE_BODY,
+        LET_INIT,
+        LET_BODY,
+        CASE_EXPR,
+        CASE_BRANCH,
+        BLOCK_EXPR,
+        PAREN_EXPR,
+        DISPATCH_ARG
+    };
 
-    // operators precedence control
-    int precedence_level(const lexer::Token::TokenType &type) const;
-    inline void save_precedence_level()
+    struct Frame
     {
-        _precedence_level.push(-1);
-    }
-    void restore_precedence_level();
+        Continuation _continuation;
+        int _line_number;
+        int _precedence;                // precedence level of the awaited subexpression
+        size_t _operands;               // parsed subexpressions of this construct start from this index in _operands
+        size_t _cases;                  // parsed branches of case start from this index in _cases
+        lexer::Token::TokenType _token; // operator
+        ast::ObjectExpression *_object; // assigned or defined variable, dispatched method
+        ast::Type *_type;               // type of the defined variable or of the static dispatch
+    };
+
+    std::vector<Frame> _frames;
+    std::vector<ast::Expression *> _operands;
+    std::vector<ast::Case *> _cases;
+
+    Frame *push_frame(const Continuation &continuation, const int &line, const int &precedence = -1);
+    ast::Expression *pop_frame(ast::Expression *expr);
+    // precedence level of the subexpression that is parsed now
     int current_precedence_level() const;
-    void set_precedence_level(const int &lvl);
 
+    // parse an atom or open a construct
+    ast::Expression *parse_operand();
+    // attach dispatches and operators to expr
+    ast::Expression *parse_dispatch_or_operator(ast::Expression *expr);
+    // pass the parsed subexpression to the construct on the top of the stack, get the construct if it is complete
+    ast::Expression *continue_frame(ast::Expression *expr);
+
+    ast::Expression *parse_let_define();
+    ast::Expression *parse_let_body();
+    ast::Expression *parse_case_branch();
+    ast::Expression *parse_dispatch_args(ast::Expression *expr, ast::ObjectExpression *method, ast::Type *type,
+                                         const int &line);
+
+    ast::Type *parse_type();
+    ast::ObjectExpression *parse_object();
+    // parse expressions starting from object
+    ast::Expression *parse_expr_object();
+    ast::Expression *parse_int();
+    ast::Expression *parse_string();
+    ast::Expression *parse_bool();
+    ast::Expression *parse_new();
+
+    // operators precedence control
+    int precedence_level(const lexer::Token::TokenType &type) const;
     bool token_is_left_assoc_operator() const;
     bool token_is_non_assoc_operator() const;
-    template <class T> std::shared_ptr<ast::Expression> parse_operator(const std::shared_ptr<ast::Expression> &lhs);
+
+    ast::Expression *make_unary(const lexer::Token::TokenType &type, ast::Expression *expr, const int &line);
+    ast::Expression *make_binary(const lexer::Token::TokenType &type, ast::Expression *lhs, ast::Expression *rhs,
+                                 const int &line);
+    ast::Expression *make_dispatch(ast::Expression *expr, ast::ObjectExpression *method, ast::Type *type,
+                                   const std::span<ast::Expression *> &args, const int &line);
 
     // create ast::Expression
-    template <class T> std::shared_ptr<ast::Expression> make_expr(T &&variant, const int &line);
+    template <class T> ast::Expression *make_expr(T &&variant, const int &line);
 
   public:
     /**
      * @brief Construct a new Parser
      *
      * @param lexer Lexer for retrieving tokens
+     * @param pipeline Run lexer on its own thread concurrently with parsing instead of lexing the whole file first
+     * @param lazy_bodies Parse only classes and features, semant parses method bodies when it checks them. Syntax
+     * errors are reported as without lazy bodies. Ignored with pipeline, because batches of tokens do not outlive
+     * parsing
      */
-    explicit Parser(const std::shared_ptr<lexer::Lexer> &lexer) : _lexer(lexer), _next_token(_lexer->next())
+    explicit Parser(const std::shared_ptr<lexer::Lexer> &lexer, const bool &pipeline = false,
+                    const bool &lazy_bodies = false)
+        : _lexer(lexer), _pipeline(pipeline ? std::make_unique<lexer::TokenPipeline>(lexer) : nullptr),
+          _tokens(std::make_shared<lexer::TokenBuffer>(pipeline ? lexer::TokenBuffer() : _lexer->tokenize())),
+          _next_token(*_tokens), _arena(std::make_shared<Arena>()), _lazy_bodies(lazy_bodies && !pipeline)
     {
-        _precedence_level.push(-1);
+        if (_pipeline)
+        {
+            next_batch();
+        }
     }
 
+    Parser(const Parser &) = delete;
+    Parser &operator=(const Parser &) = delete;
+
     /**
      * @brief Do parse program
      *
@@ -156,4 +240,35 @@ class Parser
         return _error;
     }
 };
+
+/**
+ * @brief Method body that Parser skipped in the lazy mode
+ *
+ * @details
+ * Body is a range of tokens of the whole file from the opening bracket to the matching closing one. It is parsed by its
+ * own Parser, so bodies of one file can be parsed concurrently into different arenas.
+ */
+class LazyMethodBody : public ast::LazyBody
+{
+  private:
+    std::shared_ptr<lexer::Lexer> _lexer;
+    std::shared_ptr<const lexer::TokenBuffer> _tokens;
+    size_t _begin; // the first token after the opening bracket
+
+  public:
+    /**
+     * @brief Construct a new LazyMethodBody
+     *
+     * @param lexer Lexer of the file
+     * @param tokens Tokens of the whole file
+     * @param begin Index of the first token after the opening bracket
+     */
+    LazyMethodBody(const std::shared_ptr<lexer::Lexer> &lexer, const std::shared_ptr<const lexer::TokenBuffer> &tokens,
+                   const size_t &begin)
+        : _lexer(lexer), _tokens(tokens), _begin(begin)
+    {
+    }
+
+    ast::Expression *parse(const std::shared_ptr<Arena> &arena, std::string &error) override;
+};
 } // namespace parser
\ No newline at end of file
@@ -0,0 +1,776 @@
+#include "ASTCache.h"
+#include "lexer/source/SourceBuffer.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+using namespace parser;
+
+namespace
+{
+constexpr char MAGIC[8] = {'C', 'O', 'O', 'L', 'A', 'S', 'T', '\0'};
+constexpr uint32_t NONE = UINT32_MAX; // index of the absent child
+
+// entry layout: Header, 2 * _symbols words of string offsets and lengths, _records words of record offsets, _words
+// words of records, _strings_size bytes of strings
+struct Header
+{
+    char _magic[8];
+    uint32_t _version;
+    uint32_t _symbols;
+    uint64_t _source_hash;
+    uint64_t _source_size;
+    uint32_t _records; // the last record is the program
+    uint32_t _words;
+    uint64_t _strings_size;
+};
+
+static_assert(sizeof(Header) == 48 && std::is_trivially_copyable_v<Header>);
+
+// record is the kind, the line number and the fields of the node. Lists are the length followed by the elements
+enum Kind : uint32_t
+{
+    PROGRAM,         // classes
+    CLASS,           // type, parent, features
+    ATTR,            // object, type, initializer or NONE, formals
+    METHOD,          // object, type, body or NONE, formals
+    FORMAL,          // object, type
+    CASE,            // object, type, expression
+    ASSIGN,          // object, expression
+    DISPATCH,        // expression, method, arguments
+    STATIC_DISPATCH, // type, expression, method, arguments
+    // binary in the order of BinaryExpression::_base alternatives: lhs, rhs
+    EQ,
+    LE,
+    LT,
+    MINUS,
+    PLUS,
+    DIV,
+    MUL,
+    // unary in the order of UnaryExpression::_base alternatives: expression
+    NEG,
+    ISVOID,
+    NOT,
+    IF,        // predicate, true path, false path
+    WHILE,     // predicate, body
+    LIST,      // expressions
+    LET,       // object, type, initializer or NONE, body
+    CASE_EXPR, // expression, cases
+    NEW,       // type
+    OBJECT,    // object
+    INT,       // value
+    STRING,    // string
+    BOOL       // value
+};
+
+// --------------------------------------- Serialization ---------------------------------------
+class Writer
+{
+  private:
+    std::vector<uint32_t> _words;
+    std::vector<uint32_t> _offsets;
+
+    std::vector<Symbol> _symbols;
+    std::unordered_map<Symbol, uint32_t> _symbol_indexes;
+
+    uint32_t symbol(const Symbol &symbol)
+    {
+        const auto [index, inserted] = _symbol_indexes.emplace(symbol, _symbols.size());
+        if (inserted)
+        {
+            _symbols.push_back(symbol);
+        }
+        return index->second;
+    }
+
+    // append record and return its index
+    uint32_t record(const Kind &kind, const int &line, const std::vector<uint32_t> &fields)
+    {
+        _offsets.push_back(_words.size());
+        _words.push_back(kind);
+        _words.push_back(static_cast<uint32_t>(line));
+        _words.insert(_words.end(), fields.begin(), fields.end());
+
+        return _offsets.size() - 1;
+    }
+
+    template <class T> void write_list(const T &nodes, std::vector<uint32_t> &fields)
+    {
+        // children are written before the parent, so collect their indexes first
+        std::vector<uint32_t> indexes;
+        indexes.reserve(nodes.size());
+        for (const auto *node : nodes)
+        {
+            indexes.push_back(write(*node));
+        }
+
+        fields.push_back(indexes.size());
+        fields.insert(fields.end(), indexes.begin(), indexes.end());
+    }
+
+    uint32_t write(const ast::Class &klass)
+    {
+        std::vector<uint32_t> fields = {symbol(klass._type->_string), symbol(klass._parent->_string)};
+        write_list(klass._features, fields);
+
+        return record(CLASS, klass._line_number, fields);
+    }
+
+    uint32_t write(const ast::Feature &feature)
+    {
+        GUARANTEE_DEBUG(!feature._lazy_body);
+        const auto expr = feature._expr ? write(*feature._expr) : NONE;
+        std::vector<uint32_t> fields = {symbol(feature._object->_object), symbol(feature._type->_string), expr};
+
+        if (std::holds_alternative<ast::MethodFeature>(feature._base))
+        {
+            write_list(std::get<ast::MethodFeature>(feature._base)._formals, fields);
+            return record(METHOD, feature._line_number, fields);
+        }
+
+        fields.push_back(0);
+        return record(ATTR, feature._line_number, fields);
+    }
+
+    uint32_t write(const ast::Formal &formal)
+    {
+        return record(FORMAL, formal._line_number, {symbol(formal._object->_object), symbol(formal._type->_string)});
+    }
+
+    uint32_t write(const ast::Case &kase)
+    {
+        const auto expr = write(*kase._expr);
+        return record(CASE, kase._line_number, {symbol(kase._object->_object), symbol(kase._type->_string), expr});
+    }
+
+    uint32_t write(const ast::Expression &expr)
+    {
+        Kind kind;
+        std::vector<uint32_t> fields;
+
+        std::visit(
+            ast::overloaded{
+                [&](const ast::AssignExpression &assign) {
+                    const auto value = write(*assign._expr);
+                    kind = ASSIGN;
+                    fields = {symbol(assign._object->_object), value};
+                },
+                [&](const ast::DispatchExpression &dispatch) {
+                    const auto object = write(*dispatch._expr);
+                    if (const auto *base = std::get_if<ast::StaticDispatchExpression>(&dispatch._base))
+                    {
+                        kind = STATIC_DISPATCH;
+                        fields.push_back(symbol(base->_type->_string));
+                    }
+                    else
+                    {
+                        kind = DISPATCH;
+                    }
+                    fields.push_back(object);
+                    fields.push_back(symbol(dispatch._object->_object));
+                    write_list(dispatch._args, fields);
+                },
+                [&](const ast::BinaryExpression &binary) {
+                    const auto lhs = write(*binary._lhs);
+                    const auto rhs = write(*binary._rhs);
+                    kind = static_cast<Kind>(EQ + binary._base.index());
+                    fields = {lhs, rhs};
+                },
+                [&](const ast::UnaryExpression &unary) {
+                    const auto operand = write(*unary._expr);
+                    kind = static_cast<Kind>(NEG + unary._base.index());
+                    fields = {operand};
+                },
+                [&](const ast::IfExpression &branch) {
+                    const auto predicate = write(*branch._predicate);
+                    const auto true_path = write(*branch._true_path_expr);
+                    const auto false_path = write(*branch._false_path_expr);
+                    kind = IF;
+                    fields = {predicate, true_path, false_path};
+                },
+                [&](const ast::WhileExpression &loop) {
+                    const auto predicate = write(*loop._predicate);
+                    const auto body = write(*loop._body_expr);
+                    kind = WHILE;
+                    fields = {predicate, body};
+                },
+                [&](const ast::ListExpression &list) {
+                    kind = LIST;
+                    write_list(list._exprs, fields);
+                },
+                [&](const ast::LetExpression &let) {
+                    const auto init = let._expr ? write(*let._expr) : NONE;
+                    const auto body = write(*let._body_expr);
+                    kind = LET;
+                    fields = {symbol(let._object->_object), symbol(let._type->_string), init, body};
+                },
+                [&](const ast::CaseExpression &kase) {
+                    const auto object = write(*kase._expr);
+                    kind = CASE_EXPR;
+                    fields = {object};
+                    write_list(kase._cases, fields);
+                },
+                [&](const ast::NewExpression &alloc) {
+                    kind = NEW;
+                    fields = {symbol(alloc._type->_string)};
+                },
+                [&](const ast::ObjectExpression &object) {
+                    kind = OBJECT;
+                    fields = {symbol(object._object)};
+                },
+                [&](const ast::IntExpression &value) {
+                    kind = INT;
+                    fields = {static_cast<uint32_t>(value._value)};
+                },
+                [&](const ast::StringExpression &value) {
+                    kind = STRING;
+                    fields = {symbol(value._string)};
+                },
+                [&](const ast::BoolExpression &value) {
+                    kind = BOOL;
+                    fields = {value._value};
+                }},
+            expr._data);
+
+        return record(kind, expr._line_number, fields);
+    }
+
+    template <class T> static void append(std::string &entry, const T *data, const size_t &size)
+    {
+        entry.append(reinterpret_cast<const char *>(data), sizeof(T) * size);
+    }
+
+  public:
+    std::string write(const ast::Program &program, const uint64_t &hash, const uint64_t &size)
+    {
+        std::vector<uint32_t> fields;
+        write_list(program._classes, fields);
+        record(PROGRAM, program._line_number, fields);
+
+        std::vector<uint32_t> string_table;
+        std::string strings;
+        for (const auto &symbol : _symbols)
+        {
+            string_table.push_back(strings.size());
+            string_table.push_back(symbol.str().size());
+            strings += symbol.str();
+        }
+
+        Header header;
+        std::memcpy(header._magic, MAGIC, sizeof(MAGIC));
+        header._version = ASTCache::FORMAT_VERSION;
+        header._symbols = _symbols.size();
+        header._source_hash = hash;
+        header._source_size = size;
+        header._records = _offsets.size();
+        header._words = _words.size();
+        header._strings_size = strings.size();
+
+        std::string entry;
+        append(entry, &header, 1);
+        append(entry, string_table.data(), string_table.size());
+        append(entry, _offsets.data(), _offsets.size());
+        append(entry, _words.data(), _words.size());
+        entry += strings;
+
+        return entry;
+    }
+};
+
+// --------------------------------------- Deserialization ---------------------------------------
+// every read is checked, so a malformed entry makes the Reader invalid instead of crashing
+class Reader
+{
+  private:
+    struct Node
+    {
+        Kind _kind;
+        void *_node;
+    };
+
+    const std::string_view _entry;
+    Arena &_arena;
+
+    Header _header;
+    size_t _table_begin;   // byte offset of the string table
+    size_t _offsets_begin; // byte offset of the record offsets
+    size_t _words_begin;   // byte offset of the records
+    size_t _strings_begin; // byte offset of the strings
+
+    std::vector<Symbol> _symbols;
+    std::vector<Node> _nodes;
+
+    size_t _record;     // index of the current record
+    size_t _pos;        // next word of the current record
+    size_t _record_end; // word after the current record
+
+    bool _valid;
+
+    uint32_t word_at(const size_t &byte_offset) const
+    {
+        uint32_t word;
+        std::memcpy(&word, _entry.data() + byte_offset, sizeof(word));
+        return word;
+    }
+
+    uint32_t next()
+    {
+        if (_pos >= _record_end)
+        {
+            _valid = false;
+            return 0;
+        }
+        return word_at(_words_begin + sizeof(uint32_t) * _pos++);
+    }
+
+    // list length that fits into the rest of the record
+    uint32_t next_count()
+    {
+        const auto count = next();
+        if (count > _record_end - _pos)
+        {
+            _valid = false;
+            return 0;
+        }
+        return count;
+    }
+
+    Symbol next_symbol()
+    {
+        const auto index = next();
+        if (index >= _symbols.size())
+        {
+            _valid = false;
+            return Symbol();
+        }
+        return _symbols[index];
+    }
+
+    // child must be built before the parent and must have kind from [first, last]
+    template <class T> T *next_child(const Kind &first, const Kind &last)
+    {
+        const auto index = next();
+        if (index >= _record || _nodes[index]._kind < first || _nodes[index]._kind > last)
+        {
+            _valid = false;
+            return nullptr;
+        }
+        return static_cast<T *>(_nodes[index]._node);
+    }
+
+    ast::Expression *next_expr()
+    {
+        return next_child<ast::Expression>(ASSIGN, BOOL);
+    }
+
+    ast::Expression *next_optional_expr()
+    {
+        if (_pos < _record_end && word_at(_words_begin + sizeof(uint32_t) * _pos) == NONE)
+        {
+            _pos++;
+            return nullptr;
+        }
+        return next_expr();
+    }
+
+    template <class T> T *make_symbol_node(const Symbol &symbol)
+    {
+        auto *const node = _arena.make<T>();
+        if constexpr (std::is_same_v<T, ast::Type>)
+        {
+            node->_string = symbol;
+        }
+        else
+        {
+            node->_object = symbol;
+        }
+        return node;
+    }
+
+    bool read_header()
+    {
+        if (_entry.size() < sizeof(Header))
+        {
+            return false;
+        }
+        std::memcpy(&_header, _entry.data(), sizeof(Header));
+
+        _table_begin = sizeof(Header);
+        _offsets_begin = _table_begin + sizeof(uint32_t) * 2 * static_cast<size_t>(_header._symbols);
+        _words_begin = _offsets_begin + sizeof(uint32_t) * static_cast<size_t>(_header._records);
+        _strings_begin = _words_begin + sizeof(uint32_t) * static_cast<size_t>(_header._words);
+
+        return std::memcmp(_header._magic, MAGIC, sizeof(MAGIC)) == 0 &&
+               _header._version == ASTCache::FORMAT_VERSION && _header._records != 0 &&
+               _header._strings_size <= _entry.size() && _strings_begin == _entry.size() - _header._strings_size;
+    }
+
+    bool read_symbols()
+    {
+        _symbols.reserve(_header._symbols);
+        for (size_t i = 0; i < _header._symbols; i++)
+        {
+            const uint64_t offset = word_at(_table_begin + sizeof(uint32_t) * 2 * i);
+            const uint64_t length = word_at(_table_begin + sizeof(uint32_t) * (2 * i + 1));
+            if (offset + length > _header._strings_size)
+            {
+                return false;
+            }
+            _symbols.emplace_back(_entry.substr(_strings_begin + offset, length));
+        }
+
+        return true;
+    }
+
+    void *read_record(const Kind &kind, const int &line)
+    {
+        switch (kind)
+        {
+        case CLASS: {
+            auto *const klass = _arena.make<ast::Class>();
+            klass->_line_number = line;
+            klass->_type = make_symbol_node<ast::Type>(next_symbol());
+            klass->_parent = make_symbol_node<ast::Type>(next_symbol());
+
+            const auto count = next_count();
+            klass->_features.reserve(count);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                klass->_features.push_back(next_child<ast::Feature>(ATTR, METHOD));
+            }
+            return klass;
+        }
+        case ATTR:
+        case METHOD: {
+            auto *const feature = _arena.make<ast::Feature>();
+            feature->_line_number = line;
+            feature->_object = make_symbol_node<ast::ObjectExpression>(next_symbol());
+            feature->_type = make_symbol_node<ast::Type>(next_symbol());
+            feature->_expr = next_optional_expr();
+
+            const auto count = next_count();
+            if (kind == METHOD)
+            {
+                ast::MethodFeature method;
+                method._formals.reserve(count);
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    method._formals.push_back(next_child<ast::Formal>(FORMAL, FORMAL));
+                }
+                feature->_base = std::move(method);
+            }
+            else if (count != 0)
+            {
+                _valid = false;
+            }
+            return feature;
+        }
+        case FORMAL: {
+            auto *const formal = _arena.make<ast::Formal>();
+            formal->_line_number = line;
+            formal->_object = make_symbol_node<ast::ObjectExpression>(next_symbol());
+            formal->_type = make_symbol_node<ast::Type>(next_symbol());
+            return formal;
+        }
+        case CASE: {
+            auto *const kase = _arena.make<ast::Case>();
+            kase->_line_number = line;
+            kase->_object = make_symbol_node<ast::ObjectExpression>(next_symbol());
+            kase->_type = make_symbol_node<ast::Type>(next_symbol());
+            kase->_expr = next_expr();
+            return kase;
+        }
+        }
+
+        auto *const expr = _arena.make<ast::Expression>();
+        expr->_line_number = line;
+        expr->_data = read_expr(kind);
+        return expr;
+    }
+
+    decltype(ast::Expression::_data) read_expr(const Kind &kind)
+    {
+        switch (kind)
+        {
+        case ASSIGN: {
+            ast::AssignExpression assign;
+            assign._object = make_symbol_node<ast::ObjectExpression>(next_symbol());
+            assign._expr = next_expr();
+            return assign;
+        }
+        case DISPATCH:
+        case STATIC_DISPATCH: {
+            ast::DispatchExpression dispatch;
+            if (kind == STATIC_DISPATCH)
+            {
+                dispatch._base = ast::StaticDispatchExpression{make_symbol_node<ast::Type>(next_symbol())};
+            }
+            dispatch._expr = next_expr();
+            dispatch._object = make_symbol_node<ast::ObjectExpression>(next_symbol());
+            dispatch._args = read_list<ast::Expression>(ASSIGN, BOOL);
+            return dispatch;
+        }
+        case EQ:
+        case LE:
+        case LT:
+        case MINUS:
+        case PLUS:
+        case DIV:
+        case MUL: {
+            ast::BinaryExpression binary;
+            switch (kind)
+            {
+            case EQ:
+                binary._base = ast::EqExpression();
+                break;
+            case LE:
+                binary._base = ast::LEExpression();
+                break;
+            case LT:
+                binary._base = ast::LTExpression();
+                break;
+            case MINUS:
+                binary._base = ast::MinusExpression();
+                break;
+            case PLUS:
+                binary._base = ast::PlusExpression();
+                break;
+            case DIV:
+                binary._base = ast::DivExpression();
+                break;
+            case MUL:
+                binary._base = ast::MulExpression();
+                break;
+            }
+            binary._lhs = next_expr();
+            binary._rhs = next_expr();
+            return binary;
+        }
+        case NEG:
+        case ISVOID:
+        case NOT: {
+            ast::UnaryExpression unary;
+            switch (kind)
+            {
+            case NEG:
+                unary._base = ast::NegExpression();
+                break;
+            case ISVOID:
+                unary._base = ast::IsVoidExpression();
+                break;
+            case NOT:
+                unary._base = ast::NotExpression();
+                break;
+            }
+            unary._expr = next_expr();
+            return unary;
+        }
+        case IF: {
+            ast::IfExpression branch;
+            branch._predicate = next_expr();
+            branch._true_path_expr = next_expr();
+            branch._false_path_expr = next_expr();
+            return branch;
+        }
+        case WHILE: {
+            ast::WhileExpression loop;
+            loop._predicate = next_expr();
+            loop._body_expr = next_expr();
+            return loop;
+        }
+        case LIST:
+            return ast::ListExpression{read_list<ast::Expression>(ASSIGN, BOOL)};
+        case LET: {
+            ast::LetExpression let;
+            let._object = make_symbol_node<ast::ObjectExpression>(next_symbol());
+            let._type = make_symbol_node<ast::Type>(next_symbol());
+            let._expr = next_optional_expr();
+            let._body_expr = next_expr();
+            return let;
+        }
+        case CASE_EXPR: {
+            ast::CaseExpression kase;
+            kase._expr = next_expr();
+            kase._cases = read_list<ast::Case>(CASE, CASE);
+            return kase;
+        }
+        case NEW:
+            return ast::NewExpression{make_symbol_node<ast::Type>(next_symbol())};
+        case OBJECT:
+            return ast::ObjectExpression{next_symbol()};
+        case INT:
+            return ast::IntExpression{static_cast<int>(next())};
+        case STRING:
+            return ast::StringExpression{next_symbol()};
+        case BOOL:
+            return ast::BoolExpression{next() != 0};
+        }
+
+        _valid = false;
+        return ast::BoolExpression{false};
+    }
+
+    std::shared_ptr<ast::Program> read_program(const std::string &file_name, const int &line)
+    {
+        const auto program = std::make_shared<ast::Program>();
+        program->_line_number = line;
+
+        const auto count = next_count();
+        program->_classes.reserve(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            auto *const klass = next_child<ast::Class>(CLASS, CLASS);
+            if (klass)
+            {
+                klass->_file_name = file_name;
+            }
+            program->_classes.push_back(klass);
+        }
+
+        return program;
+    }
+
+    template <class T> std::span<T *> read_list(const Kind &first, const Kind &last)
+    {
+        std::vector<T *> nodes(next_count());
+        for (auto &node : nodes)
+        {
+            node = next_child<T>(first, last);
+        }
+        return _arena.make_array(nodes);
+    }
+
+  public:
+    Reader(const std::string_view &entry, Arena &arena) : _entry(entry), _arena(arena), _valid(true)
+    {
+    }
+
+    std::shared_ptr<ast::Program> read(const std::string &file_name, const uint64_t &hash, const uint64_t &size)
+    {
+        if (!read_header() || _header._source_hash != hash || _header._source_size != size || !read_symbols())
+        {
+            return nullptr;
+        }
+
+        _nodes.resize(_header._records);
+        for (_record = 0; _record < _header._records; _record++)
+        {
+            _pos = word_at(_offsets_begin + sizeof(uint32_t) * _record);
+            _record_end = _record + 1 < _header._records
+                              ? word_at(_offsets_begin + sizeof(uint32_t) * (_record + 1))
+                              : _header._words;
+            if (_pos > _record_end || _record_end > _header._words)
+            {
+                return nullptr;
+            }
+
+            const auto kind = static_cast<Kind>(next());
+            const auto line = static_cast<int>(next());
+            if (!_valid || kind > BOOL || (kind == PROGRAM) != (_record + 1 == _header._records))
+            {
+                return nullptr;
+            }
+
+            // the last record is the program, it is not a node in the arena
+            const auto program = kind == PROGRAM ? read_program(file_name, line) : nullptr;
+            if (kind != PROGRAM)
+            {
+                _nodes[_record] = {kind, read_record(kind, line)};
+            }
+
+            if (!_valid || _pos != _record_end)
+            {
+                return nullptr;
+            }
+            if (program)
+            {
+                return program;
+            }
+        }
+
+        return nullptr;
+    }
+};
+} // namespace
+
+ASTCache::ASTCache(const std::string &directory) : _directory(directory)
+{
+    std::error_code error;
+    std::filesystem::create_directories(_directory, error);
+}
+
+std::string ASTCache::entry_name(const uint64_t &hash) const
+{
+    static constexpr char DIGITS[] = "0123456789abcdef";
+
+    std::string name(16, '0');
+    for (int i = 15; i >= 0; i--)
+    {
+        name[i] = DIGITS[(hash >> (4 * (15 - i))) & 0xf];
+    }
+
+    return (std::filesystem::path(_directory) / (name + ".ast")).string();
+}
+
+uint64_t ASTCache::hash(const std::string_view &source)
+{
+    uint64_t hash = 0xcbf29ce484222325;
+    for (const auto &ch : source)
+    {
+        hash = (hash ^ static_cast<uint8_t>(ch)) * 0x100000001b3;
+    }
+
+    return hash;
+}
+
+std::shared_ptr<ast::Program> ASTCache::load(const std::string &file_name, const std::string_view &source) const
+{
+    const auto hash_value = hash(source);
+    const lexer::SourceBuffer entry(entry_name(hash_value), true);
+    if (!entry.is_open())
+    {
+        return nullptr;
+    }
+
+    auto arena = std::make_shared<Arena>();
+    auto program = Reader(entry.content(), *arena).read(file_name, hash_value, source.size());
+    if (program)
+    {
+        program->_arenas.push_back(std::move(arena));
+    }
+
+    return program;
+}
+
+void ASTCache::store(const std::string_view &source, const ast::Program &program) const
+{
+    const auto hash_value = hash(source);
+    const auto entry = Writer().write(program, hash_value, source.size());
+
+    // write to the unique temporary file and rename it, so concurrent compilations never see a partial entry
+    const auto name = entry_name(hash_value);
+    const auto tmp_name = name + "." + std::to_string(getpid()) + "." +
+                          std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream out(tmp_name, std::ios::binary);
+        if (!out.write(entry.data(), entry.size()))
+        {
+            out.close();
+            std::error_code error;
+            std::filesystem::remove(tmp_name, error);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tmp_name, name, error);
+    if (error)
+    {
+        std::filesystem::remove(tmp_name, error);
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "ast/AST.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace parser
+{
+
+/**
+ * @brief Directory of parsed files in binary format keyed by the hash of the source
+ *
+ * @details
+ * Entry is a header, a table of interned strings, a table of record offsets and records. Every AST node is a record
+ * of 32-bit words that refers to its children by record index, symbols are indexes in the string table. Records are
+ * written in post-order, so the loader builds the AST in one pass over the mapped file without recursion. Entry does
+ * not contain pointers or file names, so files with the same contents share it.
+ *
+ * Entries with other FORMAT_VERSION, other source hash or size and malformed entries are treated as missing and are
+ * rewritten. Cache is best-effort: store failures are ignored.
+ */
+class ASTCache
+{
+  public:
+    // increase on any change of the entry layout or of the AST that the parser builds
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+  private:
+    const std::string _directory;
+
+    std::string entry_name(const uint64_t &hash) const;
+
+  public:
+    /**
+     * @brief Construct a new ASTCache
+     *
+     * @param directory Cache directory. It is created if it does not exist
+     */
+    explicit ASTCache(const std::string &directory);
+
+    /**
+     * @brief Load AST of the source file
+     *
+     * @param file_name Name of the source file for the classes
+     * @param source Contents of the source file
+     * @return AST or nullptr if there is no valid entry for the source
+     */
+    std::shared_ptr<ast::Program> load(const std::string &file_name, const std::string_view &source) const;
+
+    /**
+     * @brief Save AST of the source file
+     *
+     * @param source Contents of the source file
+     * @param program AST that parser built from the source
+     */
+    void store(const std::string_view &source, const ast::Program &program) const;
+
+    /**
+     * @brief Hash the source file contents
+     *
+     * @param source Contents of the source file
+     * @return 64-bit FNV-1a hash
+     */
+    static uint64_t hash(const std::string_view &source);
+};
+
+} // namespace parser
@@ -0,0 +1,23 @@
+#include "Pass.h"
+
+using namespace passes;
+
+std::vector<semant::ClassNode *> Pass::classes(const std::shared_ptr<semant::ClassNode> &root)
+{
+    // inheritance chains can be deep, so walk the tree iteratively
+    std::vector<semant::ClassNode *> classes;
+    std::vector<semant::ClassNode *> stack = {root.get()};
+    while (!stack.empty())
+    {
+        auto *const klass = stack.back();
+        stack.pop_back();
+
+        classes.push_back(klass);
+        for (auto child = klass->_children.rbegin(); child != klass->_children.rend(); child++)
+        {
+            stack.push_back(child->get());
+        }
+    }
+
+    return classes;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "semant/Semant.h"
+
+namespace passes
+{
+
+/**
+ * @brief Transformation of the checked program
+ *
+ * @details
+ * Passes run after semant on the typed AST that both backends consume, so transformation is written once for MIPS and
+ * LLVM. Pass can rewrite the expression in place by assigning its _data, but the result must keep types that semant
+ * inferred.
+ */
+class Pass
+{
+  protected:
+    /**
+     * @brief Collect classes of the hierarchy
+     *
+     * @param root Root of the class hierarchy
+     * @return Classes in preorder
+     */
+    static std::vector<semant::ClassNode *> classes(const std::shared_ptr<semant::ClassNode> &root);
+
+    /**
+     * @brief Call the function for every subexpression of the expression in the order of evaluation
+     *
+     * @tparam F Function that takes ast::Expression *
+     * @param expr Expression
+     * @param f Function
+     */
+    template <class F> static void for_each_child(ast::Expression *expr, F &&f)
+    {
+        std::visit(
+            ast::overloaded{[&](ast::AssignExpression &assign) { f(assign._expr); },
+                            [&](ast::DispatchExpression &dispatch) {
+                                f(dispatch._expr);
+                                for (auto *const arg : dispatch._args)
+                                {
+                                    f(arg);
+                                }
+                            },
+                            [&](ast::BinaryExpression &binary) {
+                                f(binary._lhs);
+                                f(binary._rhs);
+                            },
+                            [&](ast::UnaryExpression &unary) { f(unary._expr); },
+                            [&](ast::IfExpression &branch) {
+                                f(branch._predicate);
+                                f(branch._true_path_expr);
+                                f(branch._false_path_expr);
+                            },
+                            [&](ast::WhileExpression &loop) {
+                                f(loop._predicate);
+                                f(loop._body_expr);
+                            },
+                            [&](ast::ListExpression &list) {
+                                for (auto *const e : list._exprs)
+                                {
+                                    f(e);
+                                }
+                            },
+                            [&](ast::LetExpression &let) {
+                                if (let._expr)
+                                {
+                                    f(let._expr);
+                                }
+                                f(let._body_expr);
+                            },
+                            [&](ast::CaseExpression &kase) {
+                                f(kase._expr);
+                                for (auto *const branch : kase._cases)
+                                {
+                                    f(branch->_expr);
+                                }
+                            },
+                            [&](ast::NewExpression &) {}, [&](ast::ObjectExpression &) {}, [&](ast::IntExpression &) {},
+                            [&](ast::StringExpression &) {}, [&](ast::BoolExpression &) {}},
+            expr->_data);
+    }
+
+  public:
+    virtual ~Pass() = default;
+
+    /**
+     * @brief Run the pass
+     *
+     * @param root Root of the checked class hierarchy
+     * @return True if program was changed
+     */
+    virtual bool run(const std::shared_ptr<semant::ClassNode> &root) = 0;
+};
+
+}; // namespace passes
@@ -0,0 +1,307 @@
+#include "ConstantFolding.h"
+#include <limits>
+
+using namespace passes;
+
+bool ConstantFolding::run(const std::shared_ptr<semant::ClassNode> &root)
+{
+    _changed = false;
+
+    for (const auto *klass : classes(root))
+    {
+        // methods of basic classes are implemented by runtime
+        if (semant::Semant::is_basic_type(klass->_class->_type))
+        {
+            continue;
+        }
+
+        for (const auto *feature : klass->_class->_features)
+        {
+            if (feature->_expr)
+            {
+                _assigned.clear();
+                collect_assigned(feature->_expr);
+
+                _constants.clear();
+                fold(feature->_expr);
+            }
+        }
+    }
+
+    return _changed;
+}
+
+void ConstantFolding::collect_assigned(ast::Expression *expr)
+{
+    if (const auto *assign = std::get_if<ast::AssignExpression>(&expr->_data))
+    {
+        _assigned.insert(assign->_object->_object);
+    }
+
+    for_each_child(expr, [&](ast::Expression *child) { collect_assigned(child); });
+}
+
+bool ConstantFolding::is_constant(const Data &data)
+{
+    return std::holds_alternative<ast::IntExpression>(data) || std::holds_alternative<ast::BoolExpression>(data) ||
+           std::holds_alternative<ast::StringExpression>(data);
+}
+
+void ConstantFolding::fold(ast::Expression *expr)
+{
+    // children are folded first, so operands of the expression are literals if they are constants
+    const auto result = std::visit(
+        ast::overloaded{
+            [&](ast::BinaryExpression &binary) -> std::optional<Data> {
+                fold(binary._lhs);
+                fold(binary._rhs);
+                return fold_binary(binary);
+            },
+            [&](ast::UnaryExpression &unary) -> std::optional<Data> {
+                fold(unary._expr);
+                return fold_unary(unary);
+            },
+            [&](ast::DispatchExpression &dispatch) -> std::optional<Data> {
+                for_each_child(expr, [&](ast::Expression *child) { fold(child); });
+                return fold_dispatch(dispatch);
+            },
+            [&](ast::IfExpression &branch) -> std::optional<Data> {
+                for_each_child(expr, [&](ast::Expression *child) { fold(child); });
+
+                const auto *predicate = std::get_if<ast::BoolExpression>(&branch._predicate->_data);
+                const auto *taken = predicate && predicate->_value ? branch._true_path_expr : branch._false_path_expr;
+                if (predicate && taken->_type->_string == expr->_type->_string)
+                {
+                    return taken->_data;
+                }
+                return std::nullopt;
+            },
+            [&](ast::LetExpression &let) -> std::optional<Data> { return fold_let(expr, let); },
+            [&](ast::CaseExpression &kase) -> std::optional<Data> {
+                fold(kase._expr);
+                for (auto *const branch : kase._cases)
+                {
+                    fold_in_scope(branch->_expr, branch->_object->_object, std::nullopt);
+                }
+                return std::nullopt;
+            },
+            [&](ast::ObjectExpression &object) -> std::optional<Data> {
+                const auto constant = _constants.find(object._object);
+                if (constant != _constants.end())
+                {
+                    return constant->second;
+                }
+                return std::nullopt;
+            },
+            [&](auto &) -> std::optional<Data> {
+                for_each_child(expr, [&](ast::Expression *child) { fold(child); });
+                return std::nullopt;
+            }},
+        expr->_data);
+
+    // node is replaced after the visit, because the visit refers to its old data. Type of the node is not changed
+    if (result)
+    {
+        expr->_data = *result;
+        _changed = true;
+    }
+}
+
+void ConstantFolding::fold_in_scope(ast::Expression *expr, const Symbol &name, const std::optional<Data> &value)
+{
+    const auto outer = _constants.find(name);
+    const auto outer_value = outer != _constants.end() ? std::optional<Data>(outer->second) : std::nullopt;
+
+    if (value)
+    {
+        _constants.insert_or_assign(name, *value);
+    }
+    else
+    {
+        _constants.erase(name);
+    }
+
+    fold(expr);
+
+    if (outer_value)
+    {
+        _constants.insert_or_assign(name, *outer_value);
+    }
+    else
+    {
+        _constants.erase(name);
+    }
+}
+
+std::optional<ConstantFolding::Data> ConstantFolding::fold_let(ast::Expression *expr, ast::LetExpression &let)
+{
+    // initializer is in the outer scope
+    if (let._expr)
+    {
+        fold(let._expr);
+    }
+
+    const auto &name = let._object->_object;
+    std::optional<Data> value;
+    if (!_assigned.contains(name))
+    {
+        if (let._expr)
+        {
+            // variable of Object can be assigned to the constant, but its uses keep the type Object
+            if (is_constant(let._expr->_data) && let._type->_string == let._expr->_type->_string)
+            {
+                value = let._expr->_data;
+            }
+        }
+        else if (semant::Semant::is_int(let._type))
+        {
+            value = ast::IntExpression{0};
+        }
+        else if (semant::Semant::is_bool(let._type))
+        {
+            value = ast::BoolExpression{false};
+        }
+        else if (semant::Semant::is_string(let._type))
+        {
+            value = ast::StringExpression{Symbol("")};
+        }
+    }
+
+    fold_in_scope(let._body_expr, name, value);
+
+    // all uses of the variable are replaced, so the binding is not needed
+    if (value && let._body_expr->_type->_string == expr->_type->_string)
+    {
+        return let._body_expr->_data;
+    }
+    return std::nullopt;
+}
+
+std::optional<ConstantFolding::Data> ConstantFolding::fold_binary(const ast::BinaryExpression &binary)
+{
+    // equality of basic classes compares values
+    if (std::holds_alternative<ast::EqExpression>(binary._base))
+    {
+        const auto &lhs = binary._lhs->_data;
+        const auto &rhs = binary._rhs->_data;
+        if (lhs.index() != rhs.index() || !is_constant(lhs))
+        {
+            return std::nullopt;
+        }
+
+        bool equal = false;
+        if (const auto *number = std::get_if<ast::IntExpression>(&lhs))
+        {
+            equal = number->_value == std::get<ast::IntExpression>(rhs)._value;
+        }
+        else if (const auto *boolean = std::get_if<ast::BoolExpression>(&lhs))
+        {
+            equal = boolean->_value == std::get<ast::BoolExpression>(rhs)._value;
+        }
+        else
+        {
+            equal = std::get<ast::StringExpression>(lhs)._string == std::get<ast::StringExpression>(rhs)._string;
+        }
+        return ast::BoolExpression{equal};
+    }
+
+    const auto *lhs = std::get_if<ast::IntExpression>(&binary._lhs->_data);
+    const auto *rhs = std::get_if<ast::IntExpression>(&binary._rhs->_data);
+    if (!lhs || !rhs)
+    {
+        return std::nullopt;
+    }
+
+    const int32_t l = lhs->_value;
+    const int32_t r = rhs->_value;
+    int32_t result = 0;
+    bool traps = false;
+    return std::visit(
+        ast::overloaded{[&](const ast::LTExpression &) -> std::optional<Data> { return ast::BoolExpression{l < r}; },
+                        [&](const ast::LEExpression &) -> std::optional<Data> { return ast::BoolExpression{l <= r}; },
+                        [&](const ast::PlusExpression &) -> std::optional<Data> {
+                            traps = __builtin_add_overflow(l, r, &result);
+                            return traps ? std::nullopt : std::optional<Data>(ast::IntExpression{result});
+                        },
+                        [&](const ast::MinusExpression &) -> std::optional<Data> {
+                            traps = __builtin_sub_overflow(l, r, &result);
+                            return traps ? std::nullopt : std::optional<Data>(ast::IntExpression{result});
+                        },
+                        [&](const ast::MulExpression &) -> std::optional<Data> {
+                            traps = __builtin_mul_overflow(l, r, &result);
+                            return traps ? std::nullopt : std::optional<Data>(ast::IntExpression{result});
+                        },
+                        [&](const ast::DivExpression &) -> std::optional<Data> {
+                            traps = r == 0 || (l == std::numeric_limits<int32_t>::min() && r == -1);
+                            return traps ? std::nullopt : std::optional<Data>(ast::IntExpression{l / r});
+                        },
+                        [&](const ast::EqExpression &) -> std::optional<Data> {
+                            SHOULD_NOT_REACH_HERE();
+                            return std::nullopt;
+                        }},
+        binary._base);
+}
+
+std::optional<ConstantFolding::Data> ConstantFolding::fold_unary(const ast::UnaryExpression &unary)
+{
+    const auto &operand = unary._expr->_data;
+    return std::visit(
+        ast::overloaded{[&](const ast::NotExpression &) -> std::optional<Data> {
+                            const auto *boolean = std::get_if<ast::BoolExpression>(&operand);
+                            return boolean ? std::optional<Data>(ast::BoolExpression{!boolean->_value}) : std::nullopt;
+                        },
+                        [&](const ast::NegExpression &) -> std::optional<Data> {
+                            const auto *number = std::get_if<ast::IntExpression>(&operand);
+                            if (!number || number->_value == std::numeric_limits<int32_t>::min())
+                            {
+                                return std::nullopt;
+                            }
+                            return ast::IntExpression{-number->_value};
+                        },
+                        [&](const ast::IsVoidExpression &) -> std::optional<Data> {
+                            // literals are objects
+                            return is_constant(operand) ? std::optional<Data>(ast::BoolExpression{false})
+                                                        : std::nullopt;
+                        }},
+        unary._base);
+}
+
+std::optional<ConstantFolding::Data> ConstantFolding::fold_dispatch(const ast::DispatchExpression &dispatch)
+{
+    // String has no subclasses, so dispatch on the literal calls the method of String
+    const auto *receiver = std::get_if<ast::StringExpression>(&dispatch._expr->_data);
+    if (!receiver)
+    {
+        return std::nullopt;
+    }
+
+    const std::string &str = receiver->_string;
+    const auto &method = dispatch._object->_object;
+
+    if (method == StringMethodsNames[StringMethods::LENGTH])
+    {
+        return ast::IntExpression{static_cast<int>(str.size())};
+    }
+
+    if (method == StringMethodsNames[StringMethods::CONCAT])
+    {
+        const auto *arg = std::get_if<ast::StringExpression>(&dispatch._args[0]->_data);
+        return arg ? std::optional<Data>(ast::StringExpression{Symbol(str + arg->_string)}) : std::nullopt;
+    }
+
+    if (method == StringMethodsNames[StringMethods::SUBSTR])
+    {
+        const auto *index = std::get_if<ast::IntExpression>(&dispatch._args[0]->_data);
+        const auto *length = std::get_if<ast::IntExpression>(&dispatch._args[1]->_data);
+
+        // substr out of range aborts the program
+        if (!index || !length || index->_value < 0 || length->_value < 0 ||
+            static_cast<int64_t>(index->_value) + length->_value > static_cast<int64_t>(str.size()))
+        {
+            return std::nullopt;
+        }
+        return ast::StringExpression{Symbol(str.substr(index->_value, length->_value))};
+    }
+
+    return std::nullopt;
+}
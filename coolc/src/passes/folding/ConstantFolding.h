@@ -0,0 +1,50 @@
+#pragma once
+
+#include "passes/Pass.h"
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace passes
+{
+
+/**
+ * @brief Evaluate constant subexpressions of Int, Bool and String
+ *
+ * @details
+ * Arithmetic, comparisons, not, neg and isvoid of literals are evaluated, as well as length, concat and substr of
+ * String literals. Operations that fail at runtime are left as is: division by zero, overflow that traps on MIPS and
+ * substr out of range. If with the constant predicate is replaced with the taken branch when they have the same type.
+ *
+ * Let variable of Int, Bool or String that is never assigned in the method and is initialized with the constant is
+ * replaced with this constant, so the let itself is replaced with its body. Backends emit literals as references to
+ * constant objects, see codegen::Data::int_const, so folded expressions neither allocate nor compute.
+ */
+class ConstantFolding : public Pass
+{
+  private:
+    using Data = decltype(ast::Expression::_data);
+
+    std::unordered_map<Symbol, Data> _constants; // let variables in scope that are replaced with constants
+    std::unordered_set<Symbol> _assigned;        // names of all variables that are assigned in the current feature
+    bool _changed = false;
+
+    void collect_assigned(ast::Expression *expr);
+
+    void fold(ast::Expression *expr);
+
+    // fold the expression in the scope where the variable is bound to the constant or is not a constant
+    void fold_in_scope(ast::Expression *expr, const Symbol &name, const std::optional<Data> &value);
+
+    std::optional<Data> fold_let(ast::Expression *expr, ast::LetExpression &let);
+    static std::optional<Data> fold_binary(const ast::BinaryExpression &binary);
+    static std::optional<Data> fold_unary(const ast::UnaryExpression &unary);
+    static std::optional<Data> fold_dispatch(const ast::DispatchExpression &dispatch);
+
+    static bool is_constant(const Data &data);
+
+  public:
+    bool run(const std::shared_ptr<semant::ClassNode> &root) override;
+};
+
+}; // namespace passes
@@ -0,0 +1,193 @@
+#include "Unboxing.h"
+
+using namespace passes;
+
+bool Unboxing::run(const std::shared_ptr<semant::ClassNode> &root)
+{
+    std::vector<ast::Expression *> bodies;
+    for (const auto *klass : classes(root))
+    {
+        // methods of basic classes are implemented by runtime
+        if (semant::Semant::is_basic_type(klass->_class->_type))
+        {
+            continue;
+        }
+
+        for (const auto *feature : klass->_class->_features)
+        {
+            if (feature->_expr)
+            {
+                bodies.push_back(feature->_expr);
+            }
+        }
+    }
+
+    _candidates.clear();
+    for (auto *const body : bodies)
+    {
+        collect_candidates(body);
+    }
+
+    // the variable that escapes can make its initializer and assigned values escape
+    do
+    {
+        _escaped.clear();
+        _boxed_reads.clear();
+        _assignments.clear();
+        for (auto *const body : bodies)
+        {
+            visit(body, BOXED);
+        }
+
+        for (const auto &[let, reads] : _boxed_reads)
+        {
+            if (reads >= _assignments[let])
+            {
+                _escaped.insert(let);
+            }
+        }
+
+        for (auto *const let : _escaped)
+        {
+            _candidates.erase(let);
+        }
+    } while (!_escaped.empty());
+
+    for (auto *const let : _candidates)
+    {
+        let->_unboxed = true;
+    }
+
+    PASSES_VERBOSE_ONLY(LOG(std::to_string(_candidates.size()) + " variables are unboxed"));
+
+    return !_candidates.empty();
+}
+
+void Unboxing::collect_candidates(ast::Expression *expr)
+{
+    if (auto *const let = std::get_if<ast::LetExpression>(&expr->_data))
+    {
+        if (semant::Semant::is_int(let->_type) || semant::Semant::is_bool(let->_type))
+        {
+            _candidates.insert(let);
+        }
+    }
+
+    for_each_child(expr, [&](ast::Expression *child) { collect_candidates(child); });
+}
+
+ast::LetExpression *Unboxing::candidate(const Symbol &name) const
+{
+    for (auto variable = _scope.rbegin(); variable != _scope.rend(); variable++)
+    {
+        if (variable->first == name)
+        {
+            return variable->second && _candidates.contains(variable->second) ? variable->second : nullptr;
+        }
+    }
+
+    // formal or field
+    return nullptr;
+}
+
+void Unboxing::visit(ast::Expression *expr, const Context &context)
+{
+    // results of the nested expressions are used as the result of the parent
+    const auto nested = context == DISCARDED ? DISCARDED : BOXED;
+
+    std::visit(ast::overloaded{
+                   [&](ast::ObjectExpression &object) {
+                       auto *const let = candidate(object._object);
+                       if (let && context != NATIVE)
+                       {
+                           _boxed_reads[let] += _weight;
+                       }
+                   },
+                   [&](ast::AssignExpression &assign) {
+                       assign._discarded = context == DISCARDED;
+
+                       auto *const let = candidate(assign._object->_object);
+                       if (let && context != DISCARDED)
+                       {
+                           _escaped.insert(let);
+                       }
+                       if (let)
+                       {
+                           _assignments[let] += _weight;
+                       }
+                       visit(assign._expr, let ? NATIVE : BOXED);
+                   },
+                   [&](ast::DispatchExpression &dispatch) {
+                       for (auto *const arg : dispatch._args)
+                       {
+                           visit(arg, BOXED);
+                       }
+                       visit(dispatch._expr, BOXED);
+                   },
+                   [&](ast::BinaryExpression &binary) {
+                       // equality of other classes compares objects
+                       const auto operands = !std::holds_alternative<ast::EqExpression>(binary._base) ||
+                                                     semant::Semant::is_int(binary._lhs->_type) ||
+                                                     semant::Semant::is_bool(binary._lhs->_type)
+                                                 ? NATIVE
+                                                 : BOXED;
+                       visit(binary._lhs, operands);
+                       visit(binary._rhs, operands);
+                   },
+                   [&](ast::UnaryExpression &unary) {
+                       visit(unary._expr,
+                             std::holds_alternative<ast::IsVoidExpression>(unary._base) ? BOXED : NATIVE);
+                   },
+                   [&](ast::IfExpression &branch) {
+                       visit(branch._predicate, NATIVE);
+                       visit(branch._true_path_expr, nested);
+                       visit(branch._false_path_expr, nested);
+                   },
+                   [&](ast::WhileExpression &loop) { visit_loop(loop); },
+                   [&](ast::ListExpression &list) {
+                       for (auto *const e : list._exprs.first(list._exprs.size() - 1))
+                       {
+                           visit(e, DISCARDED);
+                       }
+                       visit(list._exprs.back(), nested);
+                   },
+                   [&](ast::LetExpression &let) {
+                       // initializer is in the outer scope
+                       if (let._expr)
+                       {
+                           visit(let._expr, _candidates.contains(&let) ? NATIVE : BOXED);
+                       }
+                       _assignments[&let] += _weight;
+
+                       _scope.emplace_back(let._object->_object, &let);
+                       visit(let._body_expr, nested);
+                       _scope.pop_back();
+                   },
+                   [&](ast::CaseExpression &kase) {
+                       visit(kase._expr, BOXED);
+                       for (auto *const branch : kase._cases)
+                       {
+                           _scope.emplace_back(branch->_object->_object, nullptr);
+                           visit(branch->_expr, nested);
+                           _scope.pop_back();
+                       }
+                   },
+                   [&](ast::NewExpression &) {}, [&](ast::IntExpression &) {}, [&](ast::StringExpression &) {},
+                   [&](ast::BoolExpression &) {}},
+               expr->_data);
+}
+
+void Unboxing::visit_loop(ast::WhileExpression &loop)
+{
+    const auto weight = _weight;
+    if (_loop_depth++ < MAX_LOOP_DEPTH)
+    {
+        _weight *= LOOP_WEIGHT;
+    }
+
+    visit(loop._predicate, NATIVE);
+    visit(loop._body_expr, DISCARDED);
+
+    _loop_depth--;
+    _weight = weight;
+}
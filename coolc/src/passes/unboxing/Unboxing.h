@@ -0,0 +1,65 @@
+#pragma once
+
+#include "passes/Pass.h"
+#include <unordered_map>
+#include <unordered_set>
+
+namespace passes
+{
+
+/**
+ * @brief Find Int and Bool let variables that can hold native values instead of objects
+ *
+ * @details
+ * Every expression is used in one of three contexts: native context needs only the value, such as operands of
+ * arithmetic and comparisons, predicates, not and neg; discarded context does not use the result, such as all
+ * expressions of the block except the last one and the body of the loop; boxed context needs the object, such as
+ * arguments and receivers of dispatches, values of fields and results of methods. Branches of if and case, bodies of
+ * let and the last expression of the block are discarded if their parent is discarded, and they are boxed otherwise.
+ *
+ * Variable escapes if it is assigned in the context that uses the result of the assignment. Boxed variable allocates
+ * the object for every computed value that is assigned to it, and unboxed variable allocates the object for every
+ * read in the boxed context, so variable also escapes if it is read in boxed contexts more often than it is assigned.
+ * There is no profile, so every loop is assumed to run LOOP_WEIGHT times. Initializer of the variable and values
+ * assigned to it are in native context if the variable does not escape, so variables are dropped until no variable
+ * escapes. Variables that remain are marked as ast::LetExpression::_unboxed: backend can keep them in native slots and
+ * box the value when it is read in the boxed or discarded context, the result of their assignment is never used.
+ * Assignments in the discarded context are marked as ast::AssignExpression::_discarded, so backend that keeps fields
+ * unboxed does not box the assigned value.
+ */
+class Unboxing : public Pass
+{
+  private:
+    enum Context
+    {
+        NATIVE,
+        DISCARDED,
+        BOXED
+    };
+
+    static constexpr int64_t LOOP_WEIGHT = 8;
+    static constexpr int MAX_LOOP_DEPTH = 16; // weight of deeper loops is the same
+
+    std::unordered_set<ast::LetExpression *> _candidates;
+    std::unordered_set<ast::LetExpression *> _escaped;
+
+    // estimated number of executions of boxed reads and assignments of every variable
+    std::unordered_map<ast::LetExpression *, int64_t> _boxed_reads;
+    std::unordered_map<ast::LetExpression *, int64_t> _assignments;
+    int64_t _weight = 1; // estimated number of executions of the current expression
+    int _loop_depth = 0; // number of loops around the current expression
+
+    // let variables in scope, nullptr for case variables that hide them
+    std::vector<std::pair<Symbol, ast::LetExpression *>> _scope;
+
+    ast::LetExpression *candidate(const Symbol &name) const;
+
+    void collect_candidates(ast::Expression *expr);
+    void visit(ast::Expression *expr, const Context &context);
+    void visit_loop(ast::WhileExpression &loop);
+
+  public:
+    bool run(const std::shared_ptr<semant::ClassNode> &root) override;
+};
+
+}; // namespace passes
@@ -1,4 +1,5 @@
 #include "semant/Semant.h"
+#include "utils/parallel/Parallel.h"
 
 using namespace semant;
 
@@ -16,13 +17,20 @@ std::shared_ptr<ast::Program> Semant::merge_to_one_program(const std::vector<std
     for (const auto &p : programs)
     {
         program->_classes.insert(program->_classes.end(), p->_classes.begin(), p->_classes.end());
+        program->_arenas.insert(program->_arenas.end(), p->_arenas.begin(), p->_arenas.end());
     }
 
     return program;
 }
 
-Semant::Semant(std::vector<std::shared_ptr<ast::Program>> programs) : _program(merge_to_one_program(programs))
+Semant::Semant(std::vector<std::shared_ptr<ast::Program>> programs)
+    : _program(merge_to_one_program(programs)), _arena(std::make_shared<Arena>()), _current_class(nullptr),
+      _cache(ASTCacheDir.empty() || LazyMethodBodies ? nullptr : std::make_shared<SemantCache>(ASTCacheDir))
 {
+    if (_program)
+    {
+        _program->_arenas.push_back(_arena);
+    }
 }
 
 // ---------------------------------------- CLASS CHECK ----------------------------------------
@@ -30,42 +38,42 @@ Semant::Semant(std::vector<std::shared_ptr<ast::Program>> programs) : _program(m
 std::shared_ptr<ClassNode> Semant::make_basic_class(
     const std::string &name, const std::string &parent,
     const std::vector<std::pair<std::string, std::vector<std::string>>> &methods,
-    const std::vector<std::shared_ptr<ast::Type>> &fields)
+    const std::vector<ast::Type *> &fields)
 {
     const auto klass = std::make_shared<ClassNode>();
-    klass->_class = std::make_shared<ast::Class>();
-    klass->_class->_type = std::make_shared<ast::Type>();
-    klass->_class->_parent = std::make_shared<ast::Type>();
+    klass->_class = _arena->make<ast::Class>();
+    klass->_class->_type = _arena->make<ast::Type>();
+    klass->_class->_parent = _arena->make<ast::Type>();
 
-    klass->_class->_type->_string = name;
-    klass->_class->_parent->_string = parent;
+    klass->_class->_type->_string = Symbol(name);
+    klass->_class->_parent->_string = Symbol(parent);
     for (const auto &m : methods)
     {
-        const auto feature = std::make_shared<ast::Feature>();
+        const auto feature = _arena->make<ast::Feature>();
         feature->_base = ast::MethodFeature();
 
         // method name
-        feature->_object = std::make_shared<ast::ObjectExpression>();
-        feature->_object->_object = m.first;
+        feature->_object = _arena->make<ast::ObjectExpression>();
+        feature->_object->_object = Symbol(m.first);
 
         // method ret type
         GUARANTEE_DEBUG(!methods.empty());
-        feature->_type = std::make_shared<ast::Type>();
-        feature->_type->_string = m.second.front();
+        feature->_type = _arena->make<ast::Type>();
+        feature->_type->_string = Symbol(m.second.front());
 
         // method args
         for (auto i = 1; i < m.second.size(); i++)
         {
             // formal name
-            std::get<ast::MethodFeature>(feature->_base)._formals.push_back(std::make_shared<ast::Formal>());
+            std::get<ast::MethodFeature>(feature->_base)._formals.push_back(_arena->make<ast::Formal>());
             std::get<ast::MethodFeature>(feature->_base)._formals.back()->_object =
-                std::make_shared<ast::ObjectExpression>();
+                _arena->make<ast::ObjectExpression>();
             std::get<ast::MethodFeature>(feature->_base)._formals.back()->_object->_object =
-                static_cast<std::string>(DUMMY_ARG_SUFFIX) + std::to_string(i);
+                Symbol(static_cast<std::string>(DUMMY_ARG_SUFFIX) + std::to_string(i));
 
             // formal type
-            std::get<ast::MethodFeature>(feature->_base)._formals.back()->_type = std::make_shared<ast::Type>();
-            std::get<ast::MethodFeature>(feature->_base)._formals.back()->_type->_string = m.second[i];
+            std::get<ast::MethodFeature>(feature->_base)._formals.back()->_type = _arena->make<ast::Type>();
+            std::get<ast::MethodFeature>(feature->_base)._formals.back()->_type->_string = Symbol(m.second[i]);
         }
 
         klass->_class->_features.push_back(feature);
@@ -75,24 +83,24 @@ std::shared_ptr<ClassNode> Semant::make_basic_class(
     static auto N = 0;
     for (const auto &f : fields)
     {
-        const auto feature = std::make_shared<ast::Feature>();
+        const auto feature = _arena->make<ast::Feature>();
         feature->_base = ast::AttrFeature();
 
-        feature->_object = std::make_shared<ast::ObjectExpression>();
+        feature->_object = _arena->make<ast::ObjectExpression>();
         feature->_type = f;
-        feature->_object->_object = static_cast<std::string>(DUMMY_FIELD_SUFFIX) + std::to_string(N);
+        feature->_object->_object = Symbol(static_cast<std::string>(DUMMY_FIELD_SUFFIX) + std::to_string(N));
 
         klass->_class->_features.push_back(feature);
 
         N++;
     }
 
-    _classes.insert({name, klass});
+    _classes.insert({klass->_class->_type->_string, klass});
     return klass;
 }
 
 bool Semant::check_class_hierarchy_for_cycle(const std::shared_ptr<ClassNode> &klass,
-                                             std::unordered_map<std::string, int> &visited, const int &loop)
+                                             std::unordered_map<Symbol, int> &visited, const int &loop)
 {
     const auto &class_name = klass->_class->_type->_string;
 
@@ -112,23 +120,52 @@ bool Semant::check_class_hierarchy_for_cycle(const std::shared_ptr<ClassNode> &k
     return true;
 }
 
-bool Semant::is_basic_type(const std::shared_ptr<ast::Type> &type)
+void Semant::build_method_tables()
+{
+    // class and its parent, parents are filled before children
+    std::vector<std::pair<ClassNode *, const ClassNode *>> stack = {{_root.get(), nullptr}};
+    while (!stack.empty())
+    {
+        const auto [klass, parent] = stack.back();
+        stack.pop_back();
+
+        // the first definition wins if method is multiply defined, such class is rejected later
+        for (const auto &feature : klass->_class->_features)
+        {
+            if (std::holds_alternative<ast::MethodFeature>(feature->_base))
+            {
+                klass->_methods.try_emplace(feature->_object->_object, feature);
+            }
+        }
+        if (parent)
+        {
+            klass->_methods.insert(parent->_methods.begin(), parent->_methods.end());
+        }
+
+        for (const auto &child : klass->_children)
+        {
+            stack.emplace_back(child.get(), klass);
+        }
+    }
+}
+
+bool Semant::is_basic_type(ast::Type *type)
 {
     return is_int(type) || is_bool(type) || is_string(type) || same_type(type, Object) || same_type(type, Io) ||
            is_self_type(type) || is_empty_type(type) || same_type(type, Empty);
 }
 
-bool Semant::is_trivial_type(const std::shared_ptr<ast::Type> &type)
+bool Semant::is_trivial_type(ast::Type *type)
 {
     return is_int(type) || is_bool(type) || is_string(type);
 }
 
-bool Semant::is_inherit_allowed(const std::shared_ptr<ast::Type> &type)
+bool Semant::is_inherit_allowed(ast::Type *type)
 {
     return !(is_int(type) || is_bool(type) || is_string(type) || is_self_type(type) || is_empty_type(type));
 }
 
-bool Semant::is_native_type(const std::shared_ptr<ast::Type> &type)
+bool Semant::is_native_type(ast::Type *type)
 {
     return is_native_int(type) || is_native_bool(type) || is_native_string(type);
 }
@@ -184,31 +221,33 @@ bool Semant::check_class_hierarchy()
         parent->second->_children.push_back(klass);
     }
 
-    std::unordered_map<std::string, int> visited;
+    std::unordered_map<Symbol, int> visited;
     for (const auto &klass : _classes)
     {
         visited.insert({klass.first, -1});
     }
 
+    // only classes of the program can form a cycle. Visit them in the order of the program, so the report does not
+    // depend on the order of the symbols in the hash table
     auto loop_num = 0;
     auto cycle_num = 1;
-    for (const auto &klass : _classes)
+    for (const auto *klass : _program->_classes)
     {
-        if (visited[klass.first] != -1)
+        const auto &name = klass->_type->_string;
+        if (visited[name] != -1)
         {
             continue;
         }
         // format error
-        if (!check_class_hierarchy_for_cycle(klass.second, visited, loop_num))
+        if (!check_class_hierarchy_for_cycle(_classes[name], visited, loop_num))
         {
             _error_line_number = -1;
             _error_message += "Cycle " + std::to_string(cycle_num) + ":\n";
             cycle_num++;
-            for (const auto &klass : visited)
+            for (const auto *class_node : _program->_classes)
             {
-                if (klass.second == loop_num)
+                if (visited[class_node->_type->_string] == loop_num)
                 {
-                    const auto &class_node = _classes[klass.first]->_class;
                     const auto &class_name = class_node->_type->_string;
 
                     _error_message += class_node->_file_name + ":" + std::to_string(class_node->_line_number) +
@@ -236,7 +275,7 @@ bool Semant::check_main()
 
     auto found_main = false;
 
-    const auto main_class = _classes.find(MainClassName);
+    const auto main_class = _classes.find(Symbol(MainClassName));
     SEMANT_RETURN_IF_FALSE_WITH_ERROR(main_class != _classes.end(), "Class Main is not defined.", -1, false);
 
     for (const auto &feature : main_class->second->_class->_features)
@@ -255,7 +294,7 @@ bool Semant::check_main()
     }
 
     SEMANT_RETURN_IF_FALSE_WITH_ERROR(found_main, "No 'main' method in class Main.",
-                                      _classes[MainClassName]->_class->_line_number, false);
+                                      main_class->second->_class->_line_number, false);
 
     SEMANT_VERBOSE_ONLY(LOG_EXIT("CHECK MAIN"));
     return true;
@@ -267,17 +306,17 @@ bool Semant::check_classes()
     // add Object to hierarchy
     SEMANT_VERBOSE_ONLY(LOG_ENTER("CREATE BASIC CLASSES"));
 
-    Empty = std::make_shared<ast::Type>();
-    Empty->_string = EMPTY_TYPE_NAME;
+    Empty = _arena->make<ast::Type>();
+    Empty->_string = Symbol(EMPTY_TYPE_NAME);
 
-    NativeInt = std::make_shared<ast::Type>();
-    NativeInt->_string = NATIVE_INT_TYPE_NAME;
+    NativeInt = _arena->make<ast::Type>();
+    NativeInt->_string = Symbol(NATIVE_INT_TYPE_NAME);
 
-    NativeBool = std::make_shared<ast::Type>();
-    NativeBool->_string = NATIVE_BOOL_TYPE_NAME;
+    NativeBool = _arena->make<ast::Type>();
+    NativeBool->_string = Symbol(NATIVE_BOOL_TYPE_NAME);
 
-    NativeString = std::make_shared<ast::Type>();
-    NativeString->_string = NATIVE_STRING_TYPE_NAME;
+    NativeString = _arena->make<ast::Type>();
+    NativeString->_string = Symbol(NATIVE_STRING_TYPE_NAME);
 
     _root = make_basic_class(BaseClassesNames[BaseClasses::OBJECT], Empty->_string,
                              {{ObjectMethodsNames[ObjectMethods::ABORT], {BaseClassesNames[BaseClasses::OBJECT]}},
@@ -333,6 +372,17 @@ bool Semant::check_classes()
     // 3. Check main method in Main class
     SEMANT_RETURN_IF_FALSE(check_main(), false);
 
+    // 4. Hierarchy has no cycles, so it is a tree
+    _hierarchy = ClassHierarchy(_root);
+    build_method_tables();
+    if (_cache)
+    {
+        for (auto *const klass : _hierarchy.classes())
+        {
+            klass->_signature = SemantCache::signature(*klass->_class);
+        }
+    }
+
     return true;
 }
 
@@ -340,8 +390,12 @@ bool Semant::check_classes()
 
 std::pair<std::shared_ptr<ClassNode>, std::shared_ptr<ast::Program>> Semant::infer_types_and_check()
 {
-    SEMANT_RETURN_IF_FALSE(check_classes(), std::make_pair(nullptr, nullptr));
-    SEMANT_RETURN_IF_FALSE(check_expressions(), std::make_pair(nullptr, nullptr));
+    if (!check_classes() || !check_expressions())
+    {
+        // without lazy bodies parser reports syntax errors before semant runs, so they win over the semantic error
+        parse_lazy_bodies();
+        return std::make_pair(nullptr, nullptr);
+    }
 
     // now we are not interested in SELF_TYPE in class hierarchy
     _root->_children.erase(std::remove_if(_root->_children.begin(), _root->_children.end(),
@@ -350,7 +404,7 @@ std::pair<std::shared_ptr<ClassNode>, std::shared_ptr<ast::Program>> Semant::inf
     return std::make_pair(_root, _program);
 }
 
-bool Semant::check_expression_in_method(const std::shared_ptr<ast::Feature> &feature, Scope &scope)
+bool Semant::check_expression_in_method(ast::Feature *feature, Scope &scope)
 {
     const auto &name = feature->_object->_object;
     const auto &ret_type_name = feature->_type->_string;
@@ -360,7 +414,7 @@ bool Semant::check_expression_in_method(const std::shared_ptr<ast::Feature> &fea
     scope.push_scope();
 
     const auto &this_method = std::get<ast::MethodFeature>(feature->_base);
-    const auto &klass = _classes[_current_class->_string]->_class;
+    const auto &klass = _classes.at(_current_class->_string)->_class;
 
     // return type is defined
     SEMANT_RETURN_IF_FALSE_WITH_ERROR(check_exists(feature->_type),
@@ -376,7 +430,7 @@ bool Semant::check_expression_in_method(const std::shared_ptr<ast::Feature> &fea
                                       feature->_line_number, false);
 
     // parent method
-    const auto parent_feature = find_method(name, klass->_type, false);
+    const auto parent_feature = find_method(name, klass->_parent);
     ast::MethodFeature parent_method;
 
     if (parent_feature)
@@ -433,6 +487,7 @@ bool Semant::check_expression_in_method(const std::shared_ptr<ast::Feature> &fea
         formal_num++;
     }
 
+    SEMANT_RETURN_IF_FALSE(parse_lazy_body(feature), false);
     if (feature->_expr)
     {
         const auto &body_type = feature->_expr->_type;
@@ -450,7 +505,7 @@ bool Semant::check_expression_in_method(const std::shared_ptr<ast::Feature> &fea
     return true;
 }
 
-bool Semant::check_expression_in_attribute(const std::shared_ptr<ast::Feature> &attr, Scope &scope)
+bool Semant::check_expression_in_attribute(ast::Feature *attr, Scope &scope)
 {
     const auto &name = attr->_object->_object;
     const auto &type = attr->_type;
@@ -478,21 +533,19 @@ bool Semant::check_expression_in_attribute(const std::shared_ptr<ast::Feature> &
     return true;
 }
 
-bool Semant::check_expressions_in_class(const std::shared_ptr<ClassNode> &node, Scope &scope)
+bool Semant::check_class_features(const ClassNode &node, Scope &scope)
 {
-    SEMANT_VERBOSE_ONLY(LOG_ENTER("CHECK CLASS \"" + node->_class->_type->_string + "\""));
-    _error_file_name = node->_class->_file_name; // save for error messages
+    _error_file_name = node._class->_file_name; // save for error messages
 
     scope.push_scope();
 
-    const auto prev_class = _current_class;
-    _current_class = node->_class->_type; // current SELF_TYPE
+    _current_class = node._class->_type; // current SELF_TYPE
 
     // Don't check basic classes
     if (!is_basic_type(_current_class))
     {
         // 1. Add class attributes to current scope and check if redefined
-        for (const auto &feature : node->_class->_features)
+        for (const auto &feature : node._class->_features)
         {
             const auto &feature_name = feature->_object->_object;
             if (std::holds_alternative<ast::AttrFeature>(feature->_base))
@@ -521,8 +574,21 @@ bool Semant::check_expressions_in_class(const std::shared_ptr<ClassNode> &node,
             }
         }
 
-        // 2. Check features types
-        for (const auto &feature : node->_class->_features)
+        // 2. Take types from the cache if neither the class nor classes it depends on changed
+        std::vector<ast::Expression *> expressions;
+        uint64_t hash = 0;
+        if (_cache)
+        {
+            hash = SemantCache::hash(*node._class, expressions);
+            if (load_checked_class(expressions, hash))
+            {
+                return true;
+            }
+            _dependencies.clear();
+        }
+
+        // 3. Check features types
+        for (const auto &feature : node._class->_features)
         {
             if (std::holds_alternative<ast::AttrFeature>(feature->_base))
             {
@@ -533,9 +599,24 @@ bool Semant::check_expressions_in_class(const std::shared_ptr<ClassNode> &node,
                 SEMANT_RETURN_IF_FALSE(check_expression_in_method(feature, scope), false);
             }
         }
+
+        if (_cache)
+        {
+            store_checked_class(node, expressions, hash);
+        }
     }
 
-    // 3. Check childs with parent scope
+    return true;
+}
+
+bool Semant::check_expressions_in_class(const std::shared_ptr<ClassNode> &node, Scope &scope)
+{
+    SEMANT_VERBOSE_ONLY(LOG_ENTER("CHECK CLASS \"" + node->_class->_type->_string + "\""));
+
+    const auto prev_class = _current_class;
+    SEMANT_RETURN_IF_FALSE(check_class_features(*node, scope), false);
+
+    // 4. Check childs with parent scope
     for (const auto &child : node->_children)
     {
         SEMANT_RETURN_IF_FALSE(check_expressions_in_class(child, scope), false);
@@ -548,8 +629,163 @@ bool Semant::check_expressions_in_class(const std::shared_ptr<ClassNode> &node,
     return true;
 }
 
+bool Semant::parse_lazy_bodies()
+{
+    auto jobs = Jobs;
+    DEBUG_ONLY(if (TraceParser) { jobs = 1; }); // traces are not synchronized
+
+    std::vector<ast::Feature *> methods;
+    for (const auto &klass : _program->_classes)
+    {
+        std::copy_if(klass->_features.begin(), klass->_features.end(), std::back_inserter(methods),
+                     [](const auto &feature) { return feature->_lazy_body; });
+    }
+
+    // every part of methods is parsed to its own arena, several parts per thread balance long bodies
+    const auto parts = std::min(methods.size(), static_cast<size_t>(jobs) * 4);
+    std::vector<std::shared_ptr<Arena>> arenas(parts);
+    std::vector<std::string> errors(methods.size());
+
+    parallel_for(jobs, parts, [&](const size_t &part) {
+        arenas[part] = std::make_shared<Arena>();
+        for (auto i = methods.size() * part / parts; i < methods.size() * (part + 1) / parts; i++)
+        {
+            methods[i]->_expr = methods[i]->_lazy_body->parse(arenas[part], errors[i]);
+            methods[i]->_lazy_body = nullptr;
+        }
+    });
+    _program->_arenas.insert(_program->_arenas.end(), arenas.begin(), arenas.end());
+
+    // report the first error in the program order
+    for (size_t i = 0; i < methods.size(); i++)
+    {
+        SEMANT_RETURN_IF_FALSE_WITH_ERROR(methods[i]->_expr, errors[i], -1, false);
+    }
+
+    return true;
+}
+
+bool Semant::parse_lazy_body(ast::Feature *method)
+{
+    if (method->_lazy_body)
+    {
+        std::string error;
+        method->_expr = method->_lazy_body->parse(_arena, error);
+        SEMANT_RETURN_IF_FALSE_WITH_ERROR(method->_expr, error, -1, false);
+
+        method->_lazy_body = nullptr;
+    }
+
+    return true;
+}
+
+bool Semant::check_expressions_in_range(const size_t &begin, const size_t &end, size_t &failed)
+{
+    const auto &classes = _hierarchy.classes();
+
+    // classes which attributes are in the scope: ancestors of the class
+    std::vector<const ClassNode *> path;
+    for (auto *klass = classes[begin]; klass != _root.get();)
+    {
+        klass = _classes.at(klass->_class->_parent->_string).get();
+        path.push_back(klass);
+    }
+    std::reverse(path.begin(), path.end());
+
+    Scope scope(SelfType);
+    for (const auto *klass : path)
+    {
+        // ancestors were checked by other parts, their errors are reported by them
+        scope.push_scope();
+        if (!is_basic_type(klass->_class->_type))
+        {
+            for (const auto &feature : klass->_class->_features)
+            {
+                if (std::holds_alternative<ast::AttrFeature>(feature->_base))
+                {
+                    scope.add_if_can(feature->_object->_object, feature->_type);
+                }
+            }
+        }
+    }
+
+    for (failed = begin; failed < end; failed++)
+    {
+        // in preorder the parent of the class is on the path
+        const auto &klass = *classes[failed];
+        while (!path.empty() && !ClassHierarchy::conforms(klass, *path.back()))
+        {
+            scope.pop_scope();
+            path.pop_back();
+        }
+
+        SEMANT_RETURN_IF_FALSE(check_class_features(klass, scope), false);
+        path.push_back(&klass);
+    }
+
+    return true;
+}
+
+bool Semant::check_expressions_in_parallel(const int &jobs)
+{
+    const auto classes = _hierarchy.classes().size();
+
+    // every part checks a range of classes in the sequential order on its own copy of Semant, so scopes, the current
+    // class and errors are not shared. Part stops on the first error, later classes of the range do not matter
+    const auto parts = std::min(classes, static_cast<size_t>(jobs) * 4);
+    std::vector<std::unique_ptr<Semant>> workers(parts);
+    std::vector<size_t> failed(parts);
+    std::vector<std::exception_ptr> exceptions(parts);
+
+    parallel_for(jobs, parts, [&](const size_t &part) {
+        workers[part] = std::make_unique<Semant>(*this);
+        workers[part]->_arena = std::make_shared<Arena>(); // for lazy bodies
+        try
+        {
+            if (workers[part]->check_expressions_in_range(classes * part / parts, classes * (part + 1) / parts,
+                                                          failed[part]))
+            {
+                failed[part] = classes;
+            }
+        }
+        catch (...)
+        {
+            exceptions[part] = std::current_exception();
+        }
+    });
+
+    for (const auto &worker : workers)
+    {
+        _program->_arenas.push_back(worker->_arena);
+    }
+
+    // sequential check reports the failure of the first class in preorder
+    const auto first = std::min_element(failed.begin(), failed.end()) - failed.begin();
+    if (failed[first] == classes)
+    {
+        return true;
+    }
+
+    if (exceptions[first])
+    {
+        std::rethrow_exception(exceptions[first]);
+    }
+
+    _error_message = workers[first]->_error_message;
+    _error_file_name = workers[first]->_error_file_name;
+    _error_line_number = workers[first]->_error_line_number;
+    return false;
+}
+
 bool Semant::check_expressions()
 {
+    auto jobs = Jobs;
+    DEBUG_ONLY(if (TraceParser || TraceSemant) { jobs = 1; }); // traces are not synchronized
+    if (jobs != 1)
+    {
+        return check_expressions_in_parallel(jobs);
+    }
+
     Scope scope(SelfType);
 
     SEMANT_RETURN_IF_FALSE(check_expressions_in_class(_root, scope), false);
@@ -560,7 +796,7 @@ bool Semant::check_expressions()
 
 // -------------------------------------- Infer Expression Type --------------------------------------
 
-bool Semant::infer_expression_type(const std::shared_ptr<ast::Expression> &expr, Scope &scope)
+bool Semant::infer_expression_type(ast::Expression *expr, Scope &scope)
 {
     expr->_type = std::visit(
         ast::overloaded{[&](const ast::BoolExpression &bool_expr) { return Bool; },
@@ -588,7 +824,7 @@ bool Semant::infer_expression_type(const std::shared_ptr<ast::Expression> &expr,
 }
 
 // -------------------------------------- Infer Expression Type Helpers --------------------------------------
-std::shared_ptr<ast::Type> Semant::infer_object_type(const ast::ObjectExpression &obj, Scope &scope)
+ast::Type *Semant::infer_object_type(const ast::ObjectExpression &obj, Scope &scope)
 {
     const auto expr = scope.find(obj._object);
     SEMANT_RETURN_IF_FALSE_WITH_ERROR(expr, "Undeclared identifier " + obj._object + ".", -1, nullptr);
@@ -596,7 +832,7 @@ std::shared_ptr<ast::Type> Semant::infer_object_type(const ast::ObjectExpression
     return expr;
 }
 
-std::shared_ptr<ast::Type> Semant::infer_new_type(const ast::NewExpression &alloc)
+ast::Type *Semant::infer_new_type(const ast::NewExpression &alloc)
 {
     const auto &type = alloc._type;
 
@@ -610,7 +846,7 @@ std::shared_ptr<ast::Type> Semant::infer_new_type(const ast::NewExpression &allo
     return type;
 }
 
-std::shared_ptr<ast::Type> Semant::infer_let_type(const ast::LetExpression &let, Scope &scope)
+ast::Type *Semant::infer_let_type(const ast::LetExpression &let, Scope &scope)
 {
     const auto &var_type = let._type;
     const auto &var_name = let._object->_object;
@@ -645,7 +881,7 @@ std::shared_ptr<ast::Type> Semant::infer_let_type(const ast::LetExpression &let,
     return let._body_expr->_type;
 }
 
-std::shared_ptr<ast::Type> Semant::infer_loop_type(const ast::WhileExpression &loop, Scope &scope)
+ast::Type *Semant::infer_loop_type(const ast::WhileExpression &loop, Scope &scope)
 {
     SEMANT_VERBOSE_ONLY(LOG_ENTER("INFER LOOP TYPE"));
 
@@ -659,7 +895,7 @@ std::shared_ptr<ast::Type> Semant::infer_loop_type(const ast::WhileExpression &l
     return Object;
 }
 
-std::shared_ptr<ast::Type> Semant::infer_unary_type(const ast::UnaryExpression &unary, Scope &scope)
+ast::Type *Semant::infer_unary_type(const ast::UnaryExpression &unary, Scope &scope)
 {
     SEMANT_VERBOSE_ONLY(LOG_ENTER("INFER UNARY TYPE"));
 
@@ -672,14 +908,14 @@ std::shared_ptr<ast::Type> Semant::infer_unary_type(const ast::UnaryExpression &
                                        SEMANT_RETURN_IF_FALSE_WITH_ERROR(is_bool(expr_type),
                                                                          "Argument of 'not' has type " +
                                                                              expr_type->_string + " instead of Bool.",
-                                                                         -1, (std::shared_ptr<ast::Type>)nullptr);
+                                                                         -1, (ast::Type *)nullptr);
                                        return Bool;
                                    },
                                    [&](const ast::NegExpression &neg) {
                                        SEMANT_RETURN_IF_FALSE_WITH_ERROR(is_int(expr_type),
                                                                          "Argument of '~' has type " +
                                                                              expr_type->_string + " instead of Int.",
-                                                                         -1, (std::shared_ptr<ast::Type>)nullptr);
+                                                                         -1, (ast::Type *)nullptr);
                                        return Int;
                                    }},
                    unary._base);
@@ -690,11 +926,11 @@ std::shared_ptr<ast::Type> Semant::infer_unary_type(const ast::UnaryExpression &
     return result;
 }
 
-std::shared_ptr<ast::Type> Semant::infer_binary_type(const ast::BinaryExpression &binary, Scope &scope)
+ast::Type *Semant::infer_binary_type(const ast::BinaryExpression &binary, Scope &scope)
 {
     SEMANT_VERBOSE_ONLY(LOG_ENTER("INFER BINARY TYPE"));
 
-    std::shared_ptr<ast::Type> result;
+    ast::Type *result = nullptr;
     SEMANT_RETURN_IF_FALSE(infer_expression_type(binary._lhs, scope), nullptr);
     SEMANT_RETURN_IF_FALSE(infer_expression_type(binary._rhs, scope), nullptr);
 
@@ -758,7 +994,7 @@ std::shared_ptr<ast::Type> Semant::infer_binary_type(const ast::BinaryExpression
     return result;
 }
 
-std::shared_ptr<ast::Type> Semant::infer_assign_type(const ast::AssignExpression &assign, Scope &scope)
+ast::Type *Semant::infer_assign_type(const ast::AssignExpression &assign, Scope &scope)
 {
     SEMANT_VERBOSE_ONLY(LOG_ENTER("INFER ASSIGN TYPE"));
 
@@ -767,7 +1003,7 @@ std::shared_ptr<ast::Type> Semant::infer_assign_type(const ast::AssignExpression
     const auto &var_name = assign._object->_object;
     const auto &expr_type = assign._expr->_type;
 
-    std::shared_ptr<ast::Type> var_type = nullptr;
+    ast::Type *var_type = nullptr;
     SEMANT_RETURN_IF_FALSE_WITH_ERROR(var_type = scope.find(var_name),
                                       "Assignment to undeclared variable " + var_name + ".", -1, nullptr);
 
@@ -782,7 +1018,7 @@ std::shared_ptr<ast::Type> Semant::infer_assign_type(const ast::AssignExpression
     return expr_type;
 }
 
-std::shared_ptr<ast::Type> Semant::infer_if_type(const ast::IfExpression &branch, Scope &scope)
+ast::Type *Semant::infer_if_type(const ast::IfExpression &branch, Scope &scope)
 {
     SEMANT_VERBOSE_ONLY(LOG_ENTER("INFER IF TYPE"));
 
@@ -800,7 +1036,7 @@ std::shared_ptr<ast::Type> Semant::infer_if_type(const ast::IfExpression &branch
     return find_common_ancestor({true_branch->_type, false_branch->_type});
 }
 
-std::shared_ptr<ast::Type> Semant::infer_sequence_type(const ast::ListExpression &seq, Scope &scope)
+ast::Type *Semant::infer_sequence_type(const ast::ListExpression &seq, Scope &scope)
 {
     SEMANT_VERBOSE_ONLY(LOG_ENTER("INFER SEQUENCE TYPE"));
 
@@ -813,14 +1049,14 @@ std::shared_ptr<ast::Type> Semant::infer_sequence_type(const ast::ListExpression
     return seq._exprs.back()->_type;
 }
 
-std::shared_ptr<ast::Type> Semant::infer_cases_type(const ast::CaseExpression &cases, Scope &scope)
+ast::Type *Semant::infer_cases_type(const ast::CaseExpression &cases, Scope &scope)
 {
     SEMANT_VERBOSE_ONLY(LOG_ENTER("INFER CASE TYPE"));
 
     SEMANT_RETURN_IF_FALSE(infer_expression_type(cases._expr, scope), nullptr);
 
-    std::vector<std::shared_ptr<ast::Type>> meet_types;
-    std::vector<std::shared_ptr<ast::Type>> classes;
+    std::vector<ast::Type *> meet_types;
+    std::vector<ast::Type *> classes;
     for (const auto &kase : cases._cases)
     {
         scope.push_scope();
@@ -856,7 +1092,7 @@ std::shared_ptr<ast::Type> Semant::infer_cases_type(const ast::CaseExpression &c
     return find_common_ancestor(classes);
 }
 
-std::shared_ptr<ast::Type> Semant::infer_dispatch_type(const ast::DispatchExpression &disp, Scope &scope)
+ast::Type *Semant::infer_dispatch_type(const ast::DispatchExpression &disp, Scope &scope)
 {
     SEMANT_VERBOSE_ONLY(LOG_ENTER("INFER DISPATCH TYPE"));
 
@@ -882,10 +1118,17 @@ std::shared_ptr<ast::Type> Semant::infer_dispatch_type(const ast::DispatchExpres
                                               dispatch_expr_type->_string + ".",
                                           -1, nullptr);
     }
+    else
+    {
+        // return type of a method is checked with its class, that can be checked later than the dispatch
+        SEMANT_RETURN_IF_FALSE_WITH_ERROR(check_exists(exact_type(dispatch_expr_type)),
+                                          "Dispatch on undefined class " + dispatch_expr_type->_string + ".", -1,
+                                          nullptr);
+    }
 
     const auto &method_name = disp._object->_object;
 
-    const auto feature = find_method(method_name, exact_type(dispatch_expr_type), false);
+    const auto feature = find_method(method_name, exact_type(dispatch_expr_type));
     SEMANT_RETURN_IF_FALSE_WITH_ERROR(feature, "Dispatch to undefined method " + method_name + ".", -1, nullptr);
     const auto &method = std::get<ast::MethodFeature>(feature->_base);
 
@@ -907,151 +1150,143 @@ std::shared_ptr<ast::Type> Semant::infer_dispatch_type(const ast::DispatchExpres
     return is_self_type(feature->_type) ? disp._expr->_type : feature->_type;
 }
 
-bool Semant::check_types_meet(const std::shared_ptr<ast::Type> &dynamic_type,
-                              const std::shared_ptr<ast::Type> &static_type) const
+bool Semant::check_types_meet(ast::Type *dynamic_type, ast::Type *static_type) const
 {
     if (is_self_type(static_type))
     {
         return same_type(dynamic_type, static_type);
     }
 
-    if (same_type(exact_type(dynamic_type), static_type))
-    {
-        return true;
-    }
+    depend_on(exact_type(dynamic_type));
+    depend_on(static_type);
 
-    for (const auto &t : _classes.at(static_type->_string)->_children)
+    const auto dynamic_class = _classes.find(exact_type(dynamic_type)->_string);
+    const auto static_class = _classes.find(static_type->_string);
+    if (dynamic_class == _classes.end() || static_class == _classes.end())
     {
-        if (check_types_meet(dynamic_type, t->_class->_type))
-        {
-            return true;
-        }
+        // types out of the hierarchy conform only to themselves
+        return same_type(exact_type(dynamic_type), static_type);
     }
 
-    return false;
+    return ClassHierarchy::conforms(*dynamic_class->second, *static_class->second);
 }
 
-std::shared_ptr<ast::Type> Semant::exact_type(const std::shared_ptr<ast::Type> &type) const
+ast::Type *Semant::exact_type(ast::Type *type) const
 {
     return exact_type(type, _current_class);
 }
 
-std::shared_ptr<ast::Type> Semant::find_common_ancestor(const std::vector<std::shared_ptr<ast::Type>> &classes) const
+ast::Type *Semant::find_common_ancestor(const std::vector<ast::Type *> &classes)
 {
-    auto lca = exact_type(classes[0]);
     // if all classes are SELF_TYPE, so LCA is SELF_TYPE
-    auto all_self_type = is_self_type(classes[0]);
-
-    for (int i = 1; i < classes.size(); i++)
+    if (std::all_of(classes.begin(), classes.end(), [](const auto &type) { return is_self_type(type); }))
     {
-        lca = find_common_ancestor_of_two(lca, exact_type(classes[i]));
-        if (all_self_type)
-        {
-            all_self_type = is_self_type(classes[i]);
-        }
-        if (same_type(lca, Object))
-        {
-            break;
-        }
+        return SelfType;
     }
 
-    return all_self_type ? SelfType : lca;
-}
-
-std::shared_ptr<ast::Type> Semant::find_common_ancestor_of_two(const std::shared_ptr<ast::Type> &t1,
-                                                               const std::shared_ptr<ast::Type> &t2) const
-{
-    auto h1 = 0, h2 = 0;
-
-    auto t1_par = t1;
-    auto t2_par = t2;
-
-    // find depth of the t1
-    while (!same_type(_classes.at(t1_par->_string)->_class->_type, Object))
+    // return type of a method is checked with its class, that can be checked later than the dispatch
+    for (auto *const type : classes)
     {
-        h1++;
-        t1_par = _classes.at(t1_par->_string)->_class->_parent;
+        SEMANT_RETURN_IF_FALSE_WITH_ERROR(check_exists(exact_type(type)),
+                                          "Class " + exact_type(type)->_string + " of the branch is undefined.", -1,
+                                          nullptr);
     }
 
-    // find depth of the t2
-    while (!same_type(_classes.at(t2_par->_string)->_class->_type, Object))
+    const ClassNode *lca = _classes.at(exact_type(classes[0])->_string).get();
+    depend_on(exact_type(classes[0]));
+    for (size_t i = 1; i < classes.size() && lca != _root.get(); i++)
     {
-        h2++;
-        t2_par = _classes.at(t2_par->_string)->_class->_parent;
+        depend_on(exact_type(classes[i]));
+        lca = _hierarchy.common_ancestor(*lca, *_classes.at(exact_type(classes[i])->_string));
     }
 
-    // align subtrees
-    t1_par = t1;
-    t2_par = t2;
-    while (h1 != h2)
-    {
-        if (h1 > h2)
-        {
-            t1_par = _classes.at(t1_par->_string)->_class->_parent;
-            h1--;
-        }
-        else if (h2 > h1)
-        {
-            t2_par = _classes.at(t2_par->_string)->_class->_parent;
-            h2--;
-        }
-    }
+    return lca->_class->_type;
+}
 
-    // find lca
-    while (!same_type(t1_par, t2_par))
+ast::Feature *Semant::find_method(const Symbol &name, ast::Type *klass) const
+{
+    if (same_type(klass, Empty))
     {
-        t1_par = _classes.at(t1_par->_string)->_class->_parent;
-        t2_par = _classes.at(t2_par->_string)->_class->_parent;
+        return nullptr;
     }
+    depend_on(klass);
 
-    return t1_par;
+    const auto &methods = _classes.at(klass->_string)->_methods;
+    const auto method = methods.find(name);
+    return method != methods.end() ? method->second : nullptr;
 }
 
-std::shared_ptr<ast::Feature> Semant::find_method(const std::string &name, const std::shared_ptr<ast::Type> &klass,
-                                                  const bool &exact) const
+uint64_t Semant::signature(const Symbol &name) const
 {
-    if (same_type(klass, Empty))
+    const auto klass = _classes.find(name);
+    return klass != _classes.end() ? klass->second->_signature : 0;
+}
+
+bool Semant::load_checked_class(const std::vector<ast::Expression *> &expressions, const uint64_t &hash)
+{
+    std::vector<SemantCache::Dependency> dependencies;
+    std::vector<Symbol> names;
+    SEMANT_RETURN_IF_FALSE(_cache->load(hash, dependencies, names) && names.size() == expressions.size(), false);
+
+    for (const auto &dependency : dependencies)
     {
-        return nullptr;
+        SEMANT_RETURN_IF_FALSE(signature(dependency._name) == dependency._signature, false);
     }
 
-    std::shared_ptr<ast::Feature> method;
-
-    for (const auto &m : _classes.at(klass->_string)->_class->_features)
+    // entry is applied only if all types are classes of this program
+    std::vector<ast::Type *> types(names.size(), nullptr);
+    for (size_t i = 0; i < names.size(); i++)
     {
-        if (std::holds_alternative<ast::MethodFeature>(m->_base) && m->_object->_object == name)
+        if (!names[i].empty())
         {
-            method = m;
-            break;
+            const auto klass = _classes.find(names[i]);
+            SEMANT_RETURN_IF_FALSE(klass != _classes.end(), false);
+            types[i] = klass->second->_class->_type;
         }
     }
 
-    if (exact)
+    for (size_t i = 0; i < expressions.size(); i++)
     {
-        return method;
+        expressions[i]->_type = types[i];
     }
 
-    // find method in ancestors
-    auto current_class = _classes.at(klass->_string)->_class->_parent;
-    while (!same_type(current_class, Empty))
+    return true;
+}
+
+void Semant::store_checked_class(const ClassNode &node, const std::vector<ast::Expression *> &expressions,
+                                 const uint64_t &hash) const
+{
+    // subtyping and method lookup walk up the hierarchy, so ancestors of the used classes are dependencies too
+    _dependencies.insert(node._class->_type->_string);
+
+    std::unordered_set<Symbol> visited;
+    std::vector<SemantCache::Dependency> dependencies;
+    for (auto name : _dependencies)
     {
-        for (const auto &m : _classes.at(current_class->_string)->_class->_features)
+        while (visited.insert(name).second)
         {
-            if (std::holds_alternative<ast::MethodFeature>(m->_base) && m->_object->_object == name)
+            const auto klass = _classes.find(name);
+            dependencies.push_back({name, signature(name)});
+            if (klass == _classes.end() || klass->second == _root)
             {
-                method = m;
                 break;
             }
+            name = klass->second->_class->_parent->_string;
         }
-        if (method)
-        {
-            break;
-        }
+    }
 
-        current_class = _classes.at(current_class->_string)->_class->_parent;
+    // symbol ids depend on the order of lexing, so sort by strings to write the same entry every time
+    std::sort(dependencies.begin(), dependencies.end(),
+              [](const auto &lhs, const auto &rhs) { return lhs._name.str() < rhs._name.str(); });
+
+    std::vector<Symbol> types;
+    types.reserve(expressions.size());
+    for (const auto *expr : expressions)
+    {
+        types.push_back(expr->_type ? expr->_type->_string : Symbol());
     }
 
-    return method;
+    _cache->store(hash, dependencies, types);
 }
 
 std::string Semant::error_msg() const
@@ -1064,19 +1299,18 @@ std::string Semant::error_msg() const
     return prefix + _error_message;
 }
 
-std::shared_ptr<ast::Type> Semant::exact_type(const std::shared_ptr<ast::Type> &ltype,
-                                              const std::shared_ptr<ast::Type> &rtype)
+ast::Type *Semant::exact_type(ast::Type *ltype, ast::Type *rtype)
 {
     return is_self_type(ltype) ? rtype : ltype;
 }
 
-std::shared_ptr<ast::Type> Semant::Bool = nullptr;
-std::shared_ptr<ast::Type> Semant::Object = nullptr;
-std::shared_ptr<ast::Type> Semant::Int = nullptr;
-std::shared_ptr<ast::Type> Semant::String = nullptr;
-std::shared_ptr<ast::Type> Semant::Io = nullptr;
-std::shared_ptr<ast::Type> Semant::SelfType = nullptr;
-std::shared_ptr<ast::Type> Semant::Empty = nullptr;
-std::shared_ptr<ast::Type> Semant::NativeInt = nullptr;
-std::shared_ptr<ast::Type> Semant::NativeBool = nullptr;
-std::shared_ptr<ast::Type> Semant::NativeString = nullptr;
\ No newline at end of file
+ast::Type *Semant::Bool = nullptr;
+ast::Type *Semant::Object = nullptr;
+ast::Type *Semant::Int = nullptr;
+ast::Type *Semant::String = nullptr;
+ast::Type *Semant::Io = nullptr;
+ast::Type *Semant::SelfType = nullptr;
+ast::Type *Semant::Empty = nullptr;
+ast::Type *Semant::NativeInt = nullptr;
+ast::Type *Semant::NativeBool = nullptr;
+ast::Type *Semant::NativeString = nullptr;
\ No newline at end of file
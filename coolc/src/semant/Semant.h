@@ -1,8 +1,11 @@
 #pragma once
 
 #include "decls/Decls.h"
+#include "semant/cache/SemantCache.h"
+#include "semant/hierarchy/ClassHierarchy.h"
 #include "semant/scope/Scope.h"
 #include <algorithm>
+#include <unordered_set>
 
 #define SEMANT_RETURN_IF_FALSE_WITH_ERROR(cond, error, line_num, retval)                                               \
     if (!(cond))                                                                                                       \
@@ -14,12 +17,6 @@
 
 namespace semant
 {
-struct ClassNode
-{
-    std::shared_ptr<ast::Class> _class;
-    std::vector<std::shared_ptr<ClassNode>> _children;
-};
-
 class Semant
 {
   private:
@@ -40,12 +37,32 @@ class Semant
     // merge multiple programs were generated by parser to one program
     static std::shared_ptr<ast::Program> merge_to_one_program(
         const std::vector<std::shared_ptr<ast::Program>> &programs);
-    std::shared_ptr<ast::Program> _program;    // program to analyze
-    std::shared_ptr<ast::Type> _current_class; // current class of analysis for SELF_TYPE
+    std::shared_ptr<ast::Program> _program; // program to analyze
+    std::shared_ptr<Arena> _arena;          // nodes created by semant, _program owns it too
+    ast::Type *_current_class;              // current class of analysis for SELF_TYPE
 
     // ----------------------------- Analysis algorithms support -----------------------------
-    std::unordered_map<std::string, std::shared_ptr<ClassNode>> _classes; // fast access to class info
-    std::shared_ptr<ClassNode> _root;                                     // root of classes
+    std::unordered_map<Symbol, std::shared_ptr<ClassNode>> _classes; // fast access to class info
+    std::shared_ptr<ClassNode> _root;                                // root of classes
+    ClassHierarchy _hierarchy;                                       // subtype and LCA queries, built after checks
+
+    // ----------------------------- Incremental check -----------------------------
+    std::shared_ptr<const SemantCache> _cache;        // checked classes, nullptr if cache is disabled
+    mutable std::unordered_set<Symbol> _dependencies; // classes that the check of the current class looked up
+
+    // record the lookup of the class for the cache entry of the current class
+    inline void depend_on(ast::Type *type) const
+    {
+        if (_cache)
+        {
+            _dependencies.insert(type->_string);
+        }
+    }
+    uint64_t signature(const Symbol &name) const; // signature of the class or 0 if there is no such class
+    // set types of expressions from the cache if classes that the class depends on did not change
+    bool load_checked_class(const std::vector<ast::Expression *> &expressions, const uint64_t &hash);
+    void store_checked_class(const ClassNode &node, const std::vector<ast::Expression *> &expressions,
+                             const uint64_t &hash) const;
 
     // ----------------------------- Class checking -----------------------------
     // creates dummy class with methods:
@@ -54,7 +71,7 @@ class Semant
     std::shared_ptr<ClassNode> make_basic_class(
         const std::string &name, const std::string &parent,
         const std::vector<std::pair<std::string, std::vector<std::string>>> &methods,
-        const std::vector<std::shared_ptr<ast::Type>> &fields);
+        const std::vector<ast::Type *> &fields);
 
     // class check
     bool check_classes();
@@ -62,61 +79,75 @@ class Semant
     bool check_main();
     // class check helpers
     bool check_class_hierarchy_for_cycle(const std::shared_ptr<ClassNode> &klass,
-                                         std::unordered_map<std::string, int> &visited, const int &loop);
-    static bool is_inherit_allowed(const std::shared_ptr<ast::Type> &klass);
+                                         std::unordered_map<Symbol, int> &visited, const int &loop);
+    static bool is_inherit_allowed(ast::Type *klass);
+    // fill ClassNode::_methods for all classes
+    void build_method_tables();
 
     // ----------------------------- Expression checking -----------------------------
+    // parse method bodies that parser skipped in the lazy mode. The method body is parsed when its method is checked.
+    // After a semantic error the rest is parsed on Jobs threads, and the first syntax error in the program order
+    // replaces the semantic one, as the parser reports it before semant without lazy bodies
+    bool parse_lazy_bodies();
+    bool parse_lazy_body(ast::Feature *method);
+
     // expressions type check
     bool check_expressions();
     bool check_expressions_in_class(const std::shared_ptr<ClassNode> &node, Scope &scope);
-    bool check_expression_in_method(const std::shared_ptr<ast::Feature> &method, Scope &scope);
-    bool check_expression_in_attribute(const std::shared_ptr<ast::Feature> &attr, Scope &scope);
-    bool infer_expression_type(const std::shared_ptr<ast::Expression> &expr, Scope &scope);
-
-    std::shared_ptr<ast::Type> infer_new_type(const ast::NewExpression &alloc);
-    std::shared_ptr<ast::Type> infer_let_type(const ast::LetExpression &let, Scope &scope);
-    std::shared_ptr<ast::Type> infer_loop_type(const ast::WhileExpression &loop, Scope &scope);
-    std::shared_ptr<ast::Type> infer_unary_type(const ast::UnaryExpression &unary, Scope &scope);
-    std::shared_ptr<ast::Type> infer_binary_type(const ast::BinaryExpression &binary, Scope &scope);
-    std::shared_ptr<ast::Type> infer_assign_type(const ast::AssignExpression &assign, Scope &scope);
-    std::shared_ptr<ast::Type> infer_if_type(const ast::IfExpression &branch, Scope &scope);
-    std::shared_ptr<ast::Type> infer_sequence_type(const ast::ListExpression &seq, Scope &scope);
-    std::shared_ptr<ast::Type> infer_cases_type(const ast::CaseExpression &cases, Scope &scope);
-    std::shared_ptr<ast::Type> infer_dispatch_type(const ast::DispatchExpression &disp, Scope &scope);
-    std::shared_ptr<ast::Type> infer_object_type(const ast::ObjectExpression &obj, Scope &scope);
+    // push the scope of the class with its attributes and check its features. Scope is left for subclasses
+    bool check_class_features(const ClassNode &node, Scope &scope);
+    // check classes on jobs threads, report the error that the sequential check reports
+    bool check_expressions_in_parallel(const int &jobs);
+    // check classes with preorder numbers [begin, end) in order. failed is the number of the class that is checked now,
+    // so it is the failed class if check returns false or throws
+    bool check_expressions_in_range(const size_t &begin, const size_t &end, size_t &failed);
+    bool check_expression_in_method(ast::Feature *method, Scope &scope);
+    bool check_expression_in_attribute(ast::Feature *attr, Scope &scope);
+    bool infer_expression_type(ast::Expression *expr, Scope &scope);
+
+    ast::Type *infer_new_type(const ast::NewExpression &alloc);
+    ast::Type *infer_let_type(const ast::LetExpression &let, Scope &scope);
+    ast::Type *infer_loop_type(const ast::WhileExpression &loop, Scope &scope);
+    ast::Type *infer_unary_type(const ast::UnaryExpression &unary, Scope &scope);
+    ast::Type *infer_binary_type(const ast::BinaryExpression &binary, Scope &scope);
+    ast::Type *infer_assign_type(const ast::AssignExpression &assign, Scope &scope);
+    ast::Type *infer_if_type(const ast::IfExpression &branch, Scope &scope);
+    ast::Type *infer_sequence_type(const ast::ListExpression &seq, Scope &scope);
+    ast::Type *infer_cases_type(const ast::CaseExpression &cases, Scope &scope);
+    ast::Type *infer_dispatch_type(const ast::DispatchExpression &disp, Scope &scope);
+    ast::Type *infer_object_type(const ast::ObjectExpression &obj, Scope &scope);
 
     // ----------------------------- Type checking support -----------------------------
     // basic types
-    static std::shared_ptr<ast::Type> Bool;
-    static std::shared_ptr<ast::Type> Object;
-    static std::shared_ptr<ast::Type> Int;
-    static std::shared_ptr<ast::Type> String;
-    static std::shared_ptr<ast::Type> Io;
-    static std::shared_ptr<ast::Type> SelfType;
-    static std::shared_ptr<ast::Type> Empty; // special type for no type
-    static std::shared_ptr<ast::Type> NativeInt;
-    static std::shared_ptr<ast::Type> NativeBool;
-    static std::shared_ptr<ast::Type> NativeString;
+    static ast::Type *Bool;
+    static ast::Type *Object;
+    static ast::Type *Int;
+    static ast::Type *String;
+    static ast::Type *Io;
+    static ast::Type *SelfType;
+    static ast::Type *Empty; // special type for no type
+    static ast::Type *NativeInt;
+    static ast::Type *NativeBool;
+    static ast::Type *NativeString;
 
     // expressions type check helpers
 
     // t1 is subtype of t2
     // this function is not сommutative !!!
-    bool check_types_meet(const std::shared_ptr<ast::Type> &dynamic_type,
-                          const std::shared_ptr<ast::Type> &static_type) const;
-    inline static bool same_type(const std::shared_ptr<ast::Type> &t1, const std::shared_ptr<ast::Type> &t2)
+    bool check_types_meet(ast::Type *dynamic_type, ast::Type *static_type) const;
+    inline static bool same_type(ast::Type *t1, ast::Type *t2)
     {
         return t1->_string == t2->_string;
     }
 
-    std::shared_ptr<ast::Type> exact_type(const std::shared_ptr<ast::Type> &type) const;
-    std::shared_ptr<ast::Type> find_common_ancestor(const std::vector<std::shared_ptr<ast::Type>> &classes) const;
-    std::shared_ptr<ast::Type> find_common_ancestor_of_two(const std::shared_ptr<ast::Type> &t1,
-                                                           const std::shared_ptr<ast::Type> &t2) const;
-    std::shared_ptr<ast::Feature> find_method(const std::string &name, const std::shared_ptr<ast::Type> &klass,
-                                              const bool &exact) const;
-    inline bool check_exists(const std::shared_ptr<ast::Type> &type) const
+    ast::Type *exact_type(ast::Type *type) const;
+    // nullptr and the error if some class is undefined
+    ast::Type *find_common_ancestor(const std::vector<ast::Type *> &classes);
+    // method that objects of klass have: own or the nearest inherited one
+    ast::Feature *find_method(const Symbol &name, ast::Type *klass) const;
+    inline bool check_exists(ast::Type *type) const
     {
+        depend_on(type);
         return _classes.find(type->_string) != _classes.end() || is_empty_type(type);
     }
 
@@ -141,7 +172,7 @@ class Semant
      * @param type Type for check
      * @return True if type is basic class
      */
-    static bool is_basic_type(const std::shared_ptr<ast::Type> &type);
+    static bool is_basic_type(ast::Type *type);
 
     /**
      * @brief Check if type is trivial
@@ -149,7 +180,7 @@ class Semant
      * @param type Type for check
      * @return True if type is trivial
      */
-    static bool is_trivial_type(const std::shared_ptr<ast::Type> &type);
+    static bool is_trivial_type(ast::Type *type);
 
     /**
      * @brief Check if type is boolean
@@ -157,7 +188,7 @@ class Semant
      * @param t Type for check
      * @return True if type is boolean
      */
-    inline static bool is_bool(const std::shared_ptr<ast::Type> &t)
+    inline static bool is_bool(ast::Type *t)
     {
         return same_type(t, Bool);
     }
@@ -168,7 +199,7 @@ class Semant
      * @param t Type for check
      * @return True if type is int
      */
-    inline static bool is_int(const std::shared_ptr<ast::Type> &t)
+    inline static bool is_int(ast::Type *t)
     {
         return same_type(t, Int);
     }
@@ -179,7 +210,7 @@ class Semant
      * @param t Type for check
      * @return True if type is string
      */
-    inline static bool is_string(const std::shared_ptr<ast::Type> &t)
+    inline static bool is_string(ast::Type *t)
     {
         return same_type(t, String);
     }
@@ -190,7 +221,7 @@ class Semant
      * @param t Type for check
      * @return True if type is native boolean
      */
-    inline static bool is_native_bool(const std::shared_ptr<ast::Type> &t)
+    inline static bool is_native_bool(ast::Type *t)
     {
         return same_type(t, NativeBool);
     }
@@ -201,7 +232,7 @@ class Semant
      * @param t Type for check
      * @return True if type is native int
      */
-    inline static bool is_native_int(const std::shared_ptr<ast::Type> &t)
+    inline static bool is_native_int(ast::Type *t)
     {
         return same_type(t, NativeInt);
     }
@@ -212,7 +243,7 @@ class Semant
      * @param t Type for check
      * @return True if type is native string
      */
-    inline static bool is_native_string(const std::shared_ptr<ast::Type> &t)
+    inline static bool is_native_string(ast::Type *t)
     {
         return same_type(t, NativeString);
     }
@@ -223,7 +254,7 @@ class Semant
      * @param t Type for check
      * @return True if type is SELF_TYPE
      */
-    inline static bool is_self_type(const std::shared_ptr<ast::Type> &t)
+    inline static bool is_self_type(ast::Type *t)
     {
         return same_type(t, SelfType);
     }
@@ -234,7 +265,7 @@ class Semant
      * @param t Type for check
      * @return True if type is _EMPTY_TYPE
      */
-    inline static bool is_empty_type(const std::shared_ptr<ast::Type> &t)
+    inline static bool is_empty_type(ast::Type *t)
     {
         return same_type(t, Empty);
     }
@@ -244,7 +275,7 @@ class Semant
      *
      * @return Empty type pointer
      */
-    inline static std::shared_ptr<ast::Type> empty_type()
+    inline static ast::Type *empty_type()
     {
         return Empty;
     }
@@ -255,7 +286,7 @@ class Semant
      * @param t Type for check
      * @return True if type is Native
      */
-    static bool is_native_type(const std::shared_ptr<ast::Type> &t);
+    static bool is_native_type(ast::Type *t);
 
     /**
      * @brief Calculate exact type for a given type
@@ -264,8 +295,7 @@ class Semant
      * @param rtype Current type
      * @return rtype if type is SELF_TYPE or ltype
      */
-    static std::shared_ptr<ast::Type> exact_type(const std::shared_ptr<ast::Type> &ltype,
-                                                 const std::shared_ptr<ast::Type> &rtype);
+    static ast::Type *exact_type(ast::Type *ltype, ast::Type *rtype);
 
     /**
      * @brief Get the error message
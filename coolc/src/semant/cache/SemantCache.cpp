@@ -0,0 +1,387 @@
+#include "SemantCache.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+
+using namespace semant;
+
+namespace
+{
+constexpr char MAGIC[8] = {'C', 'O', 'O', 'L', 'S', 'E', 'M', '\0'};
+constexpr uint32_t NONE = UINT32_MAX; // index of the absent type
+
+// entry layout: Header, 2 * _symbols words of string offsets and lengths, 3 * _dependencies words of symbol indexes
+// and low and high halves of signatures, _types words of symbol indexes, _strings_size bytes of strings
+struct Header
+{
+    char _magic[8];
+    uint32_t _version;
+    uint32_t _symbols;
+    uint64_t _hash;
+    uint32_t _dependencies;
+    uint32_t _types;
+    uint64_t _strings_size;
+};
+
+static_assert(sizeof(Header) == 40 && std::is_trivially_copyable_v<Header>);
+
+// 64-bit FNV-1a
+class Hasher
+{
+  private:
+    uint64_t _hash = 0xcbf29ce484222325;
+
+  public:
+    void add(const std::string_view &bytes)
+    {
+        for (const auto &ch : bytes)
+        {
+            _hash = (_hash ^ static_cast<uint8_t>(ch)) * 0x100000001b3;
+        }
+    }
+
+    void add(const uint32_t &word)
+    {
+        add(std::string_view(reinterpret_cast<const char *>(&word), sizeof(word)));
+    }
+
+    void add(const Symbol &symbol)
+    {
+        // length first, so the concatenation of symbols is unambiguous
+        add(static_cast<uint32_t>(symbol.str().size()));
+        add(symbol.str());
+    }
+
+    uint64_t value() const
+    {
+        return _hash;
+    }
+};
+
+// hash declarations of the class and, if expressions are collected, method bodies and initializers
+class ClassHasher
+{
+  private:
+    Hasher _hasher;
+    std::vector<ast::Expression *> *const _expressions;
+
+    void walk(ast::Expression *expr)
+    {
+        _expressions->push_back(expr);
+        _hasher.add(static_cast<uint32_t>(expr->_data.index()));
+
+        std::visit(
+            ast::overloaded{
+                [&](const ast::AssignExpression &assign) {
+                    _hasher.add(assign._object->_object);
+                    walk(assign._expr);
+                },
+                [&](const ast::DispatchExpression &dispatch) {
+                    _hasher.add(static_cast<uint32_t>(dispatch._base.index()));
+                    if (const auto *base = std::get_if<ast::StaticDispatchExpression>(&dispatch._base))
+                    {
+                        _hasher.add(base->_type->_string);
+                    }
+                    _hasher.add(dispatch._object->_object);
+                    walk(dispatch._expr);
+                    walk_list(dispatch._args);
+                },
+                [&](const ast::BinaryExpression &binary) {
+                    _hasher.add(static_cast<uint32_t>(binary._base.index()));
+                    walk(binary._lhs);
+                    walk(binary._rhs);
+                },
+                [&](const ast::UnaryExpression &unary) {
+                    _hasher.add(static_cast<uint32_t>(unary._base.index()));
+                    walk(unary._expr);
+                },
+                [&](const ast::IfExpression &branch) {
+                    walk(branch._predicate);
+                    walk(branch._true_path_expr);
+                    walk(branch._false_path_expr);
+                },
+                [&](const ast::WhileExpression &loop) {
+                    walk(loop._predicate);
+                    walk(loop._body_expr);
+                },
+                [&](const ast::ListExpression &list) { walk_list(list._exprs); },
+                [&](const ast::LetExpression &let) {
+                    _hasher.add(let._object->_object);
+                    _hasher.add(let._type->_string);
+                    walk_optional(let._expr);
+                    walk(let._body_expr);
+                },
+                [&](const ast::CaseExpression &kase) {
+                    walk(kase._expr);
+                    _hasher.add(static_cast<uint32_t>(kase._cases.size()));
+                    for (const auto *branch : kase._cases)
+                    {
+                        _hasher.add(branch->_object->_object);
+                        _hasher.add(branch->_type->_string);
+                        walk(branch->_expr);
+                    }
+                },
+                [&](const ast::NewExpression &alloc) { _hasher.add(alloc._type->_string); },
+                [&](const ast::ObjectExpression &object) { _hasher.add(object._object); },
+                [&](const ast::IntExpression &value) { _hasher.add(static_cast<uint32_t>(value._value)); },
+                [&](const ast::StringExpression &value) { _hasher.add(value._string); },
+                [&](const ast::BoolExpression &value) { _hasher.add(static_cast<uint32_t>(value._value)); }},
+            expr->_data);
+    }
+
+    void walk_list(const std::span<ast::Expression *> &exprs)
+    {
+        _hasher.add(static_cast<uint32_t>(exprs.size()));
+        for (auto *const expr : exprs)
+        {
+            walk(expr);
+        }
+    }
+
+    void walk_optional(ast::Expression *expr)
+    {
+        _hasher.add(static_cast<uint32_t>(expr != nullptr));
+        if (expr)
+        {
+            walk(expr);
+        }
+    }
+
+  public:
+    explicit ClassHasher(std::vector<ast::Expression *> *expressions) : _expressions(expressions)
+    {
+    }
+
+    uint64_t hash(const ast::Class &klass)
+    {
+        _hasher.add(klass._type->_string);
+        _hasher.add(klass._parent->_string);
+
+        _hasher.add(static_cast<uint32_t>(klass._features.size()));
+        for (const auto *feature : klass._features)
+        {
+            _hasher.add(static_cast<uint32_t>(feature->_base.index()));
+            _hasher.add(feature->_object->_object);
+            _hasher.add(feature->_type->_string);
+
+            if (const auto *method = std::get_if<ast::MethodFeature>(&feature->_base))
+            {
+                _hasher.add(static_cast<uint32_t>(method->_formals.size()));
+                for (const auto *formal : method->_formals)
+                {
+                    _hasher.add(formal->_object->_object);
+                    _hasher.add(formal->_type->_string);
+                }
+            }
+
+            if (_expressions)
+            {
+                GUARANTEE_DEBUG(!feature->_lazy_body);
+                walk_optional(feature->_expr);
+            }
+        }
+
+        return _hasher.value();
+    }
+};
+
+// every read is checked, so a malformed entry is rejected instead of crashing
+class Reader
+{
+  private:
+    const std::string &_entry;
+    size_t _pos = sizeof(Header);
+
+  public:
+    explicit Reader(const std::string &entry) : _entry(entry)
+    {
+    }
+
+    bool next(uint32_t &word)
+    {
+        if (_pos + sizeof(word) > _entry.size())
+        {
+            return false;
+        }
+        std::memcpy(&word, _entry.data() + _pos, sizeof(word));
+        _pos += sizeof(word);
+        return true;
+    }
+
+    size_t position() const
+    {
+        return _pos;
+    }
+};
+} // namespace
+
+SemantCache::SemantCache(const std::string &directory) : _directory(directory)
+{
+    std::error_code error;
+    std::filesystem::create_directories(_directory, error);
+}
+
+std::string SemantCache::entry_name(const uint64_t &hash) const
+{
+    static constexpr char DIGITS[] = "0123456789abcdef";
+
+    std::string name(16, '0');
+    for (int i = 15; i >= 0; i--)
+    {
+        name[i] = DIGITS[(hash >> (4 * (15 - i))) & 0xf];
+    }
+
+    return (std::filesystem::path(_directory) / (name + ".sem")).string();
+}
+
+uint64_t SemantCache::hash(const ast::Class &klass, std::vector<ast::Expression *> &expressions)
+{
+    expressions.clear();
+    return ClassHasher(&expressions).hash(klass);
+}
+
+uint64_t SemantCache::signature(const ast::Class &klass)
+{
+    const auto hash = ClassHasher(nullptr).hash(klass);
+    return hash != 0 ? hash : 1;
+}
+
+bool SemantCache::load(const uint64_t &hash, std::vector<Dependency> &dependencies, std::vector<Symbol> &types) const
+{
+    std::ifstream in(entry_name(hash), std::ios::binary);
+    if (!in)
+    {
+        return false;
+    }
+    const std::string entry((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    Header header;
+    if (entry.size() < sizeof(Header))
+    {
+        return false;
+    }
+    std::memcpy(&header, entry.data(), sizeof(Header));
+    if (std::memcmp(header._magic, MAGIC, sizeof(MAGIC)) != 0 || header._version != FORMAT_VERSION ||
+        header._hash != hash || header._strings_size > entry.size() - sizeof(Header))
+    {
+        return false;
+    }
+
+    const auto strings_begin = entry.size() - header._strings_size;
+    Reader reader(entry);
+
+    std::vector<Symbol> symbols;
+    for (uint32_t i = 0; i < header._symbols; i++)
+    {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+        if (!reader.next(offset) || !reader.next(length) ||
+            static_cast<uint64_t>(offset) + length > header._strings_size)
+        {
+            return false;
+        }
+        symbols.emplace_back(std::string_view(entry).substr(strings_begin + offset, length));
+    }
+
+    dependencies.clear();
+    for (uint32_t i = 0; i < header._dependencies; i++)
+    {
+        uint32_t name = 0;
+        uint32_t low = 0;
+        uint32_t high = 0;
+        if (!reader.next(name) || !reader.next(low) || !reader.next(high) || name >= symbols.size())
+        {
+            return false;
+        }
+        dependencies.push_back({symbols[name], static_cast<uint64_t>(high) << 32 | low});
+    }
+
+    types.clear();
+    for (uint32_t i = 0; i < header._types; i++)
+    {
+        uint32_t type = 0;
+        if (!reader.next(type) || (type != NONE && type >= symbols.size()))
+        {
+            return false;
+        }
+        types.push_back(type != NONE ? symbols[type] : Symbol());
+    }
+
+    return reader.position() == strings_begin;
+}
+
+void SemantCache::store(const uint64_t &hash, const std::vector<Dependency> &dependencies,
+                        const std::vector<Symbol> &types) const
+{
+    std::vector<Symbol> symbols;
+    std::unordered_map<Symbol, uint32_t> indexes;
+    const auto symbol = [&](const Symbol &name) {
+        const auto [index, inserted] = indexes.emplace(name, symbols.size());
+        if (inserted)
+        {
+            symbols.push_back(name);
+        }
+        return index->second;
+    };
+
+    std::vector<uint32_t> words;
+    for (const auto &dependency : dependencies)
+    {
+        words.push_back(symbol(dependency._name));
+        words.push_back(static_cast<uint32_t>(dependency._signature));
+        words.push_back(static_cast<uint32_t>(dependency._signature >> 32));
+    }
+    for (const auto &type : types)
+    {
+        words.push_back(type.empty() ? NONE : symbol(type));
+    }
+
+    std::vector<uint32_t> string_table;
+    std::string strings;
+    for (const auto &name : symbols)
+    {
+        string_table.push_back(strings.size());
+        string_table.push_back(name.str().size());
+        strings += name.str();
+    }
+
+    Header header;
+    std::memcpy(header._magic, MAGIC, sizeof(MAGIC));
+    header._version = FORMAT_VERSION;
+    header._symbols = symbols.size();
+    header._hash = hash;
+    header._dependencies = dependencies.size();
+    header._types = types.size();
+    header._strings_size = strings.size();
+
+    std::string entry(reinterpret_cast<const char *>(&header), sizeof(header));
+    entry.append(reinterpret_cast<const char *>(string_table.data()), sizeof(uint32_t) * string_table.size());
+    entry.append(reinterpret_cast<const char *>(words.data()), sizeof(uint32_t) * words.size());
+    entry += strings;
+
+    // write to the unique temporary file and rename it, so concurrent compilations never see a partial entry
+    const auto name = entry_name(hash);
+    const auto tmp_name = name + "." + std::to_string(getpid()) + "." +
+                          std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream out(tmp_name, std::ios::binary);
+        if (!out.write(entry.data(), entry.size()))
+        {
+            out.close();
+            std::error_code error;
+            std::filesystem::remove(tmp_name, error);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tmp_name, name, error);
+    if (error)
+    {
+        std::filesystem::remove(tmp_name, error);
+    }
+}
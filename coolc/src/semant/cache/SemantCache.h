@@ -0,0 +1,91 @@
+#pragma once
+
+#include "ast/AST.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace semant
+{
+
+/**
+ * @brief Directory of type checked classes keyed by the hash of the class contents
+ *
+ * @details
+ * Entry keeps inferred types of all expressions of the class and the classes that its check depends on: the class and
+ * its ancestors, classes that were looked up during the check and their ancestors. Every dependency is saved with the
+ * hash of its signature, which covers the name, the parent and declarations of features but not method bodies. Entry
+ * is valid while all dependencies have the same signatures, so the change of a method body invalidates only its own
+ * class, and the change of a signature invalidates the class and classes that use it.
+ *
+ * Entries with other FORMAT_VERSION and malformed entries are treated as missing and are rewritten. Cache is
+ * best-effort: store failures are ignored.
+ */
+class SemantCache
+{
+  public:
+    // increase on any change of the entry layout or of the type checking rules
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    /**
+     * @brief Class that the check depends on
+     *
+     */
+    struct Dependency
+    {
+        Symbol _name;
+        uint64_t _signature; // 0 if there is no such class
+    };
+
+  private:
+    const std::string _directory;
+
+    std::string entry_name(const uint64_t &hash) const;
+
+  public:
+    /**
+     * @brief Construct a new SemantCache
+     *
+     * @param directory Cache directory. It is created if it does not exist
+     */
+    explicit SemantCache(const std::string &directory);
+
+    /**
+     * @brief Load check results of the class
+     *
+     * @param hash Hash of the class contents
+     * @param dependencies Classes that the check depends on
+     * @param types Names of inferred types in the order of expressions, empty for expressions without type
+     * @return True if there is a valid entry for the class
+     */
+    bool load(const uint64_t &hash, std::vector<Dependency> &dependencies, std::vector<Symbol> &types) const;
+
+    /**
+     * @brief Save check results of the class
+     *
+     * @param hash Hash of the class contents
+     * @param dependencies Classes that the check depends on
+     * @param types Names of inferred types in the order of expressions, empty for expressions without type
+     */
+    void store(const uint64_t &hash, const std::vector<Dependency> &dependencies,
+               const std::vector<Symbol> &types) const;
+
+    /**
+     * @brief Hash the class contents and collect its expressions
+     *
+     * @param klass Class
+     * @param expressions All expressions of the class in the fixed order
+     * @return 64-bit FNV-1a hash of the class without line numbers
+     */
+    static uint64_t hash(const ast::Class &klass, std::vector<ast::Expression *> &expressions);
+
+    /**
+     * @brief Hash the class signature
+     *
+     * @param klass Class
+     * @return 64-bit FNV-1a hash of the name, the parent and declarations of features. Never 0
+     */
+    static uint64_t signature(const ast::Class &klass);
+};
+
+} // namespace semant
@@ -0,0 +1,69 @@
+#include "ClassHierarchy.h"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+using namespace semant;
+
+ClassHierarchy::ClassHierarchy(const std::shared_ptr<ClassNode> &root)
+{
+    // iterative DFS, inheritance chains can be deep. Frame is a class and the number of its visited children
+    std::vector<int> tour;
+    std::vector<std::pair<ClassNode *, size_t>> stack = {{root.get(), 0}};
+
+    root->_index = 0;
+    _classes.push_back(root.get());
+    _first.push_back(0);
+    tour.push_back(0);
+
+    while (!stack.empty())
+    {
+        auto &[klass, visited] = stack.back();
+        if (visited == klass->_children.size())
+        {
+            klass->_last_descendant = _classes.size() - 1;
+            stack.pop_back();
+            if (!stack.empty())
+            {
+                // back to the parent
+                tour.push_back(stack.back().first->_index);
+            }
+            continue;
+        }
+
+        auto *const child = klass->_children[visited++].get();
+        child->_index = _classes.size();
+        _classes.push_back(child);
+        _first.push_back(tour.size());
+        tour.push_back(child->_index);
+
+        stack.emplace_back(child, 0);
+    }
+
+    _sparse.push_back(std::move(tour));
+    for (size_t width = 1; 2 * width <= _sparse.front().size(); width *= 2)
+    {
+        const auto &prev = _sparse.back();
+        std::vector<int> level(prev.size() - width);
+        for (size_t i = 0; i < level.size(); i++)
+        {
+            level[i] = std::min(prev[i], prev[i + width]);
+        }
+        _sparse.push_back(std::move(level));
+    }
+}
+
+ClassNode *ClassHierarchy::common_ancestor(const ClassNode &lhs, const ClassNode &rhs) const
+{
+    auto begin = _first[lhs._index];
+    auto end = _first[rhs._index];
+    if (begin > end)
+    {
+        std::swap(begin, end);
+    }
+
+    // two overlapping ranges of the length 2^level cover [begin, end]
+    const auto level = std::bit_width(static_cast<size_t>(end - begin + 1)) - 1;
+    return _classes[std::min(_sparse[level][begin], _sparse[level][end + 1 - (1 << level)])];
+}
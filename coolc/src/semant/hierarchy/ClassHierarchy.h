@@ -0,0 +1,85 @@
+#pragma once
+
+#include "ast/AST.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace semant
+{
+struct ClassNode
+{
+    ast::Class *_class;
+    std::vector<std::shared_ptr<ClassNode>> _children;
+
+    // preorder number of this class and the maximal preorder number in its subtree, see ClassHierarchy
+    int _index = -1;
+    int _last_descendant = -1;
+
+    std::unordered_map<Symbol, ast::Feature *> _methods; // own and inherited methods by name
+    uint64_t _signature = 0;                             // hash of the declarations if cache is used, see SemantCache
+};
+
+/**
+ * @brief Constant time subtype and least common ancestor queries for the class tree
+ *
+ * @details
+ * Classes are numbered in DFS preorder, so descendants of the class have numbers from its own number to
+ * _last_descendant and subtype check is an interval containment. LCA is the class with the minimal preorder number
+ * between the first occurrences of two classes in the Euler tour of the tree, it is found by the sparse table over the
+ * tour.
+ */
+class ClassHierarchy
+{
+  private:
+    std::vector<ClassNode *> _classes;     // by preorder number
+    std::vector<int> _first;               // position of the first occurrence of the class in the Euler tour
+    std::vector<std::vector<int>> _sparse; // _sparse[k][i] is the minimal number in the tour positions [i, i + 2^k)
+
+  public:
+    /**
+     * @brief Construct an empty ClassHierarchy
+     *
+     */
+    ClassHierarchy() = default;
+
+    /**
+     * @brief Number classes and build the sparse table
+     *
+     * @param root Root of the class tree without cycles. Numbers are saved in its nodes
+     */
+    explicit ClassHierarchy(const std::shared_ptr<ClassNode> &root);
+
+    /**
+     * @brief Check if class is a subtype of the other class
+     *
+     * @param klass Class
+     * @param ancestor Other class
+     * @return True if klass is ancestor or its descendant
+     */
+    inline static bool conforms(const ClassNode &klass, const ClassNode &ancestor)
+    {
+        return ancestor._index <= klass._index && klass._index <= ancestor._last_descendant;
+    }
+
+    /**
+     * @brief Find the least common ancestor of two classes
+     *
+     * @param lhs The first class
+     * @param rhs The second class
+     * @return The deepest class that is an ancestor of both classes
+     */
+    ClassNode *common_ancestor(const ClassNode &lhs, const ClassNode &rhs) const;
+
+    /**
+     * @brief Get all classes
+     *
+     * @return Classes in DFS preorder
+     */
+    inline const std::vector<ClassNode *> &classes() const
+    {
+        return _classes;
+    }
+};
+} // namespace semant
@@ -2,49 +2,41 @@
 
 using namespace semant;
 
-Scope::Scope(const std::shared_ptr<ast::Type> &self_type)
+const Symbol Scope::SELF_OBJECT(SelfObject);
+
+Scope::Scope(ast::Type *self_type)
 {
-    _symbols.emplace_back();
-    _symbols.back()[SelfObject] = self_type;
+    _symbols.insert(SELF_OBJECT, self_type);
 }
 
-Scope::AddResult Scope::add_if_can(const std::string &name, const std::shared_ptr<ast::Type> &type)
+Scope::AddResult Scope::add_if_can(const Symbol &name, ast::Type *type)
 {
-    SEMANT_RETURN_IF_FALSE(name != SelfObject, RESERVED);
+    SEMANT_RETURN_IF_FALSE(can_assign(name), RESERVED);
 
-    GUARANTEE_DEBUG(_symbols.size() != 0);
-    SEMANT_RETURN_IF_FALSE(_symbols.back().find(name) == _symbols.back().end(), REDEFINED);
+    SEMANT_RETURN_IF_FALSE(_symbols.insert(name, type), REDEFINED);
 
-    _symbols.back()[name] = type;
     return OK;
 }
 
-std::shared_ptr<ast::Type> Scope::find(const std::string &name, const int &scope_shift) const
+ast::Type *Scope::find(const Symbol &name, const int &scope_shift) const
 {
     SEMANT_VERBOSE_ONLY(dump());
 
-    for (auto class_scope = _symbols.rbegin() + scope_shift; class_scope != _symbols.rend(); class_scope++)
-    {
-        const auto symbol = class_scope->find(name);
-        if (symbol != class_scope->end())
-        {
-            return symbol->second;
-        }
-    }
-
-    return nullptr;
+    const auto *const type = _symbols.find(name, scope_shift);
+    return type ? *type : nullptr;
 }
 
 #ifdef DEBUG
 void Scope::dump() const
 {
-    for (const auto &class_scope : _symbols)
-    {
-        std::cout << "--------------------------" << std::endl;
-        for (const auto &symbol : class_scope)
+    size_t current = -1;
+    _symbols.for_each([&current](const size_t &scope, const Symbol &name, ast::Type *const &type) {
+        if (scope != current)
         {
-            std::cout << symbol.first << " = " << symbol.second->_string << std::endl;
+            std::cout << "--------------------------" << std::endl;
+            current = scope;
         }
-    }
+        std::cout << name << " = " << type->_string << std::endl;
+    });
 }
 #endif // DEBUG
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include "ast/AST.h"
 #include "decls/Decls.h"
 #include "utils/Utils.h"
-#include <unordered_map>
+#include "utils/symbol/ScopedTable.h"
 
 #define SEMANT_RETURN_IF_FALSE(cond, retval)                                                                           \
     if (!(cond))                                                                                                       \
@@ -17,8 +17,9 @@ namespace semant
 class Scope
 {
   private:
-    std::vector<std::unordered_map<std::string, std::shared_ptr<ast::Type>>>
-        _symbols; // vectors of maps for convenient way to model class scopes
+    ScopedTable<ast::Type *> _symbols; // class scopes and scopes of the method bodies
+
+    static const Symbol SELF_OBJECT;
 
   public:
     /**
@@ -26,7 +27,7 @@ class Scope
      *
      * @param self_type Current class of this scope
      */
-    explicit Scope(const std::shared_ptr<ast::Type> &self_type); // create Scope with initial scope with self object
+    explicit Scope(ast::Type *self_type); // create Scope with initial scope with self object
 
     /**
      * @brief Results of adding new elements to scope
@@ -45,7 +46,7 @@ class Scope
      */
     inline void push_scope()
     {
-        _symbols.emplace_back();
+        _symbols.push_scope();
     }
 
     /**
@@ -54,8 +55,7 @@ class Scope
      */
     inline void pop_scope()
     {
-        GUARANTEE_DEBUG(_symbols.size() != 0);
-        _symbols.pop_back();
+        _symbols.pop_scope();
     }
 
     /**
@@ -65,7 +65,7 @@ class Scope
      * @param type Element type
      * @return Status
      */
-    AddResult add_if_can(const std::string &name, const std::shared_ptr<ast::Type> &type);
+    AddResult add_if_can(const Symbol &name, ast::Type *type);
 
     /**
      * @brief Check if assignment for given element is prohibited
@@ -73,9 +73,9 @@ class Scope
      * @param name Element name
      * @return True if assignment is allowed
      */
-    inline static bool can_assign(const std::string &name)
+    inline static bool can_assign(const Symbol &name)
     {
-        return name != SelfObject;
+        return name != SELF_OBJECT;
     }
 
     /**
@@ -85,7 +85,7 @@ class Scope
      * @param scope_shift Start lookup from previos scope_shift scopes
      * @return Type of the element
      */
-    std::shared_ptr<ast::Type> find(const std::string &name, const int &scope_shift = 0) const;
+    ast::Type *find(const Symbol &name, const int &scope_shift = 0) const;
 
 #ifdef DEBUG
     /**
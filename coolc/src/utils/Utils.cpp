@@ -1,5 +1,8 @@
 #include "utils/Utils.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 #ifdef DEBUG
 
 std::string printable_string(const std::string &str)
@@ -47,21 +50,27 @@ std::string printable_string(const std::string &str)
 #endif // DEBUG
 
 bool TraceLexer;
+bool CheckLexer;
+bool MmapInput;
+bool PipelineLexer;
+bool LazyMethodBodies;
 bool TokensOnly;
 bool PrintFinalAST;
 bool TraceParser;
 bool TraceSemant;
 bool TraceCodeGen;
+bool TracePasses;
 bool UseArchSpecFeatures;
 
+int Jobs;
+
+std::string ASTCacheDir;
+
 bool maybe_set(const char *arg, const char *flag_name, bool &flag)
 {
     if (!strcmp(flag_name, arg + 1))
     {
-        if (arg[0] == '+')
-        {
-            flag = true;
-        }
+        flag = arg[0] == '+';
         return true;
     }
 
@@ -77,13 +86,22 @@ bool maybe_set(const char *arg, const char *flag_name, bool &flag)
 std::pair<std::vector<int>, std::string> process_args(char *const args[], const int &args_num)
 {
     TraceLexer = false;
+    CheckLexer = false;
+    MmapInput = true;
+    PipelineLexer = false;
+    LazyMethodBodies = false;
     PrintFinalAST = false;
     TraceParser = false;
     TraceSemant = false;
     TraceCodeGen = false;
+    TracePasses = false;
     TokensOnly = false;
     UseArchSpecFeatures = true;
 
+    Jobs = 1;
+
+    ASTCacheDir.clear();
+
     std::string out_file_name;
     bool found_out_file_name = false;
 
@@ -93,11 +111,16 @@ std::pair<std::vector<int>, std::string> process_args(char *const args[], const
         if (args[i][0] == '-' || args[i][0] == '+')
         {
             check_flag(TraceLexer);
+            check_flag(CheckLexer);
+            check_flag(MmapInput);
+            check_flag(PipelineLexer);
+            check_flag(LazyMethodBodies);
             check_flag(PrintFinalAST);
             check_flag(TraceParser);
             check_flag(TraceSemant);
             check_flag(TokensOnly);
             check_flag(TraceCodeGen);
+            check_flag(TracePasses);
             check_flag(UseArchSpecFeatures);
 
             // output file name
@@ -109,6 +132,24 @@ std::pair<std::vector<int>, std::string> process_args(char *const args[], const
                     out_file_name = args[++i];
                 }
             }
+
+            // number of threads
+            if (!strcmp(args[i], "-j"))
+            {
+                if (i + 1 < args_num)
+                {
+                    Jobs = std::max(std::atoi(args[++i]), 1);
+                }
+            }
+
+            // directory for parsed files
+            if (!strcmp(args[i], "-cache"))
+            {
+                if (i + 1 < args_num)
+                {
+                    ASTCacheDir = args[++i];
+                }
+            }
         }
         else
         {
@@ -2,22 +2,28 @@
 
 #include "utils/logger/Logger.h"
 
-#ifdef DEBUG
-
-#include <cassert>
-#include <iomanip>
-#include <sstream>
 #include <string.h>
+#include <string>
+#include <utility>
 #include <vector>
 
 extern bool TraceLexer;
+extern bool CheckLexer;
+extern bool MmapInput;
+extern bool PipelineLexer;
+extern bool LazyMethodBodies;
 extern bool TokensOnly;
 extern bool PrintFinalAST;
 extern bool TraceParser;
 extern bool TraceSemant;
 extern bool TraceCodeGen;
+extern bool TracePasses;
 extern bool UseArchSpecFeatures;
 
+extern int Jobs; // number of threads for the front end, -j N
+
+extern std::string ASTCacheDir; // directory for parsed files and checked classes, -cache DIR. Empty if it is disabled
+
 /**
  * @brief Process command line arguments
  *
@@ -27,6 +33,12 @@ extern bool UseArchSpecFeatures;
  */
 std::pair<std::vector<int>, std::string> process_args(char *const args[], const int &args_num);
 
+#ifdef DEBUG
+
+#include <cassert>
+#include <iomanip>
+#include <sstream>
+
 /**
  * @brief Get the printable string object
  *
@@ -56,6 +68,11 @@ std::string printable_string(const std::string &str);
     {                                                                                                                  \
         text;                                                                                                          \
     }
+#define PASSES_VERBOSE_ONLY(text)                                                                                      \
+    if (TracePasses)                                                                                                   \
+    {                                                                                                                  \
+        text;                                                                                                          \
+    }
 
 #define GUARANTEE_DEBUG(expr) assert(expr)
 #define SHOULD_NOT_REACH_HERE() assert(false && "Should not reach here!")
@@ -67,6 +84,7 @@ std::string printable_string(const std::string &str);
 #define PARSER_VERBOSE_ONLY(text)
 #define SEMANT_VERBOSE_ONLY(text)
 #define CODEGEN_VERBOSE_ONLY(text)
+#define PASSES_VERBOSE_ONLY(text)
 
 #define GUARANTEE_DEBUG(expr)
 #define SHOULD_NOT_REACH_HERE()
@@ -0,0 +1,32 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+Arena::~Arena()
+{
+    for (auto it = _destructors.rbegin(); it != _destructors.rend(); it++)
+    {
+        it->_destroy(it->_object);
+    }
+}
+
+void *Arena::allocate(const size_t &size, const size_t &alignment)
+{
+    auto padding = (alignment - reinterpret_cast<uintptr_t>(_current) % alignment) % alignment;
+    if (!_current || padding + size > _left)
+    {
+        // large objects get their own block
+        const auto block_size = std::max(BLOCK_SIZE, size + alignment);
+        _blocks.push_back(std::make_unique_for_overwrite<std::byte[]>(block_size));
+        _current = _blocks.back().get();
+        _left = block_size;
+        padding = (alignment - reinterpret_cast<uintptr_t>(_current) % alignment) % alignment;
+    }
+
+    auto *const result = _current + padding;
+    _current += padding + size;
+    _left -= padding + size;
+
+    return result;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bump-pointer allocator that frees all objects at once
+ *
+ * @details
+ * Objects are placed one after another in large blocks and are never freed separately. Destructors of non-trivially
+ * destructible objects are called in reverse order of construction when the Arena is destroyed. Arena is not
+ * thread-safe, use one Arena per thread.
+ */
+class Arena
+{
+  private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    struct Destructor
+    {
+        void *_object;
+        void (*_destroy)(void *);
+    };
+
+    std::vector<std::unique_ptr<std::byte[]>> _blocks;
+    std::byte *_current;
+    size_t _left; // free bytes in the current block
+
+    std::vector<Destructor> _destructors;
+
+    void *allocate(const size_t &size, const size_t &alignment);
+
+  public:
+    Arena() : _current(nullptr), _left(0)
+    {
+    }
+
+    ~Arena();
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * @brief Construct a new object in the Arena
+     *
+     * @tparam T Type of object
+     * @param args Constructor arguments
+     * @return Pointer to the object that lives while this Arena is alive
+     */
+    template <class T, class... Args> T *make(Args &&...args)
+    {
+        auto *object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            _destructors.push_back({object, [](void *ptr) { static_cast<T *>(ptr)->~T(); }});
+        }
+        return object;
+    }
+
+    /**
+     * @brief Copy elements to one contiguous array in the Arena
+     *
+     * @tparam Range Sized range of elements
+     * @param elements Elements
+     * @return Span of the copies that lives while this Arena is alive
+     */
+    template <class Range> std::span<std::ranges::range_value_t<Range>> make_array(const Range &elements)
+    {
+        using T = std::ranges::range_value_t<Range>;
+        static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>);
+
+        const auto size = std::ranges::size(elements);
+        if (size == 0)
+        {
+            return {};
+        }
+
+        auto *array = static_cast<T *>(allocate(sizeof(T) * size, alignof(T)));
+        std::uninitialized_copy(std::ranges::begin(elements), std::ranges::end(elements), array);
+        return {array, size};
+    }
+};
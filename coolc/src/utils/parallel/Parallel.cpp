@@ -0,0 +1,48 @@
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+void parallel_for(const int &jobs, const size_t &n, const std::function<void(const size_t &)> &func)
+{
+    std::vector<std::exception_ptr> exceptions(n);
+    std::atomic<size_t> next_index(0);
+
+    const auto worker = [&]() {
+        for (auto i = next_index++; i < n; i = next_index++)
+        {
+            try
+            {
+                func(i);
+            }
+            catch (...)
+            {
+                exceptions[i] = std::current_exception();
+            }
+        }
+    };
+
+    const auto threads_num = std::min<size_t>(std::max(jobs, 1), n);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threads_num; i++)
+    {
+        threads.emplace_back(worker);
+    }
+    // calling thread is a worker too
+    worker();
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    const auto first_exception = std::find_if(exceptions.begin(), exceptions.end(), [](const auto &e) { return e; });
+    if (first_exception != exceptions.end())
+    {
+        std::rethrow_exception(*first_exception);
+    }
+}
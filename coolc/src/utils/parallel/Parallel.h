@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * @brief Call func for every index in [0, n) using a pool of worker threads
+ *
+ * @param jobs Maximum number of threads including the calling one. 1 means sequential execution
+ * @param n Number of work items
+ * @param func Work item. Called concurrently for different indexes
+ *
+ * @details
+ * Workers take indexes in increasing order, so long items that come first do not wait for the whole tail. If some
+ * items throw, the exception of the item with the least index is rethrown after all workers finish.
+ */
+void parallel_for(const int &jobs, const size_t &n, const std::function<void(const size_t &)> &func);
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "utils/Utils.h"
+#include "utils/symbol/Symbol.h"
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Symbol table with nested scopes
+ *
+ * @details
+ * All scopes share one open-addressing map from symbol id to the innermost definition of the symbol. Definitions live
+ * in one vector in the order they were added and every definition refers to the one it shadows, so the vector is the
+ * undo log: popping a scope truncates it and restores the shadowed definitions in the map. Scope is only the size of
+ * the log at its start, so push and pop do not allocate once the table has grown to the maximal nesting.
+ *
+ * Slots of the map are never deleted: the slot of a symbol that is not defined anymore keeps its id and is reused when
+ * the symbol is defined again, so the number of slots is bounded by the number of distinct symbols of this table.
+ *
+ * @tparam T Value type
+ */
+template <class T> class ScopedTable
+{
+  private:
+    static constexpr int NONE = -1;
+
+    struct Definition
+    {
+        Symbol _name;
+        T _value;
+        int _shadowed; // the previous definition of the same symbol or NONE
+    };
+
+    struct Slot
+    {
+        Symbol::Id _id;  // 0 for the empty slot
+        int _definition; // the innermost definition or NONE
+    };
+
+    std::vector<Definition> _definitions; // undo log
+    std::vector<size_t> _scopes;          // size of the log at the start of every scope
+    std::vector<Slot> _slots;             // power of two size
+    size_t _used = 0;                     // slots with ids
+
+    // slot with this id or the empty slot where it should be placed
+    size_t find_slot(const Symbol::Id &id) const
+    {
+        const auto mask = _slots.size() - 1;
+        auto i = id & mask;
+        while (_slots[i]._id != id && _slots[i]._id != 0)
+        {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void grow()
+    {
+        auto slots = std::move(_slots);
+        _slots.assign(slots.size() * 2, Slot{0, NONE});
+        for (const auto &slot : slots)
+        {
+            if (slot._id != 0)
+            {
+                _slots[find_slot(slot._id)] = slot;
+            }
+        }
+    }
+
+    // definition visible from the scope that is scope_shift scopes outer than the current one
+    const Definition *lookup(const Symbol &name, const size_t &scope_shift) const
+    {
+        GUARANTEE_DEBUG(scope_shift < _scopes.size());
+
+        const auto limit = scope_shift == 0 ? _definitions.size() : _scopes[_scopes.size() - scope_shift];
+        auto definition = _slots[find_slot(name.id())]._definition;
+        while (definition != NONE && static_cast<size_t>(definition) >= limit)
+        {
+            definition = _definitions[definition]._shadowed;
+        }
+
+        return definition != NONE ? &_definitions[definition] : nullptr;
+    }
+
+  public:
+    /**
+     * @brief Construct a new ScopedTable with one scope
+     *
+     */
+    ScopedTable() : _scopes(1, 0), _slots(64, Slot{0, NONE})
+    {
+    }
+
+    /**
+     * @brief Start new scope
+     *
+     */
+    inline void push_scope()
+    {
+        _scopes.push_back(_definitions.size());
+    }
+
+    /**
+     * @brief Pop current scope and restore definitions shadowed by it
+     *
+     */
+    void pop_scope()
+    {
+        GUARANTEE_DEBUG(!_scopes.empty());
+
+        while (_definitions.size() > _scopes.back())
+        {
+            const auto &definition = _definitions.back();
+            _slots[find_slot(definition._name.id())]._definition = definition._shadowed;
+            _definitions.pop_back();
+        }
+        _scopes.pop_back();
+    }
+
+    /**
+     * @brief Define symbol in the current scope
+     *
+     * @param name Symbol name
+     * @param value Value of the symbol
+     * @return False if symbol is already defined in the current scope. Its value is not changed
+     */
+    bool insert(const Symbol &name, const T &value)
+    {
+        GUARANTEE_DEBUG(!_scopes.empty() && !name.empty());
+
+        auto index = find_slot(name.id());
+        if (_slots[index]._id == 0)
+        {
+            // keep load factor below 1/2
+            if (2 * (_used + 1) > _slots.size())
+            {
+                grow();
+                index = find_slot(name.id());
+            }
+            _slots[index]._id = name.id();
+            _used++;
+        }
+
+        auto &slot = _slots[index];
+        if (slot._definition != NONE && static_cast<size_t>(slot._definition) >= _scopes.back())
+        {
+            return false;
+        }
+
+        _definitions.push_back(Definition{name, value, slot._definition});
+        slot._definition = static_cast<int>(_definitions.size() - 1);
+        return true;
+    }
+
+    /**
+     * @brief Find the innermost definition of the symbol
+     *
+     * @param name Symbol name
+     * @param scope_shift Skip this number of the innermost scopes
+     * @return Value or nullptr if symbol is not defined. Pointer is valid until the next insert or pop_scope
+     */
+    inline const T *find(const Symbol &name, const size_t &scope_shift = 0) const
+    {
+        const auto *const definition = lookup(name, scope_shift);
+        return definition ? &definition->_value : nullptr;
+    }
+
+    /**
+     * @brief Visit definitions of all scopes from the outermost one
+     *
+     * @param visitor Function that takes the scope number, the symbol and its value
+     */
+    template <class Visitor> void for_each(const Visitor &visitor) const
+    {
+        size_t scope = 0;
+        for (size_t i = 0; i < _definitions.size(); i++)
+        {
+            while (scope + 1 < _scopes.size() && _scopes[scope + 1] <= i)
+            {
+                scope++;
+            }
+            visitor(scope, _definitions[i]._name, _definitions[i]._value);
+        }
+    }
+};
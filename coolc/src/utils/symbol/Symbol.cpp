@@ -0,0 +1,98 @@
+#include "Symbol.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace
+{
+// strings live in fixed-size chunks that are never moved, so reading a string by id does not need a lock
+struct Interner
+{
+    static constexpr size_t CHUNK_SIZE = 1 << 14;
+    static constexpr size_t MAX_CHUNKS = 1 << 12;
+
+    std::shared_mutex _mutex;                                       // guards _ids and insertion
+    std::unordered_map<std::string_view, Symbol::Id> _ids;          // keys are views of strings in _chunks
+    std::array<std::unique_ptr<std::string[]>, MAX_CHUNKS> _chunks; // allocated on demand
+    std::atomic<Symbol::Id> _size;
+
+    Interner() : _size(0)
+    {
+        insert(std::string_view());
+    }
+
+    inline std::string &at(const Symbol::Id &id)
+    {
+        return _chunks[id / CHUNK_SIZE][id % CHUNK_SIZE];
+    }
+
+    // caller must hold the unique lock
+    Symbol::Id insert(const std::string_view &str)
+    {
+        const Symbol::Id new_id = _size.load(std::memory_order_relaxed);
+        if (new_id / CHUNK_SIZE >= MAX_CHUNKS)
+        {
+            throw std::runtime_error("Symbol::intern: too many symbols!");
+        }
+
+        auto &chunk = _chunks[new_id / CHUNK_SIZE];
+        if (!chunk)
+        {
+            chunk = std::make_unique<std::string[]>(CHUNK_SIZE);
+        }
+
+        auto &string = at(new_id);
+        string = str;
+        _ids.emplace(string, new_id);
+        _size.store(new_id + 1, std::memory_order_release);
+
+        return new_id;
+    }
+};
+
+// construct on the first use because static symbols can be defined in other translation units
+Interner &interner()
+{
+    static Interner INTERNER;
+    return INTERNER;
+}
+} // namespace
+
+Symbol::Id Symbol::intern(const std::string_view &str)
+{
+    auto &table = interner();
+
+    {
+        std::shared_lock lock(table._mutex);
+        const auto id = table._ids.find(str);
+        if (id != table._ids.end())
+        {
+            return id->second;
+        }
+    }
+
+    std::unique_lock lock(table._mutex);
+    // other thread could intern the same string between locks
+    const auto id = table._ids.find(str);
+    if (id != table._ids.end())
+    {
+        return id->second;
+    }
+
+    return table.insert(str);
+}
+
+const std::string &Symbol::string_by_id(const Id &id)
+{
+    return interner().at(id);
+}
+
+size_t Symbol::size()
+{
+    return interner()._size.load(std::memory_order_acquire);
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Interned string
+ *
+ * @details
+ * All symbols live in the one global table and are identified by dense 32-bit ids, so equal symbols have equal ids.
+ * Comparison and hashing of symbols are integer operations. Id 0 is reserved for the empty string. Interning is
+ * thread-safe, so files can be lexed concurrently.
+ */
+class Symbol
+{
+  public:
+    using Id = uint32_t;
+
+  private:
+    Id _id;
+
+    static Id intern(const std::string_view &str);
+    static const std::string &string_by_id(const Id &id);
+
+  public:
+    /**
+     * @brief Construct the empty symbol
+     *
+     */
+    Symbol() : _id(0)
+    {
+    }
+
+    /**
+     * @brief Intern the string
+     *
+     * @param str String to intern
+     */
+    explicit Symbol(const std::string_view &str) : _id(intern(str))
+    {
+    }
+
+    /**
+     * @brief Get the id
+     *
+     * @return Dense id of this symbol
+     */
+    inline const Id &id() const
+    {
+        return _id;
+    }
+
+    /**
+     * @brief Get the interned string
+     *
+     * @return String that lives until the end of the program
+     */
+    inline const std::string &str() const
+    {
+        return string_by_id(_id);
+    }
+
+    /**
+     * @brief Get the interned string
+     *
+     * @return String that lives until the end of the program
+     */
+    inline operator const std::string &() const
+    {
+        return str();
+    }
+
+    /**
+     * @brief Check if symbol is the empty string
+     *
+     * @return True if symbol is the empty string
+     */
+    inline bool empty() const
+    {
+        return _id == 0;
+    }
+
+    inline bool operator==(const Symbol &other) const
+    {
+        return _id == other._id;
+    }
+
+    inline bool operator==(const std::string_view &other) const
+    {
+        return str() == other;
+    }
+
+    /**
+     * @brief Get the number of interned symbols
+     *
+     * @return Upper bound for symbol ids
+     */
+    static size_t size();
+};
+
+// symbols are mostly used for names construction
+inline std::string operator+(const std::string &lhs, const Symbol &rhs)
+{
+    return lhs + rhs.str();
+}
+
+inline std::string operator+(const Symbol &lhs, const std::string &rhs)
+{
+    return lhs.str() + rhs;
+}
+
+inline std::string operator+(const char *lhs, const Symbol &rhs)
+{
+    return lhs + rhs.str();
+}
+
+inline std::string operator+(const Symbol &lhs, const char *rhs)
+{
+    return lhs.str() + rhs;
+}
+
+inline std::ostream &operator<<(std::ostream &os, const Symbol &symbol)
+{
+    return os << symbol.str();
+}
+
+template <> struct std::hash<Symbol>
+{
+    inline size_t operator()(const Symbol &symbol) const
+    {
+        return symbol.id();
+    }
+};
@@ -0,0 +1,39 @@
+#!/bin/bash
+
+# compile tests with the AST cache. Stages: cold - empty cache, warm - entries of the cold run, damaged - entries are
+# truncated, corrupted and stale. Every stage must give the same results as the compilation without the cache
+
+CURR_DIR=$(pwd)
+TEST_DIR=$(cd $(dirname $0) && pwd)
+CACHE_DIR=$TEST_DIR/cache
+
+if [ "$3" = "cold" ]; then
+    rm -rf $CACHE_DIR
+elif [ "$3" = "damaged" ]; then
+    entries=($(ls $CACHE_DIR/*.ast | sort))
+    for i in "${!entries[@]}"; do
+        entry=${entries[$i]}
+        size=$(wc -c < $entry)
+        case $((i % 6)) in
+        0) # truncated in the middle of records
+            head -c $((size / 2)) $entry > $entry.tmp && mv $entry.tmp $entry ;;
+        1) # truncated in the middle of the header
+            head -c 20 $entry > $entry.tmp && mv $entry.tmp $entry ;;
+        2) # records are overwritten
+            for offset in $((size / 3)) $((size / 2)) $((size * 2 / 3)); do
+                printf '\xff\xff\xff\x7f' | dd of=$entry bs=1 seek=$offset conv=notrunc 2> /dev/null
+            done ;;
+        3) # counts in the header are overwritten
+            printf '\xff\xff\xff\x7f' | dd of=$entry bs=1 seek=12 conv=notrunc 2> /dev/null
+            printf '\xff\xff\xff\x7f' | dd of=$entry bs=1 seek=32 conv=notrunc 2> /dev/null ;;
+        4) # stale: entry of another source
+            cp ${entries[$(((i + 1) % ${#entries[@]}))]} $entry ;;
+        5) # stale: other format version
+            printf '\xff\xff\xff\xff' | dd of=$entry bs=1 seek=8 conv=notrunc 2> /dev/null ;;
+        esac
+    done
+fi
+
+$TEST_DIR/make_results.sh $1 $2 -cache $CACHE_DIR
+
+cd $CURR_DIR
@@ -0,0 +1,20 @@
+class Greeter inherits IO {
+  name : String <- "cool";
+  greet() : SELF_TYPE { out_string("hello ".concat(name).concat("\n")) };
+};
+
+class Main inherits IO {
+  s : String <- "abcdef";
+  main() : Object {
+    let t : String <- s.substr(1, 3), g : Greeter <- new Greeter in {
+      out_int(s.length());
+      out_string("\n");
+      out_string(t.concat(s.substr(0, 1)));
+      out_string("\n");
+      out_string(g.greet().type_name());
+      out_string("\n");
+      out_string(g.copy().type_name());
+      out_string("\n");
+    }
+  };
+};
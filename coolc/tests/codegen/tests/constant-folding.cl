@@ -0,0 +1,27 @@
+class Main inherits IO {
+  x : Int <- 7;
+  main() : Object { {
+    out_int(1 + 2 * 3 - 8 / 2);
+    out_string("\n");
+    if not true then out_string("wrong\n") else out_string("not\n") fi;
+    if 1 < 2 then if 2 <= 2 then out_string("cmp\n") else out_string("wrong\n") fi else out_string("wrong\n") fi;
+    if "ab" = "a".concat("b") then out_string("eq\n") else out_string("wrong\n") fi;
+    if isvoid 1 then out_string("wrong\n") else out_string("isvoid\n") fi;
+    out_string("a".concat("bc").substr(1, 2).concat("\n"));
+    out_int("hello".length() * ~2);
+    out_string("\n");
+    let y : Int <- 5 in out_int(y * y);
+    out_string("\n");
+    let z : Int, s : String, b : Bool in { out_int(z); out_string(s); if b then out_string("wrong\n") else out_string("\n") fi; };
+    let x : Int <- 3 in { x <- x + 1; out_int(x); };
+    out_string("\n");
+    out_int(x);
+    out_string("\n");
+    let y : Int <- 2 in let y : Int <- y * 10 in out_int(y);
+    out_string("\n");
+    let y : Int <- 2 in case 5 of y : Int => out_int(y + 1); esac;
+    out_string("\n");
+    let o : Object <- 4 in case o of i : Int => out_int(i); esac;
+    out_string("\n");
+  } };
+};
@@ -0,0 +1,31 @@
+class Counter {
+  n : Int;
+  on : Bool <- true;
+  step : Int <- 2;
+  inc() : SELF_TYPE { { n <- n + step; self; } };
+  get() : Int { n };
+  set(v : Int) : Int { n <- v };
+  flip() : Bool { on <- not on };
+  on() : Bool { on };
+};
+class Sub inherits Counter {
+  m : Int <- 10;
+  sum() : Int { get() + m };
+};
+class Main inherits IO {
+  c : Counter <- new Counter;
+  main() : Object {
+    let s : Sub <- new Sub, i : Int in {
+      while i < 5 loop { c.inc(); i <- i + 1; } pool;
+      out_int(c.get()); out_string("\n");
+      out_int(c.set(7) + 1); out_string("\n");
+      if c.flip() then out_string("on\n") else out_string("off\n") fi;
+      if c.on() then out_string("on\n") else out_string("off\n") fi;
+      s.inc().inc();
+      out_int(s.sum()); out_string("\n");
+      case s.copy() of x : Sub => out_int(x.sum()); esac; out_string("\n");
+      out_int(c.copy().inc().get()); out_string("\n");
+      out_int(c.get()); out_string("\n");
+    }
+  };
+};
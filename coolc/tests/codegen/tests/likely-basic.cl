@@ -0,0 +1,19 @@
+class A {
+  type_name() : String { "custom A" };
+};
+
+class B {
+};
+
+class Main inherits IO {
+  name(o : Object) : String { o.type_name() };
+  main() : Object {
+    let b1 : B <- new B, b2 : B <- new B, b3 : B <- new B, a : A <- new A in {
+      out_string(name(b1).concat("\n"));
+      out_string(name(b2).concat("\n"));
+      out_string(name(b3).concat("\n"));
+      out_string(name(a).concat("\n"));
+      out_string(name(self).concat("\n"));
+    }
+  };
+};
@@ -0,0 +1,32 @@
+class Main inherits IO {
+  twice(n : Int) : Int { n * 2 };
+  main() : Object {
+    let i : Int <- 0, sum : Int, odd : Bool <- false, k : Int <- 3, esc : Int <- 5 in {
+      while i < 10 loop {
+        if odd then sum <- sum - 1 else sum <- sum + i fi;
+        odd <- not odd;
+        i <- i + 1;
+      } pool;
+      out_int(sum); out_string("\n");
+      if odd then out_string("odd\n") else out_string("even\n") fi;
+      out_int(twice(k) + ~k); out_string("\n");
+      out_int(esc); out_string("\n");
+      out_int(esc <- esc + 1); out_string("\n");
+      k <- 7;
+      if k = 7 then out_string("eq\n") else out_string("ne\n") fi;
+      if k <= 6 then out_string("le\n") else out_string("gt\n") fi;
+      out_int((let t : Int <- 4 in { t <- t * t; t; }) + 1); out_string("\n");
+      let j : Int, n : Int in {
+        while j < 4 loop {
+          let l : Int <- 0 in while l < j loop { n <- n + l; l <- l + 1; } pool;
+          j <- j + 1;
+        } pool;
+        out_int(n); out_string("\n");
+      };
+      let o : Object <- k in case o of k : Int => out_int(k + 1); esac;
+      out_string("\n");
+      if isvoid k then out_string("void\n") else out_string("object\n") fi;
+      let b : Bool <- 2 < 1 in if b = false then out_string("false\n") else out_string("true\n") fi;
+    }
+  };
+};
@@ -10,7 +10,7 @@ mkdir results
 cd tests/
 
 for file in *.cool; do
-    $1/coolc +TokensOnly $file &> $TEST_DIR/results/$file.result
+    $1/coolc +TokensOnly "${@:2}" $file &> $TEST_DIR/results/$file.result
 done;
 
 cd $CURR_DIR
\ No newline at end of file
@@ -0,0 +1,28 @@
+#!/bin/bash
+
+# check every test with the cache of its previous version in before/ or with the cache of itself. Cached results must
+# be invalidated by changes of other classes, so the diagnostics are the same as without the cache
+
+CURR_DIR=$(pwd)
+TEST_DIR=$(cd $(dirname $0) && pwd)
+CACHE_DIR=$TEST_DIR/cache
+
+cd $TEST_DIR
+
+rm -rf results
+mkdir results
+rm -rf out
+mkdir out
+rm -rf $CACHE_DIR
+cd tests/
+
+for file in *.test; do
+    if [ -f ../before/$file ]; then
+        (cd ../before && $1/coolc -cache $CACHE_DIR $file -o $TEST_DIR/out/$file.out &> /dev/null)
+    else
+        $1/coolc -cache $CACHE_DIR $file -o $TEST_DIR/out/$file.out &> /dev/null
+    fi
+    $1/coolc +PrintFinalAST -cache $CACHE_DIR $file -o $TEST_DIR/out/$file.out &> $TEST_DIR/results/$file.result
+done;
+
+cd $CURR_DIR
@@ -12,7 +12,7 @@ mkdir out
 cd tests/
 
 for file in *.test; do
-    $1/coolc +PrintFinalAST $file -o $TEST_DIR/out/$file.out &> $TEST_DIR/results/$file.result
+    $1/coolc +PrintFinalAST "${@:2}" $file -o $TEST_DIR/out/$file.out &> $TEST_DIR/results/$file.result
 done;
 
 cd $CURR_DIR
\ No newline at end of file
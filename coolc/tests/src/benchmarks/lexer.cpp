@@ -0,0 +1,83 @@
+#include "lexer/Lexer.h"
+#include "utils/Utils.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+// Lexer benchmark: tokens per second of tokenize on a generated file. DFA lexer is compared with the legacy regex
+// lexer, that runs after DFA with +CheckLexer on the same line parts. Old lexer did not run DFA, so the time of the
+// regex is at least the difference of both times, and the speedup is at least (regex + DFA - DFA) / DFA
+
+namespace
+{
+constexpr int REPEATS = 10;
+
+// write methods with identifiers, keywords, numbers, operators, strings and comments, return the file size
+size_t generate(const std::string &file_name, const int &methods)
+{
+    std::ofstream out(file_name);
+    out << "class Main inherits IO {\n";
+    for (int i = 0; i < methods; i++)
+    {
+        out << "    -- method number " << i << "\n";
+        out << "    method" << i << "(x : Int, flag : Bool) : Object {\n";
+        out << "        let counter : Int <- " << i << ", text : String <- \"line " << i << "\\n\" in {\n";
+        out << "            while counter < 100 loop counter <- counter + x * 2 - (counter / 3) pool;\n";
+        out << "            if not flag then out_string(text.concat(\"done\")) else (* skip *) self fi;\n";
+        out << "            case counter of n : Int => n <= 10; o : Object => isvoid o; esac;\n";
+        out << "        }\n";
+        out << "    };\n";
+    }
+    out << "};\n";
+
+    return std::filesystem::file_size(file_name);
+}
+
+// best of REPEATS runs, the time includes reading the mapped file
+std::chrono::nanoseconds measure(const std::string &file_name, size_t &tokens)
+{
+    auto best = std::chrono::nanoseconds::max();
+    for (int i = 0; i < REPEATS; i++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        lexer::Lexer lexer(file_name);
+        tokens = lexer.tokenize().size();
+        const auto finish = std::chrono::steady_clock::now();
+
+        best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start));
+    }
+
+    return best;
+}
+
+double per_second(const size_t &tokens, const std::chrono::nanoseconds &time)
+{
+    return static_cast<double>(tokens) * 1e9 / static_cast<double>(time.count());
+}
+} // namespace
+
+int main()
+{
+    const auto file_name = (std::filesystem::temp_directory_path() / "coolc_lexer_bench.cl").string();
+
+    std::cout << "methods  size, KB  tokens  DFA, Mtokens/s  DFA + regex, Mtokens/s  speedup at least" << std::endl;
+    for (const int methods : {1000, 5000, 20000})
+    {
+        const auto size = generate(file_name, methods);
+
+        size_t tokens = 0;
+        CheckLexer = false;
+        const auto dfa = measure(file_name, tokens);
+        CheckLexer = true;
+        const auto both = measure(file_name, tokens);
+
+        std::cout << methods << "  " << size / 1024 << "  " << tokens << "  " << per_second(tokens, dfa) / 1e6 << "  "
+                  << per_second(tokens, both) / 1e6 << "  "
+                  << static_cast<double>((both - dfa).count()) / static_cast<double>(dfa.count()) << std::endl;
+    }
+
+    std::filesystem::remove(file_name);
+    return 0;
+}